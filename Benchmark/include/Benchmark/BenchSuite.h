@@ -0,0 +1,123 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <ostream>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Settings a single measurement was taken with
+struct BenchParams
+{
+    std::string primitive;
+    std::string variant;
+    std::string simd;
+    int width = 0;
+    int height = 0;
+    int size = 0;
+    float aspect = 1.0f;
+    int angle = 0;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief Totals gathered while repeating a measurement
+struct BenchResult
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns millions of pixels written per second
+    double GetMegapixelsPerSecond() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns primitives drawn per second
+    double GetPrimitivesPerSecond() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns timestamp counter cycles spent per pixel written
+    double GetCyclesPerPixel() const noexcept;
+
+public:
+    std::string name;
+    BenchParams params;
+    uint64_t primitives = 0u;
+    uint64_t pixels = 0u;
+    uint64_t cycles = 0u;
+    double seconds = 0.0;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief Times batches of draw calls and collects the results for
+//      printing and for machine readable output
+class BenchSuite
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty suite
+    //
+    // @param minSeconds: each measurement repeats its batch until at
+    //      least this much time has passed
+    // @param filter: only measurements whose name contains this are
+    //      run, empty runs everything
+    BenchSuite(
+        double             minSeconds,
+        const std::string& filter );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if a measurement with these settings would
+    //      run, lets callers skip building batches that are filtered
+    //
+    // @param params: settings of the measurement
+    bool IsSelected( const BenchParams& params ) const;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Runs a batch once to warm up and then repeatedly until
+    //      the minimum time has passed, recording the totals
+    //
+    // @param params: settings of the measurement
+    // @param primitives: primitives drawn by one batch
+    // @param pixels: pixels written by one batch
+    // @param batch: draws the batch and waits for it to finish
+    void Run(
+        const BenchParams&           params,
+        uint64_t                     primitives,
+        uint64_t                     pixels,
+        const std::function<void()>& batch );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes every result as comma separated values with a 
+    //      header row
+    //
+    // @param out: stream to write to
+    void WriteCsv( std::ostream& out ) const;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes every result as a JSON array of objects
+    //
+    // @param out: stream to write to
+    void WriteJson( std::ostream& out ) const;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns every result recorded so far
+    const std::vector<BenchResult>& GetResults() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the unique name of a measurement, used as the key
+    //      when comparing runs
+    //
+    // @param params: settings of the measurement
+    static std::string GetName( const BenchParams& params );
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Reads the processor's timestamp counter, 0 where there is
+    //      none
+    static uint64_t ReadCycles() noexcept;
+
+private:
+    double minSeconds;
+    std::string filter;
+    std::vector<BenchResult> results;
+};
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "Benchmark/BenchSuite.h"
+#include "Utility/Simd.h"
+#include <chrono>
+#include <cstdio>
+#ifdef GFX_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] BenchResult                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns millions of pixels written per second
+double BenchResult::GetMegapixelsPerSecond() const noexcept { return seconds > 0.0 ? pixels / seconds * 1e-6 : 0.0; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns primitives drawn per second
+double BenchResult::GetPrimitivesPerSecond() const noexcept { return seconds > 0.0 ? primitives / seconds : 0.0; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns timestamp counter cycles spent per pixel 
+//          written
+double BenchResult::GetCyclesPerPixel() const noexcept { return pixels ? static_cast<double>( cycles ) / pixels : 0.0; }
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] BenchSuite                                                           */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Constructs an empty suite
+BenchSuite::BenchSuite(
+    double             minSeconds,
+    const std::string& filter )
+    :
+    minSeconds( minSeconds ),
+    filter( filter )
+{}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if a measurement with these settings 
+//          would run
+bool BenchSuite::IsSelected( const BenchParams& params ) const
+{
+    return filter.empty() || GetName( params ).find( filter ) != std::string::npos;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Runs a batch once to warm up and then repeatedly until
+//          the minimum time has passed
+void BenchSuite::Run(
+    const BenchParams&           params,
+    uint64_t                     primitives,
+    uint64_t                     pixels,
+    const std::function<void()>& batch )
+{
+    if ( !IsSelected( params ) )
+        return;
+
+    // The first batch pays for page faults and cold caches, keep it out of the totals
+    batch();
+
+    using Clock = std::chrono::steady_clock;
+    BenchResult result;
+    result.name = GetName( params );
+    result.params = params;
+
+    const Clock::time_point start = Clock::now();
+    const uint64_t startCycles = ReadCycles();
+    uint64_t batches = 0u;
+    do
+    {
+        batch();
+        ++batches;
+        result.seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+    } while ( result.seconds < minSeconds || batches < 3u );
+
+    result.cycles = ReadCycles() - startCycles;
+    result.primitives = primitives * batches;
+    result.pixels = pixels * batches;
+    results.push_back( result );
+
+    // Long sweeps should show signs of life
+    std::printf( "%-56s %10.1f Mpix/s %12.0f prim/s %8.2f cyc/pix\n", 
+        result.name.c_str(), 
+        result.GetMegapixelsPerSecond(), 
+        result.GetPrimitivesPerSecond(), 
+        result.GetCyclesPerPixel() );
+    std::fflush( stdout );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Writes every result as comma separated values
+void BenchSuite::WriteCsv( std::ostream& out ) const
+{
+    out << "name,primitive,variant,simd,width,height,size,aspect,angle,"
+           "primitives,pixels,seconds,cycles,mpix_per_s,prims_per_s,cycles_per_pixel\n";
+
+    char line[512];
+    for ( const BenchResult& result : results )
+    {
+        const BenchParams& p = result.params;
+        std::snprintf( line, sizeof( line ), "%s,%s,%s,%s,%d,%d,%d,%.3f,%d,%llu,%llu,%.6f,%llu,%.3f,%.1f,%.4f\n",
+            result.name.c_str(), p.primitive.c_str(), p.variant.c_str(), p.simd.c_str(),
+            p.width, p.height, p.size, p.aspect, p.angle,
+            static_cast<unsigned long long>( result.primitives ),
+            static_cast<unsigned long long>( result.pixels ),
+            result.seconds,
+            static_cast<unsigned long long>( result.cycles ),
+            result.GetMegapixelsPerSecond(),
+            result.GetPrimitivesPerSecond(),
+            result.GetCyclesPerPixel() );
+        out << line;
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Writes every result as a JSON array of objects
+void BenchSuite::WriteJson( std::ostream& out ) const
+{
+    // Names and parameters are built from fixed identifiers, nothing needs escaping
+    char line[1024];
+    out << "[\n";
+    for ( size_t i = 0; i < results.size(); ++i )
+    {
+        const BenchResult& result = results[i];
+        const BenchParams& p = result.params;
+        std::snprintf( line, sizeof( line ),
+            "  { \"name\": \"%s\", \"primitive\": \"%s\", \"variant\": \"%s\", \"simd\": \"%s\", "
+            "\"width\": %d, \"height\": %d, \"size\": %d, \"aspect\": %.3f, \"angle\": %d, "
+            "\"primitives\": %llu, \"pixels\": %llu, \"seconds\": %.6f, \"cycles\": %llu, "
+            "\"mpix_per_s\": %.3f, \"prims_per_s\": %.1f, \"cycles_per_pixel\": %.4f }%s\n",
+            result.name.c_str(), p.primitive.c_str(), p.variant.c_str(), p.simd.c_str(),
+            p.width, p.height, p.size, p.aspect, p.angle,
+            static_cast<unsigned long long>( result.primitives ),
+            static_cast<unsigned long long>( result.pixels ),
+            result.seconds,
+            static_cast<unsigned long long>( result.cycles ),
+            result.GetMegapixelsPerSecond(),
+            result.GetPrimitivesPerSecond(),
+            result.GetCyclesPerPixel(),
+            i + 1 < results.size() ? "," : "" );
+        out << line;
+    }
+    out << "]\n";
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns every result recorded so far
+const std::vector<BenchResult>& BenchSuite::GetResults() const noexcept { return results; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the unique name of a measurement
+std::string BenchSuite::GetName( const BenchParams& params )
+{
+    char name[256];
+    std::snprintf( name, sizeof( name ), "%s/%s/%s/%dx%d/s%d/a%.2f/r%d",
+        params.primitive.c_str(), params.variant.c_str(), params.simd.c_str(),
+        params.width, params.height, params.size, params.aspect, params.angle );
+    return name;
+}
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] BenchSuite                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Reads the processor's timestamp counter
+uint64_t BenchSuite::ReadCycles() noexcept
+{
+#ifdef GFX_X86
+    return __rdtsc();
+#else
+    return 0u;
+#endif
+}
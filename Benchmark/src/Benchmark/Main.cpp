@@ -0,0 +1,1564 @@
+#include "Benchmark/BenchSuite.h"
+#include "Graphics/Graphics.h"
+#include "Graphics/Image.h"
+#include "Graphics/HalfSpace.h"
+#include "Graphics/SpanFill.h"
+#include "Utility/Simd.h"
+#include "Utility/Vec2Batch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////
+// Options read from the command line
+struct Options
+{
+    double minSeconds = 0.2;
+    std::string filter;
+    std::string csvPath;
+    std::string jsonPath;
+    unsigned threads = 0u;
+    bool deferred = false;
+    bool quick = false;
+};
+
+//////////////////////////////////////////////////////////////////
+// A primitive placed on the surface, points past the count are 
+//      unused
+struct Primitive
+{
+    Vec2<int> v[3] = { { 0, 0 }, { 0, 0 }, { 0, 0 } };
+};
+
+//////////////////////////////////////////////////////////////////
+// Kinds of primitive the sweeps draw
+enum class Shape { TRIANGLE, RECTANGLE, LINE };
+
+// Primitives per batch, enough that per batch overhead disappears
+static constexpr int batchSize = 1024;
+
+//////////////////////////////////////////////////////////////////
+// Prints the command line options
+static void PrintUsage()
+{
+    std::printf(
+        "Usage: Benchmark [options]\n"
+        "  --min-time <ms>   time spent repeating each measurement (default 200)\n"
+        "  --filter <text>   only run measurements whose name contains text\n"
+        "  --csv <path>      write results as comma separated values\n"
+        "  --json <path>     write results as JSON\n"
+        "  --deferred <n>    draw through the tile renderer with n threads, 0 for all\n"
+        "  --quick           sweep fewer sizes and resolutions\n" );
+}
+
+//////////////////////////////////////////////////////////////////
+// Reads the command line, returns false if it can't be understood
+static bool ParseOptions(
+    int      argc,
+    char**   argv,
+    Options& options )
+{
+    for ( int i = 1; i < argc; ++i )
+    {
+        const bool hasValue = i + 1 < argc;
+        if ( !std::strcmp( argv[i], "--min-time" ) && hasValue )
+            options.minSeconds = std::atof( argv[++i] ) * 1e-3;
+        else if ( !std::strcmp( argv[i], "--filter" ) && hasValue )
+            options.filter = argv[++i];
+        else if ( !std::strcmp( argv[i], "--csv" ) && hasValue )
+            options.csvPath = argv[++i];
+        else if ( !std::strcmp( argv[i], "--json" ) && hasValue )
+            options.jsonPath = argv[++i];
+        else if ( !std::strcmp( argv[i], "--deferred" ) && hasValue )
+        {
+            options.deferred = true;
+            options.threads = static_cast<unsigned>( std::atoi( argv[++i] ) );
+        }
+        else if ( !std::strcmp( argv[i], "--quick" ) )
+            options.quick = true;
+        else
+            return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// Places a batch of primitives of one shape at random positions 
+//      that keep them entirely on the surface. Triangles and 
+//      rectangles cover size * size pixels stretched by the aspect
+//      ratio, lines are size pixels long
+static std::vector<Primitive> MakeBatch(
+    Shape  shape,
+    int    width,
+    int    height,
+    int    size,
+    float  aspect,
+    int    angle )
+{
+    const double w = size * std::sqrt( aspect ), h = size / std::sqrt( aspect );
+    const double radians = angle * 3.14159265358979 / 180.0, c = std::cos( radians ), s = std::sin( radians );
+
+    // Corners relative to the first vertex before rotation, triangles are right angled so their area is w * h / 2
+    double local[3][2] = { { 0.0, 0.0 }, { w, 0.0 }, { 0.0, h } };
+    if ( shape == Shape::TRIANGLE )
+    {
+        // Twice the area keeps triangles and rectangles of the same size comparable
+        for ( double* point : local )
+        {
+            point[0] *= std::sqrt( 2.0 );
+            point[1] *= std::sqrt( 2.0 );
+        }
+    }
+    else if ( shape == Shape::RECTANGLE )
+        local[1][1] = h;
+    else
+        local[1][0] = size;
+
+    int offset[3][2], loX = 0, hiX = 0, loY = 0, hiY = 0;
+    for ( int i = 0; i < 3; ++i )
+    {
+        // Rectangles stay axis aligned because that is all DrawRectangle can do
+        const bool rotate = shape != Shape::RECTANGLE;
+        const double x = rotate ? local[i][0] * c - local[i][1] * s : local[i][0];
+        const double y = rotate ? local[i][0] * s + local[i][1] * c : local[i][1];
+        offset[i][0] = static_cast<int>( std::lround( x ) );
+        offset[i][1] = static_cast<int>( std::lround( y ) );
+        loX = std::min( loX, offset[i][0] ), hiX = std::max( hiX, offset[i][0] );
+        loY = std::min( loY, offset[i][1] ), hiY = std::max( hiY, offset[i][1] );
+    }
+
+    std::vector<Primitive> batch;
+    if ( hiX - loX >= width || hiY - loY >= height )
+        return batch;
+
+    // Fixed seed so every run and every variant draws the same batch
+    std::mt19937 rng( 12345u );
+    std::uniform_int_distribution<int> column( -loX, width - 1 - hiX ), row( -loY, height - 1 - hiY );
+    batch.resize( batchSize );
+    for ( Primitive& primitive : batch )
+    {
+        const int x = column( rng ), y = row( rng );
+        for ( int i = 0; i < 3; ++i )
+            primitive.v[i] = Vec2<int>( x + offset[i][0], y + offset[i][1] );
+    }
+    return batch;
+}
+
+//////////////////////////////////////////////////////////////////
+// Draws a batch of primitives with the given color
+static void DrawBatch(
+    Graphics&                     gfx,
+    Shape                         shape,
+    const std::vector<Primitive>& batch,
+    const Color&                  color )
+{
+    for ( const Primitive& primitive : batch )
+    {
+        switch ( shape )
+        {
+        case Shape::TRIANGLE:
+            gfx.DrawTriangle( primitive.v[0], primitive.v[1], primitive.v[2], color );
+            break;
+        case Shape::RECTANGLE:
+            gfx.DrawRectangle( primitive.v[0], primitive.v[1], color );
+            break;
+        case Shape::LINE:
+            gfx.DrawLine( primitive.v[0], primitive.v[1], color );
+            break;
+        }
+    }
+    gfx.Flush();
+}
+
+//////////////////////////////////////////////////////////////////
+// Counts the pixels a batch writes by drawing each primitive alone
+//      onto a black surface, so fill rates are in pixels actually 
+//      written rather than nominal areas. Wide lines reach margin
+//      pixels past their points
+static uint64_t CountPixels(
+    Graphics&                     gfx,
+    Shape                         shape,
+    const std::vector<Primitive>& batch,
+    int                           margin = 0 )
+{
+    Framebuffer& frame = gfx.GetFramebuffer();
+    SpanFill::Clear( frame, 0u );
+
+    uint64_t count = 0u;
+    std::vector<Primitive> single( 1 );
+    for ( const Primitive& primitive : batch )
+    {
+        single[0] = primitive;
+        DrawBatch( gfx, shape, single, Color( 0xFFFFFF ) );
+
+        const int loX = std::max( std::min( { primitive.v[0].x, primitive.v[1].x, primitive.v[2].x } ) - margin, 0 );
+        const int hiX = std::min( std::max( { primitive.v[0].x, primitive.v[1].x, primitive.v[2].x } ) + margin, frame.GetWidth() - 1 );
+        const int loY = std::max( std::min( { primitive.v[0].y, primitive.v[1].y, primitive.v[2].y } ) - margin, 0 );
+        const int hiY = std::min( std::max( { primitive.v[0].y, primitive.v[1].y, primitive.v[2].y } ) + margin, frame.GetHeight() - 1 );
+        for ( int y = loY; y <= hiY; ++y )
+        {
+            uint32_t* row = frame.GetRow( y );
+            for ( int x = loX; x <= hiX; ++x )
+            {
+                count += row[x] != 0u;
+                row[x] = 0u;
+            }
+        }
+    }
+    return count;
+}
+
+//////////////////////////////////////////////////////////////////
+// Counts the pixels of a surface that aren't black, for shapes that
+//      are drawn onto a cleared surface and counted whole
+static uint64_t CountWritten( const Framebuffer& frame )
+{
+    uint64_t count = 0u;
+    for ( int y = 0; y < frame.GetHeight(); ++y )
+        for ( int x = 0; x < frame.GetWidth(); ++x )
+            count += frame.GetRow( y )[x] != 0u;
+    return count;
+}
+
+//////////////////////////////////////////////////////////////////
+// Returns every SIMD level this processor can run
+static std::vector<Simd::Level> GetLevels()
+{
+    std::vector<Simd::Level> levels;
+    for ( Simd::Level level : { Simd::Level::SCALAR, Simd::Level::SSE2, Simd::Level::AVX2 } )
+        if ( level <= Simd::GetSupportedLevel() )
+            levels.push_back( level );
+    return levels;
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures full surface clears at every resolution and SIMD level
+static void RunClears(
+    BenchSuite&                   suite,
+    const std::vector<Vec2<int>>& resolutions )
+{
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Framebuffer frame( resolution.x, resolution.y );
+        for ( Simd::Level level : GetLevels() )
+        {
+            BenchParams params;
+            params.primitive = "clear";
+            params.variant = "spanfill";
+            params.simd = Simd::GetName( level );
+            params.width = resolution.x;
+            params.height = resolution.y;
+
+            Simd::SetLevel( level );
+            const uint64_t pixels = static_cast<uint64_t>( resolution.x ) * resolution.y;
+            suite.Run( params, 1u, pixels, [&frame] { SpanFill::Clear( frame, 0x333333u ); } );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures one shape across sizes, aspect ratios, orientations,
+//      resolutions, SIMD levels and rasterizers
+static void RunShape(
+    BenchSuite&                   suite,
+    const Options&                options,
+    Shape                         shape,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    static const char* names[] = { "triangle", "rectangle", "line" };
+    const std::vector<float> aspects = shape == Shape::LINE ? std::vector<float>{ 1.0f } : std::vector<float>{ 1.0f, 4.0f, 0.25f };
+    const std::vector<int> angles = shape == Shape::RECTANGLE ? std::vector<int>{ 0 } : std::vector<int>{ 0, 30, 45, 90, 135 };
+
+    std::vector<Graphics::TriangleRasterizer> rasterizers = { Graphics::TriangleRasterizer::HALFSPACE };
+    if ( shape == Shape::TRIANGLE )
+        rasterizers.push_back( Graphics::TriangleRasterizer::SCANLINE );
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( Graphics::TriangleRasterizer rasterizer : rasterizers )
+        for ( int size : sizes )
+        for ( float aspect : aspects )
+        for ( int angle : angles )
+        {
+            BenchParams params;
+            params.primitive = names[static_cast<int>( shape )];
+            params.variant = shape != Shape::TRIANGLE ? "bresenham" : 
+                rasterizer == Graphics::TriangleRasterizer::HALFSPACE ? "halfspace" : "scanline";
+            if ( shape == Shape::RECTANGLE )
+                params.variant = "span";
+            if ( options.deferred )
+                params.variant += "-deferred";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+            params.aspect = aspect;
+            params.angle = angle;
+
+            const std::vector<Primitive> batch = MakeBatch( shape, resolution.x, resolution.y, size, aspect, angle );
+            if ( batch.empty() )
+                continue;
+
+            gfx.SetTriangleRasterizer( rasterizer );
+            uint64_t pixels = 0u;
+            for ( Simd::Level level : GetLevels() )
+            {
+                params.simd = Simd::GetName( level );
+                if ( !suite.IsSelected( params ) )
+                    continue;
+
+                // Coverage doesn't depend on the SIMD level, count it once
+                Simd::SetLevel( level );
+                if ( pixels == 0u )
+                    pixels = CountPixels( gfx, shape, batch );
+
+                suite.Run( params, batch.size(), pixels, [&] { DrawBatch( gfx, shape, batch, Color( 0x4080C0 ) ); } );
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures a grid mesh drawn as one indexed batch against the same
+//      triangles drawn one call at a time
+static void RunMesh(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            // A grid of cells covering the surface, two triangles per cell sharing every interior vertex
+            const int columns = resolution.x / size, rows = resolution.y / size;
+            if ( columns == 0 || rows == 0 )
+                continue;
+
+            std::vector<Vec2<int>> vertices;
+            for ( int y = 0; y <= rows; ++y )
+                for ( int x = 0; x <= columns; ++x )
+                    vertices.emplace_back( x * size, y * size );
+
+            std::vector<uint32_t> indices;
+            std::vector<Color> colors;
+            for ( int y = 0; y < rows; ++y )
+            {
+                for ( int x = 0; x < columns; ++x )
+                {
+                    const uint32_t corner = static_cast<uint32_t>( y * ( columns + 1 ) + x ), above = corner + columns + 1;
+                    indices.insert( indices.end(), { corner, corner + 1, above + 1, corner, above + 1, above } );
+                    colors.insert( colors.end(), { Color( 0x4080C0 ), Color( 0xC08040 ) } );
+                }
+            }
+
+            std::vector<Vec2<float>> points;
+            for ( const Vec2<int>& vertex : vertices )
+                points.emplace_back( static_cast<float>( vertex.x ), static_cast<float>( vertex.y ) );
+            const Vec2Batch batch( points.data(), points.size() );
+            const float cx = resolution.x * 0.5f, cy = resolution.y * 0.5f;
+            const Affine2<float> transform = Affine2<float>::Translation( cx, cy ) * Affine2<float>::Rotation( 0.05f ) * Affine2<float>::Translation( -cx, -cy );
+
+            BenchParams params;
+            params.primitive = "mesh";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            const uint64_t triangles = colors.size(), pixels = static_cast<uint64_t>( columns * size ) * ( rows * size );
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                params.variant = options.deferred ? "batched-deferred" : "batched";
+                suite.Run( params, triangles, pixels, [&]
+                {
+                    gfx.DrawTriangles( vertices.data(), vertices.size(), indices.data(), indices.size(), colors.data(), Graphics::MeshColors::PER_TRIANGLE );
+                    gfx.Flush();
+                } );
+
+                // The same grid turned slightly about its center, every vertex goes through the transform kernels
+                params.variant = options.deferred ? "transformed-deferred" : "transformed";
+                suite.Run( params, triangles, pixels, [&]
+                {
+                    gfx.DrawTriangles( batch, transform, indices.data(), indices.size(), colors.data(), Graphics::MeshColors::PER_TRIANGLE );
+                    gfx.Flush();
+                } );
+
+                params.variant = options.deferred ? "single-deferred" : "single";
+                suite.Run( params, triangles, pixels, [&]
+                {
+                    for ( size_t t = 0; t < colors.size(); ++t )
+                        gfx.DrawTriangle( vertices[indices[t * 3]], vertices[indices[t * 3 + 1]], vertices[indices[t * 3 + 2]], colors[t] );
+                    gfx.Flush();
+                } );
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures moving vertices into fixed point for the rasterizer, one
+//      point at a time against the batch kernels at every SIMD level
+static void RunTransform(
+    BenchSuite&    suite,
+    const Options& options )
+{
+    const std::vector<int> counts = options.quick ? std::vector<int>{ 4096 } : std::vector<int>{ 256, 4096, 65536 };
+    const Affine2<float> transform = Affine2<float>::Translation( 640.0f, 360.0f ) * Affine2<float>::Rotation( 0.3f ) * Affine2<float>::Scale( 1.5f, 1.5f );
+
+    // Fixed seed so every run transforms the same points
+    std::mt19937 rng( 1234u );
+    std::uniform_real_distribution<float> coordinate( -500.0f, 500.0f );
+    for ( int count : counts )
+    {
+        std::vector<Vec2<float>> points;
+        for ( int i = 0; i < count; ++i )
+            points.emplace_back( coordinate( rng ), coordinate( rng ) );
+        const Vec2Batch batch( points.data(), points.size() );
+        std::vector<Vec2<int>> out( points.size() );
+
+        BenchParams params;
+        params.primitive = "transform";
+        params.size = count;
+
+        // What callers did before batches, a point at a time through the scalar transform, which doesn't dispatch
+        params.variant = "each";
+        params.simd = Simd::GetName( Simd::Level::SCALAR );
+        suite.Run( params, static_cast<uint64_t>( count ), 0u, [&]
+        {
+            for ( size_t i = 0; i < points.size(); ++i )
+            {
+                const Vec2<float> moved = transform.Apply( points[i] );
+                out[i] = Vec2<int>( static_cast<int>( std::lrint( moved.x * HalfSpace::subpixelScale ) ), static_cast<int>( std::lrint( moved.y * HalfSpace::subpixelScale ) ) );
+            }
+        } );
+
+        params.variant = "batch";
+        for ( Simd::Level level : GetLevels() )
+        {
+            Simd::SetLevel( level );
+            params.simd = Simd::GetName( level );
+            suite.Run( params, static_cast<uint64_t>( count ), 0u, [&]
+            {
+                batch.TransformToFixed( transform, HalfSpace::subpixelBits, out.data() );
+            } );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures translucent rectangles and triangles in every blend mode
+//      against the same shapes drawn opaque
+static void RunBlend(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    static const char* names[] = { "blend-triangle", "blend-rectangle" };
+    static const char* modes[] = { "src-over", "additive", "multiply" };
+    static const BlendMode blends[] = { BlendMode::SRC_OVER, BlendMode::ADDITIVE, BlendMode::MULTIPLY };
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( Shape shape : { Shape::TRIANGLE, Shape::RECTANGLE } )
+        for ( int size : sizes )
+        {
+            const std::vector<Primitive> batch = MakeBatch( shape, resolution.x, resolution.y, size, 1.0f, 0 );
+            if ( batch.empty() )
+                continue;
+
+            BenchParams params;
+            params.primitive = names[static_cast<int>( shape )];
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            uint64_t pixels = 0u;
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                // Opaque first as the baseline, then every mode at half coverage
+                for ( int mode = -1; mode < 3; ++mode )
+                {
+                    params.variant = mode < 0 ? "opaque" : modes[mode];
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    gfx.SetBlendMode( BlendMode::SRC_OVER );
+                    if ( pixels == 0u )
+                        pixels = CountPixels( gfx, shape, batch );
+
+                    const Color color( 0x4080C0, mode < 0 ? 255 : 128 );
+                    gfx.SetBlendMode( mode < 0 ? BlendMode::SRC_OVER : blends[mode] );
+                    suite.Run( params, batch.size(), pixels, [&] { DrawBatch( gfx, shape, batch, color ); } );
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures overdraw of stacked full surface meshes drawn in painter's
+//      order without depth, and with depth nearest first where the
+//      coarse depths reject hidden layers and farthest first where 
+//      every layer passes
+static void RunDepth(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    constexpr int layers = 6;
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            const int columns = resolution.x / size, rows = resolution.y / size;
+            if ( columns == 0 || rows == 0 )
+                continue;
+
+            // Each layer is a grid mesh with its own slightly tilted depth
+            std::vector<Vec2<int>> vertices;
+            for ( int y = 0; y <= rows; ++y )
+                for ( int x = 0; x <= columns; ++x )
+                    vertices.emplace_back( x * size, y * size );
+
+            std::vector<uint32_t> indices;
+            for ( int y = 0; y < rows; ++y )
+            {
+                for ( int x = 0; x < columns; ++x )
+                {
+                    const uint32_t corner = static_cast<uint32_t>( y * ( columns + 1 ) + x ), above = corner + columns + 1;
+                    indices.insert( indices.end(), { corner, corner + 1, above + 1, corner, above + 1, above } );
+                }
+            }
+
+            std::vector<std::vector<float>> depths( layers );
+            std::vector<std::vector<Color>> colors( layers );
+            for ( int layer = 0; layer < layers; ++layer )
+            {
+                for ( const Vec2<int>& vertex : vertices )
+                    depths[layer].push_back( ( layer + 0.5f * vertex.x / resolution.x ) / ( layers + 1 ) );
+                colors[layer].assign( indices.size() / 3, Color( 0x203040u * ( layer + 1 ) ) );
+            }
+
+            BenchParams params;
+            params.primitive = "depth";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            const uint64_t triangles = indices.size() / 3 * layers, pixels = static_cast<uint64_t>( columns * size ) * ( rows * size );
+            auto drawLayers = [&]( bool depth, bool nearestFirst )
+            {
+                for ( int i = 0; i < layers; ++i )
+                {
+                    const int layer = nearestFirst ? i : layers - 1 - i;
+                    gfx.DrawTriangles( vertices.data(), vertices.size(), indices.data(), indices.size(), 
+                        colors[layer].data(), Graphics::MeshColors::PER_TRIANGLE, depth ? depths[layer].data() : nullptr );
+                }
+
+                // Updating clears the depth for the next repetition
+                gfx.Update();
+            };
+
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                const std::string suffix = options.deferred ? "-deferred" : "";
+                params.variant = "painter" + suffix;
+                if ( suite.IsSelected( params ) )
+                {
+                    gfx.DisableDepth();
+                    suite.Run( params, triangles, pixels, [&] { drawLayers( false, false ); } );
+                }
+
+                gfx.EnableDepth();
+                params.variant = "front-to-back" + suffix;
+                if ( suite.IsSelected( params ) )
+                    suite.Run( params, triangles, pixels, [&] { drawLayers( true, true ); } );
+
+                params.variant = "back-to-front" + suffix;
+                if ( suite.IsSelected( params ) )
+                    suite.Run( params, triangles, pixels, [&] { drawLayers( true, false ); } );
+                gfx.DisableDepth();
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Maps one interpolated attribute through a palette the way a heat
+//      map would, expanding a chunk of the span at a time
+static void HeatShader(
+    uint32_t*         pixels,
+    const ShadedSpan& span,
+    const void*       user )
+{
+    const uint32_t* palette = static_cast<const uint32_t*>( user );
+    constexpr int chunk = 256;
+    int32_t values[chunk];
+    for ( int i = 0; i < span.count; i += chunk )
+    {
+        const int length = std::min( chunk, span.count - i );
+        Shading::Expand( values, static_cast<size_t>( length ), span.value[0] + span.step[0] * i, span.step[0] );
+        for ( int j = 0; j < length; ++j )
+            pixels[i + j] = palette[static_cast<uint8_t>( values[j] >> Shading::fractionBits )];
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures triangles with interpolated attributes against the same
+//      triangles drawn flat, with vertex colors opaque and translucent
+//      and with one attribute mapped by a custom shader
+static void RunShading(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    static const char* variants[] = { "flat", "gouraud", "gouraud-translucent", "heat-map" };
+
+    uint32_t palette[256];
+    for ( uint32_t i = 0; i < 256u; ++i )
+        palette[i] = 0xFF000000u | ( i << 16 ) | ( ( i * i >> 8 ) << 8 ) | ( 255u - i );
+    const float heat[3] = { 0.0f, 128.0f, 255.0f };
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            const std::vector<Primitive> batch = MakeBatch( Shape::TRIANGLE, resolution.x, resolution.y, size, 1.0f, 0 );
+            if ( batch.empty() )
+                continue;
+
+            BenchParams params;
+            params.primitive = "shaded-triangle";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            uint64_t pixels = 0u;
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                for ( int variant = 0; variant < 4; ++variant )
+                {
+                    params.variant = variants[variant];
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    if ( pixels == 0u )
+                        pixels = CountPixels( gfx, Shape::TRIANGLE, batch );
+
+                    const uint8_t alpha = variant == 2 ? 128 : 255;
+                    suite.Run( params, batch.size(), pixels, [&]
+                    {
+                        for ( const Primitive& primitive : batch )
+                        {
+                            if ( variant == 0 )
+                                gfx.DrawTriangle( primitive.v[0], primitive.v[1], primitive.v[2], Color( 0x4080C0 ) );
+                            else if ( variant == 3 )
+                                gfx.DrawTriangleShaded( primitive.v[0], primitive.v[1], primitive.v[2], heat, 1, HeatShader, palette );
+                            else
+                                gfx.DrawTriangle( primitive.v[0], primitive.v[1], primitive.v[2], 
+                                    Color( 0xFF0000, alpha ), Color( 0x00FF00, alpha ), Color( 0x0000FF, alpha ) );
+                        }
+                        gfx.Flush();
+                    } );
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures textured triangles with each filter, minified four texels
+//      to a pixel and in perspective, with and without mipmaps so the
+//      cost of sampling the full size level far apart shows
+static void RunTexture(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    static const char* variants[] = { "nearest", "bilinear", "nearest-no-mips", "bilinear-no-mips" };
+
+    // Noise defeats any locality the texels would have by accident
+    constexpr int textureSize = 1024;
+    std::vector<uint32_t> image( textureSize * textureSize );
+    std::mt19937 rng( 777u );
+    for ( uint32_t& texel : image )
+        texel = rng() | 0xFF000000u;
+    const Texture mipmapped( textureSize, textureSize, image.data(), textureSize );
+    const Texture flat( textureSize, textureSize, image.data(), textureSize, false );
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            const std::vector<Primitive> batch = MakeBatch( Shape::TRIANGLE, resolution.x, resolution.y, size, 1.0f, 0 );
+            if ( batch.empty() )
+                continue;
+
+            BenchParams params;
+            params.primitive = "textured-triangle";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            // About four texels per pixel along each side on average, nearer at the first vertex
+            const float repeat = 4.0f * size * std::sqrt( 2.0f ) / textureSize;
+            uint64_t pixels = 0u;
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                for ( int variant = 0; variant < 4; ++variant )
+                {
+                    params.variant = variants[variant];
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    if ( pixels == 0u )
+                        pixels = CountPixels( gfx, Shape::TRIANGLE, batch );
+
+                    const Texture& texture = variant < 2 ? mipmapped : flat;
+                    gfx.SetTextureFilter( variant % 2 == 0 ? TextureFilter::NEAREST : TextureFilter::BILINEAR );
+                    suite.Run( params, batch.size(), pixels, [&]
+                    {
+                        for ( const Primitive& primitive : batch )
+                            gfx.DrawTriangleTextured( primitive.v[0], primitive.v[1], primitive.v[2],
+                                { 0.0f, 0.0f }, { repeat, 0.0f }, { 0.0f, repeat }, texture, 1.0f, 2.0f, 2.0f );
+                        gfx.Flush();
+                    } );
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures anti-aliased and wide lines against Bresenham's, and a
+//      dense chart drawn as one polyline against the same lines drawn
+//      one call at a time
+static void RunStroke(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    struct Variant
+    {
+        const char* name;
+        float width;
+        bool antialias;
+        uint8_t alpha;
+        bool chart;
+        bool polyline;
+    };
+    static const Variant variants[] = {
+        { "bresenham", 1.0f, false, 255, false, false },
+        { "antialiased", 1.0f, true, 255, false, false },
+        { "antialiased-translucent", 1.0f, true, 128, false, false },
+        { "wide-4", 4.0f, false, 255, false, false },
+        { "wide-4-antialiased", 4.0f, true, 255, false, false },
+        { "chart-lines", 1.0f, true, 255, true, false },
+        { "chart-polyline", 1.0f, true, 255, true, true } };
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            const std::vector<Primitive> batch = MakeBatch( Shape::LINE, resolution.x, resolution.y, size, 1.0f, 30 );
+            if ( batch.empty() )
+                continue;
+
+            // One point per column step across the surface wandering up and down by up to half the size
+            std::vector<Vec2<int>> chart;
+            std::mt19937 rng( 4242u );
+            std::uniform_int_distribution<int> wander( -size / 2, size / 2 );
+            int y = resolution.y / 2;
+            for ( int i = 0; i <= batchSize; ++i )
+            {
+                y = std::clamp( y + wander( rng ), 0, resolution.y - 1 );
+                chart.emplace_back( i * ( resolution.x - 1 ) / batchSize, y );
+            }
+
+            BenchParams params;
+            params.primitive = "stroke";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                for ( const Variant& variant : variants )
+                {
+                    params.variant = variant.name;
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    gfx.SetLineWidth( variant.width );
+                    gfx.SetLineAntialiasing( variant.antialias );
+                    const Color color( 0x4080C0, variant.alpha );
+                    auto draw = [&]
+                    {
+                        if ( variant.polyline )
+                            gfx.DrawPolyline( chart.data(), chart.size(), color );
+                        else if ( variant.chart )
+                            for ( size_t i = 0; i + 1 < chart.size(); ++i )
+                                gfx.DrawLine( chart[i], chart[i + 1], color );
+                        else
+                            DrawBatch( gfx, Shape::LINE, batch, color );
+                        gfx.Flush();
+                    };
+
+                    // Charts are counted whole, their lines overlap at every point
+                    uint64_t pixels = 0u;
+                    if ( variant.chart )
+                    {
+                        SpanFill::Clear( gfx.GetFramebuffer(), 0u );
+                        draw();
+                        pixels = CountWritten( gfx.GetFramebuffer() );
+                    }
+                    else
+                        pixels = CountPixels( gfx, Shape::LINE, batch, static_cast<int>( variant.width ) );
+
+                    suite.Run( params, batchSize, pixels, draw );
+                }
+            }
+            gfx.SetLineWidth( 1.0f );
+            gfx.SetLineAntialiasing( false );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures circles and ellipses drawn natively against circles
+//      filled as fans of triangles, small sizes are scatter plot 
+//      markers
+static void RunEllipse(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    enum class Draw { OUTLINE, FILLED, FAN };
+    struct Variant
+    {
+        const char* name;
+        Draw draw;
+        bool wide;
+        uint8_t alpha;
+    };
+    static const Variant variants[] = {
+        { "outline", Draw::OUTLINE, false, 255 },
+        { "filled", Draw::FILLED, false, 255 },
+        { "filled-translucent", Draw::FILLED, false, 128 },
+        { "filled-wide", Draw::FILLED, true, 255 },
+        { "triangle-fan", Draw::FAN, false, 255 } };
+
+    // Segments of a fan, about what a caller would pick for a round looking circle
+    constexpr int segments = 32;
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            // Each primitive fits in a size by size square that stays on the surface
+            const std::vector<Primitive> batch = MakeBatch( Shape::RECTANGLE, resolution.x, resolution.y, size, 1.0f, 0 );
+            if ( batch.empty() )
+                continue;
+
+            const int radius = size / 2;
+            std::vector<Vec2<int>> fan;
+            for ( int i = 0; i <= segments; ++i )
+            {
+                const double angle = i * 2.0 * 3.14159265358979 / segments;
+                fan.emplace_back( static_cast<int>( std::lround( radius * std::cos( angle ) ) ), static_cast<int>( std::lround( radius * std::sin( angle ) ) ) );
+            }
+
+            BenchParams params;
+            params.primitive = "ellipse";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                for ( const Variant& variant : variants )
+                {
+                    params.variant = variant.name;
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    const Color color( 0x4080C0, variant.alpha );
+                    const int radiusY = variant.wide ? radius / 2 : radius;
+                    auto draw = [&]( const Primitive& primitive )
+                    {
+                        const Vec2<int> center( primitive.v[0].x + radius, primitive.v[0].y + radius );
+                        switch ( variant.draw )
+                        {
+                        case Draw::OUTLINE:
+                            gfx.DrawEllipse( center, radius, radiusY, color );
+                            break;
+                        case Draw::FILLED:
+                            gfx.FillEllipse( center, radius, radiusY, color );
+                            break;
+                        case Draw::FAN:
+                            for ( int i = 0; i < segments; ++i )
+                                gfx.DrawTriangle( center, 
+                                    { center.x + fan[i].x, center.y + fan[i].y }, { center.x + fan[i + 1].x, center.y + fan[i + 1].y }, color );
+                            break;
+                        }
+                    };
+
+                    // Every primitive is the same shape and entirely on the surface, count one and scale
+                    SpanFill::Clear( gfx.GetFramebuffer(), 0u );
+                    draw( batch[0] );
+                    gfx.Flush();
+                    const uint64_t pixels = CountWritten( gfx.GetFramebuffer() );
+
+                    suite.Run( params, batch.size(), pixels * batch.size(), [&]
+                    {
+                        for ( const Primitive& primitive : batch )
+                            draw( primitive );
+                        gfx.Flush();
+                    } );
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures polygons filled by the scanline filler, convex outlines
+//      are also drawn as the triangle fans callers used to build
+static void RunPolygon(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    enum class Outline { REGULAR, BLOB, STAR, RING };
+    struct Variant
+    {
+        const char* name;
+        Outline outline;
+        FillRule rule;
+        bool fan;
+    };
+    static const Variant variants[] = {
+        { "regular-64", Outline::REGULAR, FillRule::NON_ZERO, false },
+        { "regular-64-fan", Outline::REGULAR, FillRule::NON_ZERO, true },
+        { "blob-64", Outline::BLOB, FillRule::NON_ZERO, false },
+        { "star-even-odd", Outline::STAR, FillRule::EVEN_ODD, false },
+        { "ring", Outline::RING, FillRule::EVEN_ODD, false } };
+
+    constexpr int corners = 64;
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            // Each polygon fits in a size by size square that stays on the surface
+            const std::vector<Primitive> batch = MakeBatch( Shape::RECTANGLE, resolution.x, resolution.y, size, 1.0f, 0 );
+            if ( batch.empty() )
+                continue;
+
+            BenchParams params;
+            params.primitive = "polygon";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                for ( const Variant& variant : variants )
+                {
+                    params.variant = variant.name;
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    // Outlines around the middle of the square, a blob wanders in and out and a ring is two squares
+                    std::vector<Vec2<int>> outline;
+                    std::vector<size_t> contours;
+                    const double radius = size * 0.5, pi = 3.14159265358979;
+                    std::mt19937 rng( 777u );
+                    std::uniform_real_distribution<double> wander( 0.5, 1.0 );
+                    auto corner = [&]( double angle, double scale )
+                    {
+                        outline.emplace_back( 
+                            static_cast<int>( std::lround( radius + scale * radius * std::cos( angle ) ) ), 
+                            static_cast<int>( std::lround( radius + scale * radius * std::sin( angle ) ) ) );
+                    };
+                    switch ( variant.outline )
+                    {
+                    case Outline::REGULAR:
+                    case Outline::BLOB:
+                        for ( int i = 0; i < corners; ++i )
+                            corner( i * 2.0 * pi / corners, variant.outline == Outline::BLOB ? wander( rng ) : 1.0 );
+                        contours.push_back( corners );
+                        break;
+                    case Outline::STAR:
+                        for ( int i = 0; i < 5; ++i )
+                            corner( i * 4.0 * pi / 5, 1.0 );
+                        contours.push_back( 5u );
+                        break;
+                    case Outline::RING:
+                        for ( double scale : { 1.0, 0.5 } )
+                            for ( int i = 0; i < 4; ++i )
+                                corner( ( i + 0.5 ) * pi / 2, scale );
+                        contours = { 4u, 4u };
+                        break;
+                    }
+
+                    gfx.SetFillRule( variant.rule );
+                    std::vector<Vec2<int>> moved( outline );
+                    auto draw = [&]( const Primitive& primitive )
+                    {
+                        for ( size_t i = 0; i < outline.size(); ++i )
+                            moved[i] = Vec2<int>( primitive.v[0].x + outline[i].x, primitive.v[0].y + outline[i].y );
+                        if ( !variant.fan )
+                            return gfx.DrawPolygon( moved.data(), contours.data(), contours.size(), Color( 0x4080C0 ) );
+                        for ( size_t i = 1; i + 1 < moved.size(); ++i )
+                            gfx.DrawTriangle( moved[0], moved[i], moved[i + 1], Color( 0x4080C0 ) );
+                    };
+
+                    // Every polygon is the same shape and entirely on the surface, count one and scale
+                    SpanFill::Clear( gfx.GetFramebuffer(), 0u );
+                    draw( batch[0] );
+                    gfx.Flush();
+                    const uint64_t pixels = CountWritten( gfx.GetFramebuffer() );
+
+                    suite.Run( params, batch.size(), pixels * batch.size(), [&]
+                    {
+                        for ( const Primitive& primitive : batch )
+                            draw( primitive );
+                        gfx.Flush();
+                    } );
+                }
+            }
+            gfx.SetFillRule( FillRule::NON_ZERO );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures Bezier paths filled and stroked, drawn where they were
+//      last time so their flattening is reused and moved a fraction
+//      of a pixel every time so it never is
+static void RunPath(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    struct Variant
+    {
+        const char* name;
+        bool fill;
+        bool antialias;
+        bool moving;
+    };
+    static const Variant variants[] = {
+        { "fill-cached", true, false, false },
+        { "fill-moving", true, false, true },
+        { "stroke-cached", false, false, false },
+        { "stroke-moving", false, false, true },
+        { "stroke-antialiased-cached", false, true, false } };
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            // Each path fits in a size by size square that stays on the surface
+            const std::vector<Primitive> batch = MakeBatch( Shape::RECTANGLE, resolution.x, resolution.y, size, 1.0f, 0 );
+            if ( batch.empty() )
+                continue;
+
+            // A leaf, two cubics meeting at sharp tips, with a quadratic vein down the middle
+            const float s = static_cast<float>( size );
+            std::vector<Path> paths( batch.size() );
+            for ( Path& path : paths )
+            {
+                path.MoveTo( { 0.0f, s } );
+                path.CubicTo( { 0.0f, s * 0.3f }, { s * 0.3f, 0.0f }, { s, 0.0f } );
+                path.CubicTo( { s, s * 0.7f }, { s * 0.7f, s }, { 0.0f, s } );
+                path.Close();
+                path.MoveTo( { s * 0.2f, s * 0.8f } );
+                path.QuadTo( { s * 0.6f, s * 0.6f }, { s * 0.8f, s * 0.2f } );
+            }
+
+            BenchParams params;
+            params.primitive = "path";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                for ( const Variant& variant : variants )
+                {
+                    params.variant = variant.name;
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    gfx.SetLineAntialiasing( variant.antialias );
+                    float shift = 0.0f;
+                    auto draw = [&]( size_t i )
+                    {
+                        const Affine2<float> transform = Affine2<float>::Translation( batch[i].v[0].x + shift, static_cast<float>( batch[i].v[0].y ) );
+                        if ( variant.fill )
+                            gfx.FillPath( paths[i], Color( 0x4080C0 ), transform );
+                        else
+                            gfx.StrokePath( paths[i], Color( 0x4080C0 ), transform );
+                    };
+
+                    // Every path is the same shape and entirely on the surface, count one and scale
+                    SpanFill::Clear( gfx.GetFramebuffer(), 0u );
+                    draw( 0 );
+                    gfx.Flush();
+                    const uint64_t pixels = CountWritten( gfx.GetFramebuffer() );
+
+                    suite.Run( params, batch.size(), pixels * batch.size(), [&]
+                    {
+                        if ( variant.moving )
+                            shift = shift > 0.0f ? 0.0f : 0.5f;
+                        for ( size_t i = 0; i < batch.size(); ++i )
+                            draw( i );
+                        gfx.Flush();
+                    } );
+                }
+            }
+            gfx.SetLineAntialiasing( false );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures opaque images copied a row at a time against sprites of
+//      a disc, color keyed, with a soft edge and translucent all over
+//      so every pixel blends
+static void RunSprite(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    static const char* variants[] = { "image", "sprite-keyed", "sprite-alpha", "sprite-translucent" };
+    constexpr uint32_t key = 0xFF00FFu;
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            const std::vector<Primitive> batch = MakeBatch( Shape::RECTANGLE, resolution.x, resolution.y, size, 1.0f, 0 );
+            if ( batch.empty() )
+                continue;
+
+            // A disc a pixel from the edges with a pattern inside, the alpha image fades its last two pixels out
+            std::vector<uint32_t> opaque( static_cast<size_t>( size ) * size ), keyed( opaque.size() ), soft( opaque.size() ), translucent( opaque.size() );
+            const float radius = size * 0.5f - 1.0f;
+            for ( int y = 0; y < size; ++y )
+            {
+                for ( int x = 0; x < size; ++x )
+                {
+                    const size_t i = static_cast<size_t>( y ) * size + x;
+                    const float dx = x + 0.5f - size * 0.5f, dy = y + 0.5f - size * 0.5f;
+                    const float inside = std::clamp( ( radius - std::sqrt( dx * dx + dy * dy ) ) * 0.5f, 0.0f, 1.0f );
+                    const uint32_t color = 0x203040u + static_cast<uint32_t>( ( x ^ y ) & 0x3F ) * 0x010203u;
+                    opaque[i] = 0xFF000000u | color;
+                    keyed[i] = inside > 0.0f ? opaque[i] : key;
+                    soft[i] = ( static_cast<uint32_t>( inside * 255.0f + 0.5f ) << 24 ) | color;
+                    translucent[i] = 0x80000000u | color;
+                }
+            }
+            const ImageView image( opaque.data(), size, size, size );
+            const Sprite sprites[] = {
+                Sprite( ImageView( keyed.data(), size, size, size ), key ),
+                Sprite( ImageView( soft.data(), size, size, size ) ),
+                Sprite( ImageView( translucent.data(), size, size, size ) ) };
+
+            BenchParams params;
+            params.primitive = "sprite";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                for ( int variant = 0; variant < 4; ++variant )
+                {
+                    params.variant = variants[variant];
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    // Every sprite is entirely on the surface, the pixels it keeps are the ones it writes
+                    const Sprite* sprite = variant > 0 ? &sprites[variant - 1] : nullptr;
+                    const uint64_t pixels = sprite ? sprite->GetPixelCount() : opaque.size();
+                    suite.Run( params, batch.size(), pixels * batch.size(), [&]
+                    {
+                        // Images hang down from their top left pixel, the top row of the rectangle
+                        for ( const Primitive& primitive : batch )
+                        {
+                            const Vec2<int> topLeft( primitive.v[0].x, primitive.v[1].y - 1 );
+                            if ( sprite )
+                                gfx.DrawSprite( *sprite, topLeft );
+                            else
+                                gfx.DrawImage( image, topLeft );
+                        }
+                        gfx.Flush();
+                    } );
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures labels of the built in font at a scale of a pixel for
+//      every 8 of size, the same string every time so its layout is
+//      reused and a counter that changes with every call so each one
+//      is laid out from cached glyphs
+static void RunText(
+    BenchSuite&                   suite,
+    const Options&                options,
+    const std::vector<Vec2<int>>& resolutions,
+    const std::vector<int>&       sizes )
+{
+    static const char* variants[] = { "label", "counter" };
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        Graphics gfx( resolution.x, resolution.y, nullptr );
+        if ( options.deferred )
+            gfx.EnableDeferred( options.threads );
+
+        for ( int size : sizes )
+        {
+            const int scale = std::clamp( size / 8, 1, TextCache::maxScale );
+            gfx.SetTextScale( scale );
+
+            // Sixteen characters a label, placed like rectangles as wide as the label and as tall as a line and
+            // hanging down from their top left pixel
+            const Vec2<int> extent = gfx.MeasureString( "Score: 00000000" );
+            const std::vector<Primitive> batch = MakeBatch( Shape::RECTANGLE, resolution.x, resolution.y, extent.y, static_cast<float>( extent.x ) / extent.y, 0 );
+            if ( batch.empty() )
+                continue;
+
+            BenchParams params;
+            params.primitive = "text";
+            params.width = resolution.x;
+            params.height = resolution.y;
+            params.size = size;
+
+            for ( Simd::Level level : GetLevels() )
+            {
+                Simd::SetLevel( level );
+                params.simd = Simd::GetName( level );
+
+                for ( int variant = 0; variant < 2; ++variant )
+                {
+                    params.variant = variants[variant];
+                    if ( options.deferred )
+                        params.variant += "-deferred";
+                    if ( !suite.IsSelected( params ) )
+                        continue;
+
+                    // Digits are all equally wide and about equally inked, count one label and scale
+                    SpanFill::Clear( gfx.GetFramebuffer(), 0u );
+                    gfx.DrawString( "Score: 01234567", Vec2<int>( batch[0].v[0].x, batch[0].v[1].y - 1 ), Color( 0xFFFFFF ) );
+                    gfx.Flush();
+                    const uint64_t pixels = CountWritten( gfx.GetFramebuffer() );
+
+                    uint32_t counter = 0u;
+                    char label[32];
+                    suite.Run( params, batch.size(), pixels * batch.size(), [&]
+                    {
+                        for ( const Primitive& primitive : batch )
+                        {
+                            std::snprintf( label, sizeof( label ), "Score: %08u", variant == 0 ? 1234567u : counter++ );
+                            gfx.DrawString( label, Vec2<int>( primitive.v[0].x, primitive.v[1].y - 1 ), Color( 0xFFFFFF ) );
+                        }
+                        gfx.Flush();
+                    } );
+                }
+            }
+        }
+        gfx.SetTextScale( 1 );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures loading square images of every size from files in the
+//      temporary directory, a batch being as many as a game might
+//      load for one level. The file cache is warm after the first
+//      batch, so this is the cost of mapping and converting rather
+//      than of the disk
+static void RunImage(
+    BenchSuite&             suite,
+    const std::vector<int>& sizes )
+{
+    static const char* variants[] = { "bmp-mapped", "bmp-24", "ppm", "qoi" };
+    static const char* extensions[] = { ".bmp", ".bmp", ".ppm", ".qoi" };
+    constexpr int imagesPerBatch = 64;
+
+    for ( int size : sizes )
+    {
+        BenchParams params;
+        params.primitive = "load";
+        params.simd = Simd::GetName( Simd::GetLevel() );
+        params.width = size;
+        params.height = size;
+        params.size = size;
+
+        // Smooth gradients with flat patches and a hard pattern, roughly like painted art
+        std::vector<uint32_t> pixels( static_cast<size_t>( size ) * size );
+        for ( int y = 0; y < size; ++y )
+        {
+            for ( int x = 0; x < size; ++x )
+            {
+                const uint32_t flat = ( ( x / 8 + y / 8 ) % 3 ) == 0 ? 0x404040u : 0u;
+                pixels[static_cast<size_t>( y ) * size + x] = 0xFF000000u | flat | ( ( x * 255 / size ) << 16 ) | ( ( y * 255 / size ) << 8 ) | ( ( x ^ y ) & 0x1F );
+            }
+        }
+        const ImageView image( pixels.data(), size, size, size );
+
+        for ( int variant = 0; variant < 4; ++variant )
+        {
+            params.variant = variants[variant];
+            if ( !suite.IsSelected( params ) )
+                continue;
+
+            // Only the mapped BMP keeps alpha, the others are converted as they load
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / ( "gfx-bench-" + std::to_string( size ) + extensions[variant] );
+            Image::Save( image, path, variant == 0 );
+
+            // Mapped images never touch their pixels while loading, which is the point of mapping them
+            suite.Run( params, imagesPerBatch, pixels.size() * imagesPerBatch, [&]
+            {
+                for ( int i = 0; i < imagesPerBatch; ++i )
+                {
+                    const Image loaded = Image::Load( path );
+                    if ( loaded.GetWidth() != size )
+                        std::abort();
+                }
+            } );
+            std::filesystem::remove( path );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures what capturing adds to each update at every resolution,
+//      a frame being a full surface of noise like a textured scene
+//      with a rectangle moving over it. Frames the writer can't keep
+//      up with are dropped, so this is the cost to the drawing thread
+static void RunCapture(
+    BenchSuite&                   suite,
+    const std::vector<Vec2<int>>& resolutions )
+{
+    static const char* variants[] = { "off", "raw", "qoi", "delta" };
+    static const CaptureFormat formats[] = { CaptureFormat::RAW, CaptureFormat::RAW, CaptureFormat::QOI, CaptureFormat::DELTA };
+
+    for ( const Vec2<int>& resolution : resolutions )
+    {
+        BenchParams params;
+        params.primitive = "capture";
+        params.simd = Simd::GetName( Simd::GetLevel() );
+        params.width = resolution.x;
+        params.height = resolution.y;
+
+        std::mt19937 rng( 7u );
+        std::vector<uint32_t> noise( static_cast<size_t>( resolution.x ) * resolution.y );
+        for ( uint32_t& pixel : noise )
+            pixel = 0xFF000000u | ( rng() & 0xFFFFFFu );
+        const ImageView background( noise.data(), resolution.x, resolution.y, resolution.x );
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "gfx-bench-capture.bin";
+
+        for ( int variant = 0; variant < 4; ++variant )
+        {
+            params.variant = variants[variant];
+            if ( !suite.IsSelected( params ) )
+                continue;
+
+            Graphics gfx( resolution.x, resolution.y, nullptr );
+            if ( variant > 0 )
+                gfx.EnableCapture( path, formats[variant] );
+
+            int frame = 0;
+            const uint64_t pixels = static_cast<uint64_t>( resolution.x ) * resolution.y;
+            suite.Run( params, 1u, pixels, [&]
+            {
+                const int x = ( frame++ * 8 ) % std::max( resolution.x - 64, 1 );
+                gfx.DrawImage( background, Vec2<int>( 0, resolution.y - 1 ) );
+                gfx.DrawRectangle( Vec2<int>( x, 0 ), Vec2<int>( x + 64, 64 ), Color( 0xFFFFFF ) );
+                gfx.Update();
+            } );
+
+            gfx.DisableCapture();
+            std::filesystem::remove( path );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Writes results to a file, reports failure on the console
+static void WriteFile(
+    const std::string& path,
+    const BenchSuite&  suite,
+    void ( BenchSuite::*write )( std::ostream& ) const )
+{
+    std::ofstream file( path );
+    if ( !file )
+    {
+        std::fprintf( stderr, "Could not open %s for writing\n", path.c_str() );
+        return;
+    }
+    ( suite.*write )( file );
+}
+
+//////////////////////////////////////////////////////////////////
+// Runs every sweep headless and writes the requested outputs
+int main(
+    int    argc,
+    char** argv )
+{
+    Options options;
+    if ( !ParseOptions( argc, argv, options ) )
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::vector<Vec2<int>> resolutions = options.quick ?
+        std::vector<Vec2<int>>{ { 1280, 720 } } :
+        std::vector<Vec2<int>>{ { 640, 480 }, { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+    const std::vector<int> sizes = options.quick ? std::vector<int>{ 8, 64 } : std::vector<int>{ 2, 8, 32, 128, 512 };
+
+    std::printf( "Supported SIMD level: %s\n", Simd::GetName( Simd::GetSupportedLevel() ) );
+    const Simd::Level startLevel = Simd::GetLevel();
+
+    BenchSuite suite( options.minSeconds, options.filter );
+    RunClears( suite, resolutions );
+    RunShape( suite, options, Shape::RECTANGLE, resolutions, sizes );
+    RunShape( suite, options, Shape::TRIANGLE, resolutions, sizes );
+    RunShape( suite, options, Shape::LINE, resolutions, sizes );
+    RunMesh( suite, options, resolutions, sizes );
+    RunTransform( suite, options );
+    RunBlend( suite, options, resolutions, sizes );
+    RunDepth( suite, options, resolutions, sizes );
+    RunShading( suite, options, resolutions, sizes );
+    RunTexture( suite, options, resolutions, sizes );
+    RunStroke( suite, options, resolutions, sizes );
+    RunEllipse( suite, options, resolutions, sizes );
+    RunPolygon( suite, options, resolutions, sizes );
+    RunPath( suite, options, resolutions, sizes );
+    RunSprite( suite, options, resolutions, sizes );
+    RunText( suite, options, resolutions, sizes );
+    RunImage( suite, sizes );
+    RunCapture( suite, resolutions );
+    Simd::SetLevel( startLevel );
+
+    if ( !options.csvPath.empty() )
+        WriteFile( options.csvPath, suite, &BenchSuite::WriteCsv );
+    if ( !options.jsonPath.empty() )
+        WriteFile( options.jsonPath, suite, &BenchSuite::WriteJson );
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Ways a color can combine with the pixels beneath it, the
+//      color's alpha scales its contribution in every mode
+enum class BlendMode { SRC_OVER, ADDITIVE, MULTIPLY };
+
+//////////////////////////////////////////////////////////////////
+// @brief A color and blend mode reduced to per channel constants so
+//      every mode is dst = saturate( dst * scale / 255 + offset ),
+//      with the color premultiplied by its alpha into the offset
+struct Paint
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Precomputes the constants of a blend
+    //
+    // @param color: color with straight (not premultiplied) alpha
+    // @param mode: how the color combines with the surface
+    Paint( 
+        uint32_t  color, 
+        BlendMode mode ) noexcept;
+
+public:
+    // Opaque source over writes the color as is and skips blending entirely
+    uint32_t color;
+    bool replace;
+
+    // Fully transparent colors change nothing in any mode
+    bool invisible;
+
+    // Four 16 bit multipliers in the byte order of a pixel, then the pixel added after scaling
+    uint64_t scale;
+    uint32_t offset;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief Vectorized kernels for blending a paint into pixels, 
+//      every instruction set produces identical results
+class Blend
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Blends a paint into a run of pixels, replacing paints 
+    //      fall through to a plain fill
+    //
+    // @param dst: first pixel of the run
+    // @param count: number of pixels in the run
+    // @param paint: what to blend
+    static void Span(
+        uint32_t*    dst,
+        size_t       count,
+        const Paint& paint ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Blends a run of pixels that each have their own color,
+    //      opaque source over pixels are copied and the rest are
+    //      blended one at a time
+    //
+    // @param dst: first pixel of the run
+    // @param colors: color for each pixel with straight alpha
+    // @param count: number of pixels in the run
+    // @param mode: how the colors combine with the surface
+    static void Colors(
+        uint32_t*       dst,
+        const uint32_t* colors,
+        size_t          count,
+        BlendMode       mode ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Blends one color into a run of pixels that each cover a
+    //      fraction of it, the color's alpha is scaled by the coverage.
+    //      Runs of full coverage are blended as spans
+    //
+    // @param dst: first pixel of the run
+    // @param coverage: coverage of each pixel from 0 to 255
+    // @param count: number of pixels in the run
+    // @param color: color with straight alpha
+    // @param mode: how the color combines with the surface
+    static void Coverage(
+        uint32_t*      dst,
+        const uint8_t* coverage,
+        size_t         count,
+        uint32_t       color,
+        BlendMode      mode ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a single pixel with a paint blended into it
+    //
+    // @param dst: pixel beneath the paint
+    // @param paint: what to blend
+    static uint32_t Pixel(
+        uint32_t     dst,
+        const Paint& paint ) noexcept;
+};
\ No newline at end of file
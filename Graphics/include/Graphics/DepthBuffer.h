@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Per pixel depth for a surface along with the nearest and
+//      farthest depth of every 8x8 block and the farthest depth of
+//      every 64x64 tile, smaller depths are nearer. The coarse levels
+//      let triangles behind everything already drawn be rejected 
+//      without testing a single pixel
+class DepthBuffer
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Allocates depth for every pixel of a surface, cleared to
+    //      the far plane
+    //
+    // @param width: width of the surface in pixels
+    // @param height: height of the surface in pixels
+    DepthBuffer(
+        int width,
+        int height );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Sets every depth, including the coarse levels
+    //
+    // @param value: depth to clear to
+    void Clear( float value = farDepth ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Recomputes the nearest and farthest depth of a block 
+    //      after its pixels were written, depths only ever get nearer
+    //      so its tile is only marked stale if the block was farthest
+    //
+    // @param blockX: column of the block
+    // @param blockY: row of the block
+    void UpdateBlock(
+        int blockX,
+        int blockY ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Recomputes the farthest depth of a tile from its blocks
+    //      if any block that was farthest has since moved nearer
+    //
+    // @param tileX: column of the tile
+    // @param tileY: row of the tile
+    void UpdateTile(
+        int tileX,
+        int tileY ) noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of the surface in pixels
+    int GetWidth() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the height of the surface in pixels
+    int GetHeight() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the distance between rows in depths, rows are 
+    //      padded so a whole block can always be loaded
+    int GetPitch() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a pointer to the first depth of a row, does NOT
+    //      check bounds
+    //
+    // @param y: index of the row
+    float* GetRow( int y ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a pointer to the first depth of a row, does NOT
+    //      check bounds
+    //
+    // @param y: index of the row
+    const float* GetRow( int y ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the nearest depth in a block
+    //
+    // @param blockX: column of the block
+    // @param blockY: row of the block
+    float GetBlockMin(
+        int blockX,
+        int blockY ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the farthest depth in a block
+    //
+    // @param blockX: column of the block
+    // @param blockY: row of the block
+    float GetBlockMax(
+        int blockX,
+        int blockY ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the farthest depth in a tile
+    //
+    // @param tileX: column of the tile
+    // @param tileY: row of the tile
+    float GetTileMax(
+        int tileX,
+        int tileY ) const noexcept;
+
+public:
+    // Blocks match the half-space rasterizer's and tiles the deferred renderer's, so a tile 
+    // rendered on its own thread only ever updates its own coarse depths
+    static constexpr int blockSize = 8;
+    static constexpr int tileSize = 64;
+    static constexpr int blocksPerTile = tileSize / blockSize;
+
+    static constexpr float farDepth = 1.0f;
+
+private:
+    int width = 0;
+    int height = 0;
+    int pitch = 0;
+    int blocksX = 0;
+    int blocksY = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+    std::vector<float> depths;
+    std::vector<float> blockMin;
+    std::vector<float> blockMax;
+    std::vector<float> tileMax;
+    std::vector<uint8_t> tileStale;
+};
\ No newline at end of file
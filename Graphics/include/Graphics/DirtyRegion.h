@@ -0,0 +1,80 @@
+#pragma once
+#include "Utility/Rect.h"
+#include <vector>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Tracks which parts of a surface have been written, at the
+//      granularity of square tiles so marking stays cheap no matter
+//      how many draw calls land in the same place
+class DirtyRegion
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a region over an empty surface
+    DirtyRegion() = default;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a clean region covering a surface
+    //
+    // @param width: width of the surface in pixels
+    // @param height: height of the surface in pixels
+    DirtyRegion( 
+        int width, 
+        int height );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Marks every tile a rectangle touches, the rectangle is
+    //      clipped to the surface first
+    //
+    // @param rect: region that was written
+    void Add( const Rect& rect ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Marks the whole surface
+    void AddAll() noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Marks every tile marked in another region over the same
+    //      surface
+    //
+    // @param rhs: region to merge in
+    void Merge( const DirtyRegion& rhs ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Marks every tile as clean
+    void Reset() noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if no tile is marked
+    bool IsEmpty() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the fraction of tiles that are marked
+    float GetCoverage() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Converts the marked tiles into as few rectangles as the
+    //      tile rows allow, clipped to the surface
+    //
+    // @param rects: receives the rectangles, previous contents are 
+    //      discarded
+    void GetRects( std::vector<Rect>& rects ) const;
+
+public:
+    // Matches the deferred renderer's tiles so a dirty tile is exactly one render tile
+    static constexpr int tileSize = 64;
+
+    // Past this much of the surface one full pass is cheaper than many small ones
+    static constexpr float fullCoverage = 0.5f;
+
+private:
+    int width = 0;
+    int height = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+    size_t markedCount = 0u;
+    std::vector<uint8_t> tiles;
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/DrawCommand.h"
+#include "Utility/Rect.h"
+#include <vector>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief A recorded sequence of draw calls that can be replayed 
+//      every frame. A list replayed unchanged is rasterized once 
+//      into runs of constant color and later replays only fill the
+//      runs, any edit throws the runs away
+class DisplayList
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty list
+    DisplayList() = default;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Removes every recorded draw call
+    void Clear() noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a draw call at the end of the list
+    //
+    // @param command: draw call to record
+    void Append( const DrawCommand& command );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills the cached runs into a surface, building them first
+    //      if the list has been replayed unchanged before. Returns
+    //      false if the recorded commands should be run instead
+    //
+    // @param frame: surface to draw to, the runs are only valid for
+    //      surfaces of the size they were built for
+    bool ReplayCached( Framebuffer& frame ) const;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the recorded draw calls in order
+    const std::vector<DrawCommand>& GetCommands() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the union of the bounds of every draw call
+    const Rect& GetBounds() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a counter that changes whenever the list is edited
+    uint64_t GetVersion() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if replays currently fill cached runs
+    bool IsCached() const noexcept;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Rasterizes the list and keeps the pixels it writes as 
+    //      runs of constant color
+    //
+    // @param width: width of the surface the runs are built for
+    // @param height: height of the surface the runs are built for
+    void BuildRuns( 
+        int width, 
+        int height ) const;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Pixels [left, right) of a row written with one color
+    struct Run
+    {
+        int y;
+        int left;
+        int right;
+        uint32_t color;
+    };
+
+    // Runs shorter than this on average cost more to fill than rasterizing does
+    static constexpr size_t minAverageRun = 4u;
+
+private:
+    std::vector<DrawCommand> commands;
+    Rect bounds;
+    uint64_t version = 0u;
+
+    // Replay state, replaying doesn't change what the list draws
+    mutable std::vector<Run> runs;
+    mutable uint64_t runsVersion = ~uint64_t( 0u );
+    mutable bool runsUsable = false;
+    mutable int runsWidth = 0;
+    mutable int runsHeight = 0;
+    mutable uint64_t replayedVersion = ~uint64_t( 0u );
+};
\ No newline at end of file
@@ -0,0 +1,227 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Blend.h"
+#include "Graphics/DepthBuffer.h"
+#include "Graphics/Shading.h"
+#include "Graphics/Texture.h"
+#include "Graphics/Polygon.h"
+#include "Graphics/Sprite.h"
+#include "Graphics/ImageView.h"
+#include "Graphics/TextLayout.h"
+#include "Utility/Vec2.h"
+#include "Utility/Rect.h"
+#include <memory>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief A single recorded draw call that can be replayed into any
+//      region of a surface with identical results
+struct DrawCommand
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Primitives that can be recorded, depth triangles are 
+    //      half-space triangles tested against a depth buffer, 
+    //      shaded triangles interpolate attributes for a span shader,
+    //      textured triangles sample a texture, strokes are wide or
+    //      anti-aliased line segments, ellipses are outlined or 
+    //      filled around their first point with the second as radii,
+    //      polygons and text share their prepared spans and edges 
+    //      between copies and images, sprites and text are drawn with
+    //      their top left pixel at the first point
+    enum class Type { 
+        PIXEL, LINE, STROKE, RECTANGLE, ELLIPSE, ELLIPSE_FILLED, POLYGON, IMAGE, SPRITE, TEXT, TRIANGLE_SCANLINE, 
+        TRIANGLE_HALFSPACE, TRIANGLE_DEPTH, TRIANGLE_SHADED, TRIANGLE_TEXTURED };
+
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a primitive and computes the pixels it may touch
+    //
+    // @param type: primitive to draw
+    // @param v1: first point, in 28.4 fixed point for half-space
+    //      triangles and whole pixels otherwise
+    // @param v2: second point, unused by pixels and the horizontal and
+    //      vertical radius of ellipses
+    // @param v3: third point, only used by triangles
+    // @param color: color to draw with, alpha in the top byte
+    // @param blend: how the color combines with the surface
+    DrawCommand(
+        Type             type,
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        uint32_t         color,
+        BlendMode        blend = BlendMode::SRC_OVER ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a depth tested triangle
+    //
+    // @param v1: first vertex in 28.4 fixed point
+    // @param v2: second vertex in 28.4 fixed point
+    // @param v3: third vertex in 28.4 fixed point
+    // @param z: depth of each vertex, smaller is nearer
+    // @param color: color to draw with, alpha in the top byte
+    // @param blend: how the color combines with the surface
+    DrawCommand(
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const float*     z,
+        uint32_t         color,
+        BlendMode        blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a triangle with interpolated attributes
+    //
+    // @param v1: first vertex in 28.4 fixed point
+    // @param v2: second vertex in 28.4 fixed point
+    // @param v3: third vertex in 28.4 fixed point
+    // @param z: depth of each vertex, null to draw without depth
+    // @param attributes: attributeCount values per vertex, copied
+    // @param attributeCount: values per vertex, at most maxAttributes
+    // @param shader: writes the pixels of each span
+    // @param user: passed through to the shader, must outlive drawing
+    // @param blend: passed through to the shader
+    DrawCommand(
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const float*     z,
+        const float*     attributes,
+        int              attributeCount,
+        SpanShader       shader,
+        const void*      user,
+        BlendMode        blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a textured triangle
+    //
+    // @param v1: first vertex in 28.4 fixed point
+    // @param v2: second vertex in 28.4 fixed point
+    // @param v3: third vertex in 28.4 fixed point
+    // @param uvw: u, v and w of each vertex in turn, copied
+    // @param texture: texture to sample, must outlive drawing
+    // @param filter: how texels are combined
+    // @param blend: how the texels combine with the surface
+    DrawCommand(
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const float*     uvw,
+        const Texture&   texture,
+        TextureFilter    filter,
+        BlendMode        blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records one segment of a wide or anti-aliased line
+    //
+    // @param start: first point in 28.4 fixed point
+    // @param end: last point in 28.4 fixed point
+    // @param previous: point before start in a polyline, or start
+    // @param next: point after end in a polyline, or end
+    // @param width: width of the line in pixels
+    // @param antialias: false to fill only pixels at least half covered
+    // @param color: color to draw with, alpha in the top byte
+    // @param blend: how the color combines with the surface
+    DrawCommand(
+        const Vec2<int>& start,
+        const Vec2<int>& end,
+        const Vec2<int>& previous,
+        const Vec2<int>& next,
+        float            width,
+        bool             antialias,
+        uint32_t         color,
+        BlendMode        blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a filled polygon
+    //
+    // @param polygon: the prepared polygon, shared by every copy of
+    //      the command
+    // @param color: color to draw with, alpha in the top byte
+    // @param blend: how the color combines with the surface
+    DrawCommand(
+        std::shared_ptr<const Polygon> polygon,
+        uint32_t                       color,
+        BlendMode                      blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records an image copied onto the surface as it is
+    //
+    // @param image: pixels to copy, must outlive drawing
+    // @param position: where the top left pixel of the image goes
+    DrawCommand(
+        const ImageView& image,
+        const Vec2<int>& position ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a sprite
+    //
+    // @param sprite: sprite to draw, must outlive drawing
+    // @param position: where the top left pixel of the sprite goes
+    // @param blend: how the sprite combines with the surface
+    DrawCommand(
+        const Sprite&    sprite,
+        const Vec2<int>& position,
+        BlendMode        blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a string of text
+    //
+    // @param text: the laid out string, shared by every copy of the
+    //      command
+    // @param position: where the top left of the text goes
+    // @param color: color to draw with, alpha in the top byte
+    // @param blend: how the color combines with the surface
+    DrawCommand(
+        std::shared_ptr<const TextLayout> text,
+        const Vec2<int>&                  position,
+        uint32_t                          color,
+        BlendMode                         blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws the primitive, only writing inside the clip region
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param depth: depth of the surface for depth triangles, without 
+    //      one they are drawn untested
+    void Execute(
+        Framebuffer& frame,
+        const Rect&  clip,
+        DepthBuffer* depth = nullptr ) const noexcept;
+
+public:
+    Type type;
+    uint32_t color;
+    BlendMode blend;
+    Vec2<int> v[3];
+    float z[3] = { 0.0f, 0.0f, 0.0f };
+    Rect bounds;
+
+    // Shaded triangles only, depth tested when recorded with depths
+    bool hasDepth = false;
+    int attributeCount = 0;
+    float attributes[3 * Shading::maxAttributes] = {};
+    SpanShader shader = nullptr;
+    const void* user = nullptr;
+
+    // Textured triangles only, their u, v and w are kept in the attributes
+    const Texture* texture = nullptr;
+    TextureFilter filter = TextureFilter::NEAREST;
+
+    // Lines and strokes only, the points either side in a polyline, each the line's own end when it has none
+    Vec2<int> joins[2];
+    float width = 1.0f;
+    bool antialias = false;
+
+    // Polygons only, never changed once recorded so tiles can fill it at the same time
+    std::shared_ptr<const Polygon> polygon;
+
+    // Images and sprites only, their pixels belong to the caller
+    ImageView image;
+    const Sprite* sprite = nullptr;
+
+    // Text only, never changed once laid out like polygons
+    std::shared_ptr<const TextLayout> text;
+};
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+#include "Graphics/ImageView.h"
+#include <unordered_map>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief A run of ink on one row of text, from left up to but not
+//      including right
+struct TextSpan
+{
+    int y;
+    int left;
+    int right;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief A character rasterized at one scale, its ink as spans from
+//      the top left of its cell with rows counted down, and how far
+//      it moves the pen
+struct Glyph
+{
+    std::vector<TextSpan> spans;
+    int advance = 0;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief A bitmap font, every character is a cell of pixels that
+//      are either inked or not. Glyphs are scaled up by whole numbers
+//      so they stay sharp, and pairs of characters may be kerned
+class Font
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Reads a font from a sheet of equal cells, left to right
+    //      then top to bottom in character order. Pixels with at least
+    //      half alpha are inked
+    //
+    // @param sheet: the glyphs, copied
+    // @param cellWidth: width of a cell in pixels, the gap to the
+    //      next character included
+    // @param cellHeight: height of a cell in pixels, the gap to the
+    //      next line included
+    // @param firstCharacter: character in the first cell
+    // @param proportional: true to advance each character by its ink
+    //      plus a pixel, false to advance every one by the cell width
+    Font(
+        const ImageView& sheet,
+        int              cellWidth,
+        int              cellHeight,
+        uint32_t         firstCharacter,
+        bool             proportional );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the built in font, printable ASCII in 5 by 8
+    //      glyphs on a 6 by 9 grid
+    static const Font& GetDefault();
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the ink of a character as spans, characters the
+    //      font lacks are drawn as a question mark if it has one
+    //
+    // @param character: the character
+    // @param scale: how many pixels each pixel of the font covers
+    //      across and down
+    Glyph Rasterize(
+        uint32_t character,
+        int      scale ) const;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Sets how much further apart or closer together a pair of
+    //      characters are than their advance, and gives the font a new
+    //      id so text laid out before is laid out again
+    //
+    // @param left: the first character
+    // @param right: the character after it
+    // @param adjust: pixels added to the advance, negative to tighten
+    void SetKerning(
+        uint32_t left,
+        uint32_t right,
+        int      adjust );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the pixels added to the advance between a pair
+    //
+    // @param left: the first character
+    // @param right: the character after it
+    int GetKerning(
+        uint32_t left,
+        uint32_t right ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns how far a character moves the pen in pixels
+    //
+    // @param character: the character
+    int GetAdvance( uint32_t character ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of a cell in pixels
+    int GetCellWidth() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the height of a cell in pixels, the distance
+    //      from one line to the next
+    int GetCellHeight() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a number no other font shares, that changes
+    //      whenever the font does
+    uint64_t GetId() const noexcept;
+
+public:
+    // Drawn in place of characters the font lacks
+    static constexpr uint32_t replacement = '?';
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the cell of a character, or of the replacement
+    //      when the font lacks it, or -1 when it lacks both
+    //
+    // @param character: the character
+    ptrdiff_t FindCell( uint32_t character ) const noexcept;
+
+private:
+    int cellWidth;
+    int cellHeight;
+    uint32_t firstCharacter;
+    size_t cellCount;
+
+    // One byte per pixel of every cell one after another, nonzero where inked
+    std::vector<uint8_t> ink;
+    std::vector<int> advances;
+
+    // Keyed by the left character in the top half and the right one in the bottom
+    std::unordered_map<uint64_t, int> kerning;
+    uint64_t id;
+};
\ No newline at end of file
@@ -0,0 +1,252 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/ImageView.h"
+#include "Utility/GraphicsException.h"
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief How captured frames are stored, raw pixels, each frame a
+//      QOI image, or each frame a QOI image of how it differs from
+//      the frame written before it with a whole frame now and then
+enum class CaptureFormat { RAW, QOI, DELTA };
+
+//////////////////////////////////////////////////////////////////
+// @brief Records frames to a file on a background thread. Each
+//      captured frame is copied into one of a fixed ring of slots
+//      and the writer thread encodes and writes it from there, when
+//      every slot is still waiting to be written the frame is dropped
+//      and counted rather than making the drawing thread wait.
+//      Frames are numbered by capture, so dropped frames show up as
+//      gaps in the numbers. Only one thread may capture
+//
+//      The file is a header of magic, version, width, height and
+//      format as 32 bit numbers, then each frame as its 64 bit number,
+//      32 bit flags and 32 bit size followed by that many bytes, all
+//      little endian. Frames keep the rows of the surface in its own
+//      order, bottom row first
+class FrameRecorder
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Custom capture exceptions naming the file and what went
+    //      wrong with it
+    class Exception : public GraphicsException
+    {
+    public:
+        //////////////////////////////////////////////////////////////////
+        // @brief Constructs a custom FrameRecorder::Exception
+        //
+        // @param line: line where the exception is thrown from
+        // @param file: file where the exception is thrown from
+        // @param path: the capture file
+        // @param reason: what went wrong with it
+        Exception(
+            int                line,
+            const char*        file,
+            const std::string& path,
+            const std::string& reason );
+
+        //////////////////////////////////////////////////////////////////
+        // @brief Human readable error string recovered from exception
+        const char* what() const noexcept override;
+
+
+        //////////////////////////////////////////////////////////////////
+        // @brief Returns Capture Error type of exception
+        virtual const char* GetType() const noexcept override;
+
+        //////////////////////////////////////////////////////////////////
+        // @brief Returns the capture file
+        const std::string& GetPath() const noexcept;
+
+        //////////////////////////////////////////////////////////////////
+        // @brief Returns what went wrong with the capture file
+        const std::string& GetReason() const noexcept;
+
+    private:
+        std::string path;
+        std::string reason;
+    };
+
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Creates the file, allocates every slot and starts the
+    //      writer thread
+    //
+    // @param path: file to write, replaced if it exists
+    // @param width: width of every frame in pixels
+    // @param height: height of every frame in pixels
+    // @param format: how frames are stored
+    // @param slotCount: frames that may wait to be written at once,
+    //      at least 1
+    FrameRecorder(
+        const std::filesystem::path& path,
+        int                          width,
+        int                          height,
+        CaptureFormat                format,
+        unsigned                     slotCount = defaultSlotCount );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copy constructor is deleted, owns its thread
+    FrameRecorder( const FrameRecorder& ) = delete;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes every captured frame and stops the writer thread
+    ~FrameRecorder();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Assignment operator is deleted, owns its thread
+    FrameRecorder& operator=( const FrameRecorder& ) = delete;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copies a frame into a free slot to be written, never
+    //      waits for the writer. Returns false if the frame is dropped
+    //      because no slot is free
+    //
+    // @param frame: finished frame, the size the recorder was made for
+    bool Capture( const Framebuffer& frame );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Blocks until every captured frame has been written
+    void Wait();
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of frames passed to Capture, dropped
+    //      ones included
+    uint64_t GetCapturedCount() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of frames dropped for want of a slot
+    uint64_t GetDroppedCount() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of frames written to the file
+    uint64_t GetWrittenCount() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the size of the file so far in bytes
+    uint64_t GetBytesWritten() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if writing failed, frames captured after
+    //      that are dropped
+    bool HasFailed() const noexcept;
+
+public:
+    static constexpr unsigned defaultSlotCount = 4u;
+    static constexpr uint32_t magic = 0x43584647u;
+    static constexpr uint32_t version = 1u;
+    static constexpr uint32_t keyFrameFlag = 1u;
+
+    // Delta captures store a whole frame this often, so a reader can start partway through
+    static constexpr uint64_t keyFrameInterval = 120u;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes captured frames until stopped
+    void WriteLoop();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Encodes a frame and writes it to the file
+    //
+    // @param frame: the frame
+    // @param number: number of the frame counting from the first
+    //      passed to Capture
+    void WriteFrame(
+        const Framebuffer& frame,
+        uint64_t           number );
+
+private:
+    std::string path;
+    std::ofstream file;
+    CaptureFormat format;
+
+    // Slots fill in order from next and are written in order from first
+    std::vector<Framebuffer> slots;
+    std::vector<uint64_t> numbers;
+    size_t first = 0u;
+    size_t filled = 0u;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable frameCaptured;
+    std::condition_variable frameWritten;
+
+    std::atomic<uint64_t> captured = 0u;
+    std::atomic<uint64_t> dropped = 0u;
+    std::atomic<uint64_t> written = 0u;
+    std::atomic<uint64_t> bytesWritten = 0u;
+    std::atomic<bool> failed = false;
+
+    // Only touched by the writer thread
+    std::vector<uint8_t> encoded;
+    std::vector<uint32_t> previous;
+    std::vector<uint32_t> delta;
+    uint64_t sinceKeyFrame = 0u;
+
+    std::thread thread;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief Reads back the frames of a file written by a FrameRecorder
+//      one after another
+class FrameReader
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Opens a capture and reads its header, throws a
+    //      FrameRecorder::Exception if it isn't one
+    //
+    // @param path: the capture file
+    explicit FrameReader( const std::filesystem::path& path );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Reads the next frame, false at the end of the file or if
+    //      the frame is cut short or corrupt
+    bool Next();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the pixels of the frame last read, valid until
+    //      the next is read
+    ImageView GetView() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number the frame last read was captured as
+    uint64_t GetFrameNumber() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of every frame in pixels
+    int GetWidth() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the height of every frame in pixels
+    int GetHeight() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns how the frames are stored
+    CaptureFormat GetFormat() const noexcept;
+
+private:
+    std::ifstream file;
+    int width = 0;
+    int height = 0;
+    CaptureFormat format = CaptureFormat::RAW;
+    uint64_t number = 0u;
+    bool started = false;
+    std::vector<uint8_t> encoded;
+    std::vector<uint32_t> pixels;
+    std::vector<uint32_t> decoded;
+};
+
+// Macro to simplify throwing capture exceptions
+#define CAPTURE_EXCEPT( path, reason ) FrameRecorder::Exception( __LINE__, __FILE__, path, reason )
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief An owned block of 32 bit pixels that all draw calls
+//      target, rows are padded so each one starts on a cache line
+class Framebuffer
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty framebuffer with no pixel memory
+    Framebuffer() noexcept = default;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Allocates aligned pixel memory for the given dimensions
+    //
+    // @param width: width of the surface in pixels
+    // @param height: height of the surface in pixels
+    Framebuffer( 
+        int width, 
+        int height );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Takes ownership of another framebuffer's memory
+    //
+    // @param rhs: framebuffer to move from, left empty
+    Framebuffer( Framebuffer&& rhs ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copy constructor is deleted, use CopyFrom explicitly
+    Framebuffer( const Framebuffer& ) = delete;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Frees the pixel memory
+    ~Framebuffer();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Frees our memory and takes ownership of another's
+    //
+    // @param rhs: framebuffer to move from, left empty
+    Framebuffer& operator=( Framebuffer&& rhs ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Assignment operator is deleted, use CopyFrom explicitly
+    Framebuffer& operator=( const Framebuffer& ) = delete;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copies the contents of another framebuffer, reallocating
+    //      if the dimensions do not match
+    //
+    // @param src: framebuffer to copy pixels from
+    void CopyFrom( const Framebuffer& src );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of the surface in pixels
+    int GetWidth() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the height of the surface in pixels
+    int GetHeight() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the distance between rows in pixels
+    int GetPitch() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the size of the pixel memory in bytes
+    size_t GetSizeInBytes() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a pointer to the first pixel of the surface
+    uint32_t* GetPixels() noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a pointer to the first pixel of the surface
+    const uint32_t* GetPixels() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a pointer to the first pixel of a row, does NOT
+    //      check bounds
+    //
+    // @param y: index of the row
+    uint32_t* GetRow( int y ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a pointer to the first pixel of a row, does NOT
+    //      check bounds
+    //
+    // @param y: index of the row
+    const uint32_t* GetRow( int y ) const noexcept;
+
+public:
+    static constexpr size_t alignment = 64u;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Releases the pixel memory and resets to empty
+    void Release() noexcept;
+
+private:
+    int width = 0;
+    int height = 0;
+    int pitch = 0;
+    uint32_t* pixels = nullptr;
+};
\ No newline at end of file
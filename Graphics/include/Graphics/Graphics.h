@@ -1,21 +1,58 @@
 #pragma once
-#include "Windows/Win.h"
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Presenter.h"
+#include "Graphics/DrawCommand.h"
+#include "Graphics/TileRenderer.h"
+#include "Graphics/DirtyRegion.h"
+#include "Graphics/SwapChain.h"
+#include "Graphics/DisplayList.h"
+#include "Graphics/DepthBuffer.h"
+#include "Graphics/Texture.h"
+#include "Graphics/Polygon.h"
+#include "Graphics/Path.h"
+#include "Graphics/Sprite.h"
+#include "Graphics/ImageView.h"
+#include "Graphics/Font.h"
+#include "Graphics/TextCache.h"
+#include "Graphics/FrameRecorder.h"
 #include "Utility/Vec2.h"
+#include "Utility/Vec2Batch.h"
 #include "Utility/Color.h"
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 //////////////////////////////////////////////////////////////////
-// @brief Graphics pipeline for a given window
+// @brief Graphics pipeline that draws into a framebuffer and hands
+//      finished frames to a presenter
 class Graphics
 {
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Algorithms available for filling triangles
+    enum class TriangleRasterizer { SCANLINE, HALFSPACE };
+
+    //////////////////////////////////////////////////////////////////
+    // @brief How the colors passed to DrawTriangles are indexed, per
+    //      vertex colors are interpolated across each triangle
+    enum class MeshColors { PER_TRIANGLE, PER_VERTEX };
+
 public:
     // TEMPORARY FIX UNTIL GRAPHICS REFACTOR
     Graphics() = default;
 
     //////////////////////////////////////////////////////////////////
-    // @brief Constructs the graphics object and stores necessary data
+    // @brief Constructs the graphics object and allocates its surface
     // 
-    // @param hWindow: a Windows window handle
-    Graphics( const HWND& hWindow );
+    // @param width: width of the surface in pixels
+    // @param height: height of the surface in pixels
+    // @param presenter: destination for finished frames, may be null
+    //      to render without presenting
+    Graphics(
+        int                        width,
+        int                        height,
+        std::unique_ptr<Presenter> presenter );
 
 
     //////////////////////////////////////////////////////////////////
@@ -43,7 +80,169 @@ public:
         const Color&     color );
 
     //////////////////////////////////////////////////////////////////
-    // @brief Draws a line between two points
+    // @brief Draws a triangle with a depth per vertex, when depth is
+    //      enabled only pixels nearer than what was drawn there this 
+    //      frame are filled. Always uses the half-space rasterizer
+    //
+    // @param v1: first vertex of the triangle
+    // @param v2: second vertex of the triangle
+    // @param v3: third vertex of the triangle
+    // @param z1: depth of the first vertex, smaller is nearer
+    // @param z2: depth of the second vertex
+    // @param z3: depth of the third vertex
+    // @param color: constant color of the trangle
+    void DrawTriangle(
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        float            z1,
+        float            z2,
+        float            z3,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a triangle with a color per vertex, blended across
+    //      it with Gouraud shading. Always uses the half-space 
+    //      rasterizer and covers the same pixels as a flat triangle
+    //
+    // @param v1: first vertex of the triangle
+    // @param v2: second vertex of the triangle
+    // @param v3: third vertex of the triangle
+    // @param c1: color at the first vertex
+    // @param c2: color at the second vertex
+    // @param c3: color at the third vertex
+    void DrawTriangle(
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const Color&     c1,
+        const Color&     c2,
+        const Color&     c3 );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a triangle whose pixels are written by a shader 
+    //      from attributes interpolated between its vertices, the 
+    //      shader is called per row with the attributes at the start
+    //      of the span and their step per pixel in 16.16 fixed point
+    //
+    // @param v1: first vertex of the triangle
+    // @param v2: second vertex of the triangle
+    // @param v3: third vertex of the triangle
+    // @param attributes: attributeCount values for each vertex in 
+    //      turn, within +-32767
+    // @param attributeCount: values per vertex, at most 
+    //      Shading::maxAttributes
+    // @param shader: writes the pixels of each span
+    // @param user: passed to the shader, must live until the triangle
+    //      is drawn which is the next flush when deferred
+    void DrawTriangleShaded(
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const float*     attributes,
+        int              attributeCount,
+        SpanShader       shader,
+        const void*      user = nullptr );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a triangle mapped with a texture, coordinates are
+    //      interpolated with perspective correction from each vertex's
+    //      w and a mip level is picked from how fast they change. 
+    //      Always uses the half-space rasterizer
+    //
+    // @param v1: first vertex of the triangle
+    // @param v2: second vertex of the triangle
+    // @param v3: third vertex of the triangle
+    // @param uv1: texture coordinates of the first vertex, 0 to 1 
+    //      across the texture and repeating outside
+    // @param uv2: texture coordinates of the second vertex
+    // @param uv3: texture coordinates of the third vertex
+    // @param texture: texture to sample, must live until the triangle
+    //      is drawn which is the next flush when deferred
+    // @param w1: positive w of the first vertex after projection
+    // @param w2: positive w of the second vertex
+    // @param w3: positive w of the third vertex
+    void DrawTriangleTextured(
+        const Vec2<int>&   v1,
+        const Vec2<int>&   v2,
+        const Vec2<int>&   v3,
+        const Vec2<float>& uv1,
+        const Vec2<float>& uv2,
+        const Vec2<float>& uv3,
+        const Texture&     texture,
+        float              w1 = 1.0f,
+        float              w2 = 1.0f,
+        float              w3 = 1.0f );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a triangle with sub-pixel precise vertices
+    //
+    // @param v1: first vertex of the triangle in 28.4 fixed point
+    // @param v2: second vertex of the triangle in 28.4 fixed point
+    // @param v3: third vertex of the triangle in 28.4 fixed point
+    // @param color: constant color of the trangle
+    void DrawTriangleSubpixel(
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a batch of triangles that share vertices, each 
+    //      vertex is converted once and triangles with no area or no
+    //      pixels on the surface are culled before any setup
+    //
+    // @param vertices: vertex positions in whole pixels
+    // @param vertexCount: number of vertices
+    // @param indices: three vertex indices per triangle, null to take
+    //      the vertices three at a time
+    // @param indexCount: number of indices, ignored without indices
+    // @param colors: one color per triangle or per vertex
+    // @param colorMode: how colors are indexed, per vertex colors are
+    //      always drawn with the half-space rasterizer
+    // @param depths: one depth per vertex to draw depth tested with 
+    //      the half-space rasterizer, null to draw without depth
+    void DrawTriangles(
+        const Vec2<int>* vertices,
+        size_t           vertexCount,
+        const uint32_t*  indices,
+        size_t           indexCount,
+        const Color*     colors,
+        MeshColors       colorMode,
+        const float*     depths = nullptr );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a batch of triangles whose shared vertices are moved
+    //      by a transform first, every vertex in one vectorized pass 
+    //      straight into the rasterizer's coordinates. Half-space 
+    //      triangles keep the vertices to a sixteenth of a pixel and 
+    //      scanline ones round them to whole pixels
+    //
+    // @param vertices: vertex positions before the transform
+    // @param transform: transform from vertex positions to pixels,
+    //      whole numbers of pixels are on pixel corners
+    // @param indices: three vertex indices per triangle, null to take
+    //      the vertices three at a time
+    // @param indexCount: number of indices, ignored without indices
+    // @param colors: one color per triangle or per vertex
+    // @param colorMode: how colors are indexed, per vertex colors are
+    //      always drawn with the half-space rasterizer
+    // @param depths: one depth per vertex to draw depth tested with 
+    //      the half-space rasterizer, null to draw without depth
+    void DrawTriangles(
+        const Vec2Batch&      vertices,
+        const Affine2<float>& transform,
+        const uint32_t*       indices,
+        size_t                indexCount,
+        const Color*          colors,
+        MeshColors            colorMode,
+        const float*          depths = nullptr );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a line between two points with the current line
+    //      width and anti-aliasing, aliased lines one pixel wide are
+    //      walked with Bresenham's and any other line is a stroke with
+    //      round ends through the centers of the two pixels
     //
     // @param pos1: starting point of line
     // @param pos2: end point of line
@@ -53,9 +252,183 @@ public:
         const Vec2<int>& pos2,
         const Color&     color );
 
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws connected lines through a list of points, each
+    //      point is shared by the lines either side of it and drawn 
+    //      once so translucent joints don't darken
+    //
+    // @param points: points in order, repeated points are skipped
+    // @param pointCount: number of points, none draws nothing
+    // @param color: constant color of the lines
+    void DrawPolyline(
+        const Vec2<int>* points,
+        size_t           pointCount,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills the inside of a path with the current fill rule, 
+    //      every contour counts as closed. The path keeps its 
+    //      flattened curves and the polygon made from them, so drawing
+    //      it again unchanged with the same transform skips both
+    //
+    // @param path: path to fill
+    // @param color: constant color of the path
+    // @param transform: transform from path coordinates to pixels
+    void FillPath(
+        const Path&           path,
+        const Color&          color,
+        const Affine2<float>& transform = Affine2<float>() );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws the outline of a path with the current line width
+    //      and anti-aliasing, closed contours join back to their start.
+    //      The flattened curves are reused like FillPath
+    //
+    // @param path: path to draw
+    // @param color: constant color of the outline
+    // @param transform: transform from path coordinates to pixels
+    void StrokePath(
+        const Path&           path,
+        const Color&          color,
+        const Affine2<float>& transform = Affine2<float>() );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws the outline of a circle one pixel wide
+    //
+    // @param center: center of the circle
+    // @param radius: distance from the center to the outline in 
+    //      pixels, nothing is drawn below zero
+    // @param color: constant color of the circle
+    void DrawCircle(
+        const Vec2<int>& center,
+        int              radius,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a filled circle, covering the same pixels as its
+    //      outline and everything inside it
+    //
+    // @param center: center of the circle
+    // @param radius: distance from the center to the edge in pixels, 
+    //      nothing is drawn below zero
+    // @param color: constant color of the circle
+    void FillCircle(
+        const Vec2<int>& center,
+        int              radius,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws the outline of an axis aligned ellipse one pixel 
+    //      wide, walked with the midpoint algorithm and drawn as spans
+    //
+    // @param center: center of the ellipse
+    // @param radiusX: distance from the center to the left and right 
+    //      of the outline in pixels, nothing is drawn below zero
+    // @param radiusY: distance from the center to the top and bottom
+    //      of the outline in pixels, nothing is drawn below zero
+    // @param color: constant color of the ellipse
+    void DrawEllipse(
+        const Vec2<int>& center,
+        int              radiusX,
+        int              radiusY,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a filled axis aligned ellipse with one span per 
+    //      row, covering the same pixels as its outline and everything
+    //      inside it
+    //
+    // @param center: center of the ellipse
+    // @param radiusX: distance from the center to the left and right 
+    //      edges in pixels, nothing is drawn below zero
+    // @param radiusY: distance from the center to the top and bottom
+    //      edges in pixels, nothing is drawn below zero
+    // @param color: constant color of the ellipse
+    void FillEllipse(
+        const Vec2<int>& center,
+        int              radiusX,
+        int              radiusY,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a filled polygon without triangulating it, any 
+    //      shape of outline is filled a row of spans at a time with 
+    //      the current fill rule deciding what is inside
+    //
+    // @param points: corners of the polygon in order, closed from the
+    //      last back to the first
+    // @param pointCount: number of corners
+    // @param color: constant color of the polygon
+    void DrawPolygon(
+        const Vec2<int>* points,
+        size_t           pointCount,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a filled polygon made of several outlines, such as
+    //      a region with holes or a group of islands. Where outlines
+    //      overlap the current fill rule decides what is inside
+    //
+    // @param points: corners of every outline one after another
+    // @param contourSizes: number of corners in each outline, each is
+    //      closed from its last corner back to its first
+    // @param contourCount: number of outlines
+    // @param color: constant color of the polygon
+    void DrawPolygon(
+        const Vec2<int>* points,
+        const size_t*    contourSizes,
+        size_t           contourCount,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copies an image onto the surface a row at a time, every
+    //      pixel replaces the one beneath it whatever its alpha and the
+    //      blend mode. Draw a sprite for transparent pixels
+    //
+    // @param image: pixels to copy, must live until the image is drawn
+    //      which is the next flush when deferred
+    // @param position: where the top left pixel of the image goes, the
+    //      rest is to the right of and below it
+    void DrawImage(
+        const ImageView& image,
+        const Vec2<int>& position );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a sprite with the current blend mode, its fully
+    //      transparent pixels are skipped without being read
+    //
+    // @param sprite: sprite to draw, must live until it is drawn which
+    //      is the next flush when deferred
+    // @param position: where the top left pixel of the sprite goes, the
+    //      rest is to the right of and below it
+    void DrawSprite(
+        const Sprite&    sprite,
+        const Vec2<int>& position );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a string with the current font and text scale, 
+    //      newlines start a new line below the first. Strings drawn 
+    //      before are found already laid out and are drawn as they were
+    //
+    // @param text: the string in UTF-8
+    // @param position: where the top left pixel of the first line
+    //      goes, the text is to the right of and below it
+    // @param color: constant color of the text
+    void DrawString(
+        std::string_view text,
+        const Vec2<int>& position,
+        const Color&     color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of the longest line of a string and the
+    //      height of all its lines in the current font and text scale
+    //
+    // @param text: the string in UTF-8
+    Vec2<int> MeasureString( std::string_view text );
+
     //////////////////////////////////////////////////////////////////
     // @brief Changes the color of a single pixel, does NOT check
-    // bounds
+    // bounds unless deferred
     // 
     // @param pos: location of the pixel
     // @param color: desired color of the pixel
@@ -65,21 +438,339 @@ public:
 
 
     //////////////////////////////////////////////////////////////////
-    // @brief Displays the current frame to the screen and resets
+    // @brief Clears a display list and records every following draw
+    //      call into it instead of drawing, until EndDisplayList
+    //
+    // @param list: list to record into, must outlive the recording
+    void BeginDisplayList( DisplayList& list );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Stops recording and returns to drawing
+    void EndDisplayList() noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws every call recorded in a display list, unchanged 
+    //      lists are filled from cached runs when drawing immediately
+    //
+    // @param list: list to draw
+    void DrawDisplayList( const DisplayList& list );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Displays the current frame to the screen and resets, 
+    //      only the regions drawn this frame or the last one are 
+    //      presented and only the regions drawn this frame are cleared
     void Update();
 
+    //////////////////////////////////////////////////////////////////
+    // @brief Presents the whole frame on the next update, for when the
+    //      destination lost what was presented before
+    void Invalidate() noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Rasterizes every deferred draw call into the framebuffer,
+    //      does nothing when drawing immediately
+    void Flush();
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records draw calls instead of drawing them, they are 
+    //      binned into tiles and rasterized in parallel on Flush or 
+    //      Update with output identical to immediate drawing
+    //
+    // @param threadCount: threads rasterizing tiles including the
+    //      caller, 0 picks one per hardware thread
+    void EnableDeferred( unsigned threadCount = 0u );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Flushes any recorded draw calls and returns to drawing
+    //      immediately on the calling thread
+    void DisableDeferred();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if draw calls are currently being recorded
+    bool DeferredIsEnabled() const noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Presents and clears frames on a dedicated thread so the
+    //      next frame can be drawn while the last one is presented,
+    //      Update only blocks when every spare buffer is in flight
+    //
+    // @param bufferCount: total framebuffers, 2 for double buffering
+    //      or 3 for triple buffering
+    void EnableSwapChain( unsigned bufferCount = 3u );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Waits for queued frames and returns to presenting on the
+    //      calling thread
+    void DisableSwapChain();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if frames are presented on their own thread
+    bool SwapChainIsEnabled() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Blocks until every frame passed to Update has been 
+    //      presented, returns immediately without a swap chain
+    void WaitForPresent();
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records every frame passed to Update to a file from now
+    //      on, frames are copied aside and written on a background 
+    //      thread, and dropped rather than waited for when the writer
+    //      falls behind
+    //
+    // @param path: file to write, replaced if it exists
+    // @param format: how frames are stored
+    // @param slotCount: frames that may wait to be written at once
+    void EnableCapture(
+        const std::filesystem::path& path,
+        CaptureFormat                format = CaptureFormat::DELTA,
+        unsigned                     slotCount = FrameRecorder::defaultSlotCount );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes every frame still waiting and closes the capture
+    void DisableCapture();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the recorder frames are captured with, null when
+    //      not capturing
+    const FrameRecorder* GetCapture() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Allocates a depth buffer that triangles drawn with depth
+    //      are tested against, it is cleared to the far plane on every
+    //      update and keeps coarse depths so occluded tiles, blocks and
+    //      triangles are rejected before any per pixel work
+    void EnableDepth();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Frees the depth buffer, triangles with depth are then
+    //      drawn untested in submission order
+    void DisableDepth();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if triangles with depth are depth tested
+    bool DepthIsEnabled() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the depth buffer, null when depth is disabled
+    const DepthBuffer* GetDepthBuffer() const noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects the algorithm used by DrawTriangle
+    //
+    // @param rasterizer: desired triangle rasterizer
+    void SetTriangleRasterizer( TriangleRasterizer rasterizer ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the algorithm used by DrawTriangle
+    TriangleRasterizer GetTriangleRasterizer() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects how following draw calls combine with the 
+    //      surface, a color's alpha scales its effect in every mode
+    //      and opaque source over simply overwrites
+    //
+    // @param mode: desired blend mode
+    void SetBlendMode( BlendMode mode ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns how draw calls combine with the surface
+    BlendMode GetBlendMode() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects the width of following lines
+    //
+    // @param width: width in pixels, widths below one draw as one
+    void SetLineWidth( float width ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of lines in pixels
+    float GetLineWidth() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects whether following lines blend their edges by how
+    //      much of each pixel they cover
+    //
+    // @param antialias: true to smooth the edges of lines
+    void SetLineAntialiasing( bool antialias ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if lines are anti-aliased
+    bool GetLineAntialiasing() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects which parts of following polygons are filled
+    //
+    // @param rule: desired fill rule
+    void SetFillRule( FillRule rule ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns which parts of polygons are filled
+    FillRule GetFillRule() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects how closely following paths follow their curves
+    //
+    // @param tolerance: furthest in pixels a flattened curve may stray
+    //      from the true curve, at least a sixteenth of a pixel
+    void SetCurveTolerance( float tolerance ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns how far in pixels flattened curves may stray
+    float GetCurveTolerance() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects the font of following strings
+    //
+    // @param font: font to draw with, must live until another font is
+    //      selected
+    void SetFont( const Font& font ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the font strings are drawn with
+    const Font& GetFont() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects how large following strings are drawn
+    //
+    // @param scale: pixels across and down each pixel of the font 
+    //      covers, from 1 to TextCache::maxScale
+    void SetTextScale( int scale ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns how many pixels each pixel of the font covers
+    int GetTextScale() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Selects how following textured triangles combine texels
+    //
+    // @param filter: desired texture filter
+    void SetTextureFilter( TextureFilter filter ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns how textured triangles combine texels
+    TextureFilter GetTextureFilter() const noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the surface that all draw calls target, writes
+    //      through it can't be tracked so the whole surface is 
+    //      presented and cleared on the next update
+    Framebuffer& GetFramebuffer() noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the surface that all draw calls target
+    const Framebuffer& GetFramebuffer() const noexcept;
+
 private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Submits the lines of a polyline whose points are already
+    //      in the coordinates of its commands and have no repeats
+    //
+    // @param points: points in order, 28.4 fixed point for strokes 
+    //      and whole pixels for lines
+    // @param pointCount: number of points, fewer than two draw nothing
+    // @param closed: true to join the last point back to the first,
+    //      needs at least three points
+    // @param stroke: true to draw strokes, false for Bresenham lines
+    // @param color: constant color of the lines
+    void SubmitPolyline(
+        const Vec2<int>* points,
+        size_t           pointCount,
+        bool             closed,
+        bool             stroke,
+        const Color&     color );
+
     //////////////////////////////////////////////////////////////////
     // @brief Clears the entire screen with a single color
     //
     // @param color: color to clear the screen with
     void ClearScreen( const Color& color );
 
+    //////////////////////////////////////////////////////////////////
+    // @brief Clears the tiles of a region with a single color
+    //
+    // @param region: tiles to clear
+    // @param color: color to clear the tiles with
+    void ClearRegion(
+        const DirtyRegion& region,
+        const Color&       color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the command a mesh's triangles are drawn with
+    //
+    // @param colorMode: how the mesh's colors are indexed
+    // @param depths: depths of the mesh's vertices, may be null
+    DrawCommand::Type GetMeshType(
+        MeshColors   colorMode,
+        const float* depths ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Culls the triangles of a mesh whose vertices are in 
+    //      meshVertices and submits the rest
+    //
+    // @param indices: three vertex indices per triangle, null to take
+    //      the vertices three at a time
+    // @param indexCount: number of indices, ignored without indices
+    // @param colors: one color per triangle or per vertex
+    // @param colorMode: how colors are indexed
+    // @param depths: one depth per vertex, may be null
+    // @param type: command to draw every triangle with
+    // @param shift: fraction bits of the converted vertices
+    void SubmitMesh(
+        const uint32_t*   indices,
+        size_t            indexCount,
+        const Color*      colors,
+        MeshColors        colorMode,
+        const float*      depths,
+        DrawCommand::Type type,
+        int               shift );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a command now or records it if deferred
+    //
+    // @param command: the draw call to run
+    void Submit( const DrawCommand& command );
+
 private:
-    HDC hdc;
-    int clientWidth;
-    int clientHeight;
-    void* memory;
-    BITMAPINFO bitmap;
+    Framebuffer framebuffer;
+    std::unique_ptr<Presenter> presenter;
+    std::unique_ptr<TileRenderer> tiles;
+    std::unique_ptr<SwapChain> swapChain;
+    std::unique_ptr<DepthBuffer> depthBuffer;
+    std::unique_ptr<FrameRecorder> recorder;
+    DisplayList* recording = nullptr;
+    TriangleRasterizer triangleRasterizer = TriangleRasterizer::HALFSPACE;
+    BlendMode blendMode = BlendMode::SRC_OVER;
+    TextureFilter textureFilter = TextureFilter::BILINEAR;
+    FillRule fillRule = FillRule::NON_ZERO;
+    float lineWidth = 1.0f;
+    float curveTolerance = 0.25f;
+    const Font* font = &Font::GetDefault();
+    int textScale = 1;
+    bool lineAntialiasing = false;
     Color defaultColor = Color( 0x333333 );
+
+    // Tiles drawn since the last update, and tiles drawn the frame before that are still on screen
+    DirtyRegion drawn;
+    DirtyRegion shown;
+    std::vector<Rect> dirtyRects;
+
+    // Vertices of the last batch converted to the rasterizer's coordinates
+    std::vector<Vec2<int>> meshVertices;
+
+    // Points of the last polyline or path contour converted to the rasterizer's coordinates without repeats
+    std::vector<Vec2<int>> polylinePoints;
+
+    // Corners of the last polygon converted to the rasterizer's coordinates
+    std::vector<Vec2<int>> polygonPoints;
+
+    // Glyphs and strings drawn recently, ready to draw again
+    TextCache textCache;
+    bool presentAll = true;
 };
\ No newline at end of file
@@ -0,0 +1,195 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Blend.h"
+#include "Graphics/DepthBuffer.h"
+#include "Graphics/Shading.h"
+#include "Graphics/Texture.h"
+#include "Utility/Vec2.h"
+#include "Utility/Rect.h"
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Triangle rasterizer that evaluates the three edge 
+//      functions over 8x8 blocks, whole blocks are accepted or 
+//      rejected and only partially covered blocks test each pixel,
+//      vertices are 28.4 fixed point and ties follow the top-left rule,
+//      triangles reaching past the guard band are clipped against it
+class HalfSpace
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills every pixel whose center lies inside a triangle,
+    //      centers exactly on an edge are only filled for top or left
+    //      edges so meshes write each pixel once
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param v1: first vertex of the triangle in 28.4 fixed point
+    // @param v2: second vertex of the triangle in 28.4 fixed point
+    // @param v3: third vertex of the triangle in 28.4 fixed point
+    // @param paint: color and blend mode to draw with
+    static void FillTriangle(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const Paint&     paint ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills the pixels of a triangle that are nearer than the
+    //      depth already stored there and stores their depth, blocks
+    //      and tiles entirely behind what was drawn are skipped whole
+    //
+    // @param frame: surface to draw to
+    // @param depth: depth of the surface, the same size as it
+    // @param clip: region of the surface that may be written
+    // @param v1: first vertex of the triangle in 28.4 fixed point
+    // @param v2: second vertex of the triangle in 28.4 fixed point
+    // @param v3: third vertex of the triangle in 28.4 fixed point
+    // @param z: depth of each vertex, interpolated linearly
+    // @param paint: color and blend mode to draw with
+    static void FillTriangle(
+        Framebuffer&     frame,
+        DepthBuffer&     depth,
+        const Rect&      clip,
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const float*     z,
+        const Paint&     paint ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills a triangle with attributes interpolated from its
+    //      vertices, the gradients are solved once and each row's 
+    //      covered span is handed to a shader with the attributes at
+    //      its first pixel. Covers exactly the pixels FillTriangle does
+    //
+    // @param frame: surface to draw to
+    // @param depth: depth of the surface, null to draw without it
+    // @param clip: region of the surface that may be written
+    // @param v1: first vertex of the triangle in 28.4 fixed point
+    // @param v2: second vertex of the triangle in 28.4 fixed point
+    // @param v3: third vertex of the triangle in 28.4 fixed point
+    // @param z: depth of each vertex, null to draw without depth
+    // @param attributes: attributeCount values for the first vertex, 
+    //      then the second, then the third, within +-32767
+    // @param attributeCount: values per vertex, at most maxAttributes
+    // @param shader: writes the pixels of each span
+    // @param user: passed through to the shader
+    // @param blend: passed through to the shader in each span
+    static void ShadeTriangle(
+        Framebuffer&     frame,
+        DepthBuffer*     depth,
+        const Rect&      clip,
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const float*     z,
+        const float*     attributes,
+        int              attributeCount,
+        SpanShader       shader,
+        const void*      user,
+        BlendMode        blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills a triangle from a texture with perspective correct
+    //      coordinates, covering exactly the pixels FillTriangle does
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param v1: first vertex of the triangle in 28.4 fixed point
+    // @param v2: second vertex of the triangle in 28.4 fixed point
+    // @param v3: third vertex of the triangle in 28.4 fixed point
+    // @param uvw: texture coordinates u and v then the positive w of
+    //      each vertex in turn, equal w maps the texture affinely
+    // @param texture: texture to sample
+    // @param filter: how texels are combined
+    // @param blend: how the texels combine with the surface
+    static void TextureTriangle(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const float*     uvw,
+        const Texture&   texture,
+        TextureFilter    filter,
+        BlendMode        blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Converts a pixel coordinate to 28.4 fixed point
+    //
+    // @param value: coordinate in pixels, may be fractional
+    static int ToSubpixel( float value ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Converts a whole pixel position to 28.4 fixed point, 
+    //      coordinates past +-maxSubpixel are clamped to it
+    //
+    // @param pixel: position in whole pixels
+    static Vec2<int> ToSubpixel( const Vec2<int>& pixel ) noexcept;
+
+public:
+    static constexpr int blockSize = 8;
+    static constexpr int subpixelBits = 4;
+    static constexpr int subpixelScale = 1 << subpixelBits;
+
+    // Largest 28.4 coordinate the conversions produce, the limit Polygon and Vec2Batch clamp to
+    static constexpr int maxSubpixel = 1 << 26;
+
+    // Vertices within this many pixels of the origin are rasterized without geometric clipping,
+    // far enough out that clipped edges never reach a real surface
+    static constexpr int guardBand = 1 << 14;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Rejects triangles outside the clip region and clips the
+    //      rest against the guard band before rasterizing them
+    //
+    // @param frame: surface to draw to
+    // @param depth: depth of the surface, null to draw without it
+    // @param clip: region of the surface that may be written
+    // @param v1: first vertex of the triangle in 28.4 fixed point
+    // @param v2: second vertex of the triangle in 28.4 fixed point
+    // @param v3: third vertex of the triangle in 28.4 fixed point
+    // @param plane: depth at the center of pixel (0, 0) followed by 
+    //      its change per pixel in x and in y, unused without depth
+    // @param shade: attribute planes and shader, null to fill with 
+    //      the paint
+    // @param paint: color and blend mode to draw with, unused when 
+    //      shading
+    static void Draw(
+        Framebuffer&     frame,
+        DepthBuffer*     depth,
+        const Rect&      clip,
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const float*     plane,
+        const Gradients* shade,
+        const Paint&     paint ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Rasterizes a triangle known to lie inside the guard band
+    //
+    // @param frame: surface to draw to
+    // @param depth: depth of the surface, null to draw without it
+    // @param clip: region of the surface that may be written
+    // @param x: x coordinates of the vertices in 28.4 fixed point
+    // @param y: y coordinates of the vertices in 28.4 fixed point
+    // @param plane: depth plane of the triangle, unused without depth
+    // @param shade: attribute planes and shader, null to fill with 
+    //      the paint
+    // @param paint: color and blend mode to draw with, unused when 
+    //      shading
+    static void Rasterize(
+        Framebuffer&     frame,
+        DepthBuffer*     depth,
+        const Rect&      clip,
+        const int64_t*   x,
+        const int64_t*   y,
+        const float*     plane,
+        const Gradients* shade,
+        const Paint&     paint ) noexcept;
+};
\ No newline at end of file
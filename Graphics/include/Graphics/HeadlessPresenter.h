@@ -0,0 +1,54 @@
+#pragma once
+#include "Graphics/Presenter.h"
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Presenter that keeps frames in memory instead of showing
+//      them, used for offscreen rendering and measurement
+class HeadlessPresenter : public Presenter
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a headless presenter
+    //
+    // @param keepFrames: if presented frames should be copied so
+    //      they can be read back, otherwise frames are only counted
+    HeadlessPresenter( bool keepFrames = true ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copies the frame into memory if enabled and counts it
+    //
+    // @param frame: finished frame to store
+    void Present( const Framebuffer& frame ) override;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copies only the changed regions into memory if enabled
+    //      and counts the frame
+    //
+    // @param frame: finished frame to store
+    // @param rects: regions of the frame that changed
+    void PresentRegion( 
+        const Framebuffer&       frame, 
+        const std::vector<Rect>& rects ) override;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the most recently presented frame, empty if no
+    //      frame has been presented or frames are not kept
+    const Framebuffer& GetLastFrame() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of frames presented so far
+    uint64_t GetFrameCount() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of pixels presented so far, counting
+    //      only the changed regions of partial presents
+    uint64_t GetPixelCount() const noexcept;
+
+private:
+    bool keepFrames;
+    uint64_t frameCount = 0u;
+    uint64_t pixelCount = 0u;
+    Framebuffer lastFrame;
+};
\ No newline at end of file
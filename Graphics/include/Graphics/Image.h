@@ -0,0 +1,183 @@
+#pragma once
+#include "Graphics/ImageView.h"
+#include "Utility/GraphicsException.h"
+#include "Utility/MappedFile.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief An image loaded from a BMP, PPM or QOI file. The file is
+//      mapped rather than read, and a 32 bit BMP already laid out
+//      like a framebuffer with its pixels starting on a 4 byte
+//      boundary is used where it lies in the mapping with no copy at
+//      all, anything else is converted in one pass from the mapping.
+//      Its view can be blitted, made into a sprite or a texture, and
+//      loading is safe from several threads at once
+class Image
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Custom image exceptions naming the file and what is
+    //      wrong with it
+    class Exception : public GraphicsException
+    {
+    public:
+        //////////////////////////////////////////////////////////////////
+        // @brief Constructs a custom Image::Exception
+        //
+        // @param line: line where the exception is thrown from
+        // @param file: file where the exception is thrown from
+        // @param path: the image that failed to load
+        // @param reason: what is wrong with it
+        Exception(
+            int                line,
+            const char*        file,
+            const std::string& path,
+            const std::string& reason );
+
+        //////////////////////////////////////////////////////////////////
+        // @brief Human readable error string recovered from exception
+        const char* what() const noexcept override;
+
+
+        //////////////////////////////////////////////////////////////////
+        // @brief Returns Image Error type of exception
+        virtual const char* GetType() const noexcept override;
+
+        //////////////////////////////////////////////////////////////////
+        // @brief Returns the image that failed to load
+        const std::string& GetPath() const noexcept;
+
+        //////////////////////////////////////////////////////////////////
+        // @brief Returns what is wrong with the image
+        const std::string& GetReason() const noexcept;
+
+    private:
+        std::string path;
+        std::string reason;
+    };
+
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty image
+    Image() = default;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Takes the pixels of another image, leaving it empty
+    //
+    // @param other: image to take from
+    Image( Image&& other ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Takes the pixels of another image, leaving it empty
+    //
+    // @param other: image to take from
+    Image& operator=( Image&& other ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Loads an image, the format is told by its first bytes
+    //
+    // @param path: a BMP, PPM or QOI file
+    static Image Load( const std::filesystem::path& path );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Decodes an image already in memory into pixels of its own,
+    //      the format is told by its first bytes
+    //
+    // @param data: a BMP, PPM or QOI file
+    // @param size: size of the data in bytes
+    static Image Decode(
+        const uint8_t* data,
+        size_t         size );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes an image to a file in the format of its extension,
+    //      .bmp as 32 bit BGRA laid out so it loads in place, .qoi
+    //      with alpha, or .ppm without it
+    //
+    // @param image: pixels to write
+    // @param path: file to write, replaced if it exists
+    // @param alpha: false to drop alpha, writing .bmp as 24 bit BGR
+    //      and .qoi with three channels
+    static void Save(
+        const ImageView&             image,
+        const std::filesystem::path& path,
+        bool                         alpha = true );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the pixels, valid for as long as the image is
+    const ImageView& GetView() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of the image in pixels
+    int GetWidth() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the height of the image in pixels
+    int GetHeight() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if the pixels are read in place from the
+    //      mapped file rather than a copy
+    bool IsMapped() const noexcept;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Reads an image in any supported format, null on success
+    //      or else what is wrong with it
+    //
+    // @param data: the file
+    // @param size: size of the file in bytes
+    // @param inPlace: true if the data outlives the image so pixels
+    //      may be left where they are
+    const char* Read(
+        const uint8_t* data,
+        size_t         size,
+        bool           inPlace );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Reads an uncompressed 24 or 32 bit BMP, null on success
+    //      or else what is wrong with it
+    //
+    // @param data: the file
+    // @param size: size of the file in bytes
+    // @param inPlace: true if the data outlives the image
+    const char* ReadBmp(
+        const uint8_t* data,
+        size_t         size,
+        bool           inPlace );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Reads a binary PPM or PGM, null on success or else what
+    //      is wrong with it
+    //
+    // @param data: the file
+    // @param size: size of the file in bytes
+    const char* ReadPpm(
+        const uint8_t* data,
+        size_t         size );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Reads a QOI image, null on success or else what is wrong
+    //      with it
+    //
+    // @param data: the file
+    // @param size: size of the file in bytes
+    const char* ReadQoi(
+        const uint8_t* data,
+        size_t         size );
+
+private:
+    // Only held while the view points into it
+    std::unique_ptr<MappedFile> file;
+    std::vector<uint32_t> pixels;
+    ImageView view;
+};
+
+// Macro to simplify throwing image exceptions
+#define IMG_EXCEPT( path, reason ) Image::Exception( __LINE__, __FILE__, path, reason )
\ No newline at end of file
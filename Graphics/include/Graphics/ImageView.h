@@ -0,0 +1,82 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Utility/Rect.h"
+#include "Utility/Vec2.h"
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief A window onto 32 bit pixels owned by someone else, row 0 is
+//      the top of the image. Rows are pitch pixels apart so a negative
+//      pitch reads an image stored bottom row first from the top down.
+//      Drawn onto the y-up surface the rows go down from the top left
+//      pixel, row r landing r rows below it
+struct ImageView
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty view
+    ImageView() = default;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a view of pixels in memory
+    //
+    // @param pixels: first pixel of the top row
+    // @param width: width of the image in pixels
+    // @param height: height of the image in pixels
+    // @param pitch: distance from one row to the next in pixels,
+    //      negative when rows are stored bottom up
+    ImageView( const uint32_t* pixels, int width, int height, ptrdiff_t pitch ) : pixels( pixels ), width( width ), height( height ), pitch( pitch ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a view of a whole framebuffer as it appears,
+    //      starting from its top row
+    //
+    // @param frame: framebuffer to view, must outlive the view
+    ImageView( const Framebuffer& frame ) : 
+        ImageView( frame.GetHeight() > 0 ? frame.GetRow( frame.GetHeight() - 1 ) : nullptr, frame.GetWidth(), frame.GetHeight(), -ptrdiff_t( frame.GetPitch() ) ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a pointer to the first pixel of a row, does NOT
+    //      check bounds
+    //
+    // @param y: index of the row, 0 is the top
+    const uint32_t* GetRow( int y ) const { return pixels + y * pitch; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a view of part of the image such as one frame of
+    //      a sprite sheet, clipped to the image
+    //
+    // @param rect: the part to view in pixels of this image
+    ImageView Crop( const Rect& rect ) const
+    {
+        const Rect inside = rect.Intersect( Rect( 0, 0, width, height ) );
+        if ( inside.IsEmpty() )
+            return ImageView();
+        return ImageView( GetRow( inside.bottom ) + inside.left, inside.right - inside.left, inside.top - inside.bottom, pitch );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the pixels of the surface an image covers when
+    //      its top left pixel is at a position, kept within int
+    //
+    // @param position: where the top left pixel goes
+    // @param width: width of the image in pixels
+    // @param height: height of the image in pixels
+    static Rect GetArea( const Vec2<int>& position, int width, int height )
+    {
+        auto limit = []( int64_t value ) { return static_cast<int>( std::clamp<int64_t>( value, INT32_MIN, INT32_MAX ) ); };
+        return Rect( position.x, limit( int64_t( position.y ) - height + 1 ), limit( int64_t( position.x ) + width ), limit( int64_t( position.y ) + 1 ) );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if the view has no pixels
+    bool IsEmpty() const { return !pixels || width <= 0 || height <= 0; }
+
+public:
+    const uint32_t* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    ptrdiff_t pitch = 0;
+};
\ No newline at end of file
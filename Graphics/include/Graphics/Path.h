@@ -0,0 +1,149 @@
+#pragma once
+#include "Graphics/Polygon.h"
+#include "Utility/Vec2.h"
+#include "Utility/Affine2.h"
+#include <memory>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief A shape made of straight lines and quadratic and cubic
+//      Bezier curves, in one or more contours. Curves are flattened
+//      to lines by splitting them until every piece is within a pixel
+//      tolerance of the curve, so flat stretches take few lines and
+//      tight bends many. The flattened lines and the polygon filled
+//      from them are kept and reused until the path, its transform or
+//      the tolerance changes
+class Path
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Lines of a flattened path in 28.4 fixed point pixels,
+    //      contour c has contourSizes[c] points and is closed back to
+    //      its first point when closed[c] is set
+    struct Flattened
+    {
+        std::vector<Vec2<int>> points;
+        std::vector<size_t> contourSizes;
+        std::vector<bool> closed;
+    };
+
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty path
+    Path() = default;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Starts a new contour
+    //
+    // @param point: first point of the contour
+    void MoveTo( const Vec2<float>& point );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Adds a straight line from the current point
+    //
+    // @param point: end of the line
+    void LineTo( const Vec2<float>& point );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Adds a quadratic Bezier curve from the current point
+    //
+    // @param control: control point the curve bends towards
+    // @param point: end of the curve
+    void QuadTo(
+        const Vec2<float>& control,
+        const Vec2<float>& point );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Adds a cubic Bezier curve from the current point
+    //
+    // @param control1: control point the curve leaves towards
+    // @param control2: control point the curve arrives from
+    // @param point: end of the curve
+    void CubicTo(
+        const Vec2<float>& control1,
+        const Vec2<float>& control2,
+        const Vec2<float>& point );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Closes the current contour with a line back to its first
+    //      point, a following line or curve starts from there
+    void Close();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Removes every contour
+    void Clear() noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the path flattened to lines, reusing the last
+    //      result when nothing has changed since
+    //
+    // @param transform: transform from path coordinates to pixels,
+    //      whole numbers of pixels are on pixel corners
+    // @param tolerance: furthest in pixels a line may stray from the
+    //      curve it replaces
+    const Flattened& Flatten(
+        const Affine2<float>& transform,
+        float                 tolerance ) const;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the flattened path prepared for filling, every
+    //      contour is closed. Reused when nothing has changed since
+    //
+    // @param transform: transform from path coordinates to pixels,
+    //      whole numbers of pixels are on pixel corners
+    // @param tolerance: furthest in pixels a line may stray from the
+    //      curve it replaces
+    // @param rule: which parts of the path are filled
+    std::shared_ptr<const Polygon> GetPolygon(
+        const Affine2<float>& transform,
+        float                 tolerance,
+        FillRule              rule ) const;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if the path has nothing to draw
+    bool IsEmpty() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a counter that changes whenever the path is
+    //      edited
+    uint64_t GetVersion() const noexcept;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Commands making up the path, each takes the next 0 to 3
+    //      points
+    enum class Verb : uint8_t { MOVE, LINE, QUAD, CUBIC, CLOSE };
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a verb and its points
+    //
+    // @param verb: the command
+    // @param added: its points
+    // @param count: number of points
+    void Add(
+        Verb               verb,
+        const Vec2<float>* added,
+        size_t             count );
+
+private:
+    std::vector<Verb> verbs;
+    std::vector<Vec2<float>> points;
+    uint64_t version = 0u;
+
+    // Last flattening and what it was made from
+    mutable Flattened flattened;
+    mutable uint64_t flattenedVersion = ~uint64_t( 0u );
+    mutable Affine2<float> flattenedTransform;
+    mutable float flattenedTolerance = 0.0f;
+
+    // Last polygon, made from the flattening above
+    mutable std::shared_ptr<const Polygon> polygon;
+    mutable uint64_t polygonVersion = ~uint64_t( 0u );
+    mutable Affine2<float> polygonTransform;
+    mutable float polygonTolerance = 0.0f;
+    mutable FillRule polygonRule = FillRule::NON_ZERO;
+};
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Blend.h"
+#include "Utility/Vec2.h"
+#include "Utility/Rect.h"
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Which parts of a polygon count as inside, even-odd fills
+//      where a ray from a point crosses the outline an odd number of
+//      times and non-zero fills where the outline winds around a
+//      point at all
+enum class FillRule { EVEN_ODD, NON_ZERO };
+
+//////////////////////////////////////////////////////////////////
+// @brief A polygon of one or more closed contours prepared for
+//      scanline filling, its edges are sorted by the first row they
+//      cross so each row only steps the edges active on it. Contours
+//      may be concave, cross each other or themselves and cut holes.
+//      Points are 28.4 fixed point like half-space triangles and a
+//      pixel is filled when its center is inside
+class Polygon
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Builds the edge table, each contour is closed from its
+    //      last point back to its first
+    //
+    // @param points: points of every contour one after another in
+    //      28.4 fixed point
+    // @param contourSizes: number of points in each contour
+    // @param contourCount: number of contours
+    // @param rule: which parts of the polygon are filled
+    Polygon(
+        const Vec2<int>* points,
+        const size_t*    contourSizes,
+        size_t           contourCount,
+        FillRule         rule );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills the polygon one row at a time, every row is a list
+    //      of spans between the edges crossing it
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param paint: color and blend mode to draw with
+    void Fill(
+        Framebuffer& frame,
+        const Rect&  clip,
+        const Paint& paint ) const;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the pixels the polygon may touch
+    const Rect& GetBounds() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns which parts of the polygon are filled
+    FillRule GetFillRule() const noexcept;
+
+public:
+    // Points are clamped this far from the origin in 28.4 units so the edge steps fit in 64 bits
+    static constexpr int maxCoordinate = 1 << 26;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief An edge between two points, pointing up the surface,
+    //      crossing rows firstRow up to but not including endRow. Where
+    //      it crosses row r the first pixel right of it is 
+    //      ceil( ( numerator + r * step ) / denominator )
+    struct Edge
+    {
+        int firstRow;
+        int endRow;
+        int winding;
+        int64_t numerator;
+        int64_t denominator;
+        int64_t step;
+    };
+
+    //////////////////////////////////////////////////////////////////
+    // @brief An edge crossing the current row, the first pixel right
+    //      of it and how far the exact crossing is left of that pixel
+    //      in units of 1 / denominator
+    struct ActiveEdge
+    {
+        int x;
+        int endRow;
+        int winding;
+        int64_t error;
+        int64_t denominator;
+        int64_t whole;
+        int64_t fraction;
+    };
+
+private:
+    std::vector<Edge> edges;
+    Rect bounds;
+    FillRule rule;
+};
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Utility/Rect.h"
+#include <vector>
+
+//////////////////////////////////////////////////////////////////
+// @brief Interface for displaying a finished framebuffer, lets 
+//      the graphics pipeline run without knowing its destination
+class Presenter
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Virtual destructor for safe deletion through interface
+    virtual ~Presenter() = default;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Displays the contents of a framebuffer
+    //
+    // @param frame: finished frame to display
+    virtual void Present( const Framebuffer& frame ) = 0;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Displays only the parts of a framebuffer that changed,
+    //      everything outside them must still be showing the last
+    //      frame. Presenters that can't update part of the display
+    //      present the whole frame instead
+    //
+    // @param frame: finished frame to display
+    // @param rects: regions of the frame that differ from the last
+    //      frame presented
+    virtual void PresentRegion( 
+        const Framebuffer&       frame, 
+        const std::vector<Rect>& /*rects*/ ) { Present( frame ); }
+};
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include "Graphics/ImageView.h"
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief The Quite OK Image format, lossless and compressed a few
+//      times over raw pixels while encoding and decoding in a single
+//      pass with no tables beyond 64 recently seen colors
+class Qoi
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Reads the size of an image from its header, false if the
+    //      data isn't a QOI image or is too large to decode
+    //
+    // @param data: the encoded image
+    // @param size: size of the data in bytes
+    // @param width: set to the width of the image in pixels
+    // @param height: set to the height of the image in pixels
+    static bool ReadHeader(
+        const uint8_t* data,
+        size_t         size,
+        int&           width,
+        int&           height ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Decodes an image whose header has been read, false if
+    //      the data ends before every pixel is decoded
+    //
+    // @param data: the encoded image, header included
+    // @param size: size of the data in bytes
+    // @param pixels: receives width * height pixels row after row
+    // @param count: number of pixels, width * height from the header
+    static bool Decode(
+        const uint8_t* data,
+        size_t         size,
+        uint32_t*      pixels,
+        size_t         count ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Encodes an image and appends it to a buffer
+    //
+    // @param image: pixels to encode
+    // @param alpha: false to store only color, every pixel decodes
+    //      with full alpha
+    // @param out: buffer the encoded image is appended to
+    static void Encode(
+        const ImageView&      image,
+        bool                  alpha,
+        std::vector<uint8_t>& out );
+
+public:
+    static constexpr size_t headerSize = 14u;
+    static constexpr size_t paddingSize = 8u;
+
+    // Largest image the format allows, keeps a corrupt header from asking for gigabytes
+    static constexpr size_t maxPixels = 400000000u;
+};
\ No newline at end of file
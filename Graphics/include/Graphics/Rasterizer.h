@@ -0,0 +1,144 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Blend.h"
+#include "Graphics/ImageView.h"
+#include "Utility/Vec2.h"
+#include "Utility/Rect.h"
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Stateless drawing routines that write into a surface, 
+//      only pixels inside the clip rectangle are ever touched so the
+//      same primitive can be split across tiles
+class Rasterizer
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills a rectangle, the corners may be in any order
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param corner1: first corner of the rectangle
+    // @param corner2: second corner of the rectangle
+    // @param paint: color and blend mode to draw with
+    static void FillRectangle(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& corner1,
+        const Vec2<int>& corner2,
+        const Paint&     paint ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills a triangle by walking its edges with Bresenham's
+    //      and filling the scanlines between them, the walk starts at
+    //      the first row inside the clip region and stops at its last
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param v1: first vertex of the triangle
+    // @param v2: second vertex of the triangle
+    // @param v3: third vertex of the triangle
+    // @param paint: color and blend mode to draw with
+    static void FillTriangle(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& v1,
+        const Vec2<int>& v2,
+        const Vec2<int>& v3,
+        const Paint&     paint ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws a line between two points with Bresenham's
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param pos1: starting point of line
+    // @param pos2: end point of line
+    // @param paint: color and blend mode to draw with
+    // @param first: false to leave out the starting point, for lines
+    //      continuing a polyline whose last line already drew it
+    static void DrawLine(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& pos1,
+        const Vec2<int>& pos2,
+        const Paint&     paint,
+        bool             first = true ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws the outline of an axis aligned ellipse with the
+    //      midpoint algorithm, each row of the outline is drawn as one
+    //      or two spans so no pixel is written twice
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param center: center of the ellipse
+    // @param radiusX: distance from the center to the left and right
+    //      of the outline in pixels
+    // @param radiusY: distance from the center to the top and bottom
+    //      of the outline in pixels
+    // @param paint: color and blend mode to draw with
+    static void DrawEllipse(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& center,
+        int              radiusX,
+        int              radiusY,
+        const Paint&     paint ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills an axis aligned ellipse with one span per row, the
+    //      rows end where the outline drawn by DrawEllipse ends
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param center: center of the ellipse
+    // @param radiusX: distance from the center to the left and right
+    //      of the outline in pixels
+    // @param radiusY: distance from the center to the top and bottom
+    //      of the outline in pixels
+    // @param paint: color and blend mode to draw with
+    static void FillEllipse(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& center,
+        int              radiusX,
+        int              radiusY,
+        const Paint&     paint ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copies an image onto the surface a row at a time, every
+    //      pixel replaces the one beneath it alpha and all
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param image: pixels to copy
+    // @param position: where the top left pixel of the image goes
+    static void CopyImage(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const ImageView& image,
+        const Vec2<int>& position ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Fills a horizontal run of pixels
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param y: row of the run
+    // @param left: first pixel of the run
+    // @param right: one past the last pixel of the run
+    // @param paint: color and blend mode to draw with
+    static void FillSpan(
+        Framebuffer& frame,
+        const Rect&  clip,
+        int          y,
+        int          left,
+        int          right,
+        const Paint& paint ) noexcept;
+
+public:
+    // Radii up to this end their rows exactly where the midpoint algorithm does, larger ones round
+    // the ends in floating point since the exact terms no longer fit in 64 bits
+    static constexpr int exactRadius = 1 << 14;
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+#include "Graphics/Blend.h"
+#include <stdint.h>
+#include <stddef.h>
+
+struct ShadedSpan;
+
+//////////////////////////////////////////////////////////////////
+// @brief Writes a span of a shaded triangle, called once per run of
+//      covered pixels in a row with the attributes at its first pixel
+//
+// @param pixels: first pixel of the span on the surface
+// @param span: position, length and attributes of the span
+// @param user: data given with the triangle
+using SpanShader = void (*)( uint32_t* pixels, const ShadedSpan& span, const void* user );
+
+//////////////////////////////////////////////////////////////////
+// @brief Interpolation of per vertex attributes across triangles,
+//      attributes are 16.16 fixed point so stepping them across a
+//      span is exact and every instruction set agrees to the bit
+class Shading
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes every value of one attribute across a span,
+    //      values[i] = value + step * i
+    //
+    // @param values: destination for count values
+    // @param count: number of pixels in the span
+    // @param value: attribute at the first pixel in 16.16 fixed point
+    // @param step: change of the attribute per pixel
+    static void Expand(
+        int32_t* values,
+        size_t   count,
+        int32_t  value,
+        int32_t  step ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Shader for vertex colors, the attributes are blue, green,
+    //      red and alpha from 0 to 255 and are rounded and clamped per
+    //      pixel then blended with the span's blend mode
+    //
+    // @param pixels: first pixel of the span on the surface
+    // @param span: position, length and colors of the span
+    // @param user: unused
+    static void Gouraud(
+        uint32_t*         pixels,
+        const ShadedSpan& span,
+        const void*       user ) noexcept;
+
+public:
+    static constexpr int maxAttributes = 4;
+    static constexpr int fractionBits = 16;
+    static constexpr int32_t one = 1 << fractionBits;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief A run of covered pixels in one row of a shaded triangle
+struct ShadedSpan
+{
+    int x;
+    int y;
+    int count;
+    int attributeCount;
+    BlendMode blend;
+
+    // Attributes at the center of the first pixel and their change per pixel, in 16.16 fixed point
+    int32_t value[Shading::maxAttributes];
+    int32_t step[Shading::maxAttributes];
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief The attribute planes of a triangle computed once at setup,
+//      an attribute at the center of pixel (x, y) is
+//      value + stepX * ( x - x0 ) + stepY * ( y - y0 ) in 16.16 fixed
+//      point, relative to a pixel near the triangle so rounding the
+//      steps never drifts far
+struct Gradients
+{
+    int count;
+    int x0;
+    int y0;
+    int64_t value[Shading::maxAttributes];
+    int64_t stepX[Shading::maxAttributes];
+    int64_t stepY[Shading::maxAttributes];
+
+    SpanShader shader;
+    const void* user;
+    BlendMode blend;
+};
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include <stdint.h>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Vectorized kernels for filling horizontal runs of pixels
+class SpanFill
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Sets a run of pixels to a single value
+    //
+    // @param dst: first pixel of the run
+    // @param count: number of pixels in the run
+    // @param value: pixel value to write
+    static void Fill(
+        uint32_t* dst,
+        size_t    count,
+        uint32_t  value ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Sets every pixel of a surface to a single value, large
+    //      surfaces bypass the cache with non-temporal stores
+    //
+    // @param frame: surface to clear, including row padding
+    // @param value: pixel value to write
+    static void Clear(
+        Framebuffer& frame,
+        uint32_t     value ) noexcept;
+
+public:
+    // Surfaces larger than this are cleared with streaming stores
+    static constexpr size_t streamThreshold = 1u << 20;
+};
\ No newline at end of file
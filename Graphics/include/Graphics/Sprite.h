@@ -0,0 +1,102 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Blend.h"
+#include "Graphics/ImageView.h"
+#include "Utility/Vec2.h"
+#include "Utility/Rect.h"
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief An image encoded for fast drawing with transparency, each
+//      row is a list of runs of opaque or partly transparent pixels
+//      and the fully transparent pixels between them are not stored
+//      at all, so drawing steps over them without reading anything.
+//      Opaque runs are copied straight onto the surface and the
+//      rest are blended pixel by pixel
+class Sprite
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Encodes an image using its alpha, pixels with no alpha
+    //      are left out
+    //
+    // @param image: the image, copied
+    explicit Sprite( const ImageView& image );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Encodes an image with a color key, pixels of the key's
+    //      color are left out and every other pixel is opaque
+    //
+    // @param image: the image, copied
+    // @param colorKey: color left out as 0xRRGGBB, alpha is ignored
+    Sprite(
+        const ImageView& image,
+        uint32_t         colorKey );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws the sprite, only writing inside the clip region
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param position: where the top left pixel of the sprite goes
+    // @param mode: how the pixels combine with the surface
+    void Draw(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& position,
+        BlendMode        mode ) const noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of the image in pixels
+    int GetWidth() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the height of the image in pixels
+    int GetHeight() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of pixels kept, the ones that are not
+    //      fully transparent
+    size_t GetPixelCount() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of runs across every row
+    size_t GetRunCount() const noexcept;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Pixels x up to x + count of a row, kept one after another
+    //      from offset, all of them opaque or all partly transparent
+    struct Run
+    {
+        int x;
+        int count;
+        bool opaque;
+        size_t offset;
+    };
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Splits every row into runs and keeps their pixels
+    //
+    // @param image: the image
+    // @param keyed: true to leave out the key's color, false to leave
+    //      out pixels with no alpha
+    // @param colorKey: color left out when keyed
+    void Encode(
+        const ImageView& image,
+        bool             keyed,
+        uint32_t         colorKey );
+
+private:
+    int width = 0;
+    int height = 0;
+
+    // Runs of row y are rowRuns[y] up to rowRuns[y + 1]
+    std::vector<size_t> rowRuns;
+    std::vector<Run> runs;
+    std::vector<uint32_t> pixels;
+};
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Blend.h"
+#include "Utility/Vec2.h"
+#include "Utility/Rect.h"
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Rasterizer for wide and anti-aliased lines with round ends,
+//      each pixel is covered by how far its center lies inside the
+//      line so the result never depends on the direction a line is
+//      drawn in or the tiles it is split across. Points are 28.4
+//      fixed point like half-space triangles, a whole pixel's center
+//      is half a pixel in
+class Stroke
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws one segment of a line. A segment continuing a
+    //      polyline knows the points either side of it and leaves a
+    //      pixel to its neighbour when the neighbour covers more of
+    //      it, ties going to the earlier segment, so the pixels around
+    //      a shared point are drawn once
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param start: first point of the segment
+    // @param end: last point of the segment
+    // @param previous: point before start in the polyline, start
+    //      itself if the segment is the first
+    // @param next: point after end in the polyline, end itself if the
+    //      segment is the last
+    // @param width: width of the line in pixels, at least one
+    // @param antialias: false to fill pixels at least half covered
+    //      and leave the rest
+    // @param color: color to draw with, alpha in the top byte
+    // @param blend: how the color combines with the surface
+    static void DrawSegment(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& start,
+        const Vec2<int>& end,
+        const Vec2<int>& previous,
+        const Vec2<int>& next,
+        float            width,
+        bool             antialias,
+        uint32_t         color,
+        BlendMode        blend ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the pixels a segment may touch
+    //
+    // @param start: first point of the segment
+    // @param end: last point of the segment
+    // @param width: width of the line in pixels
+    static Rect GetBounds(
+        const Vec2<int>& start,
+        const Vec2<int>& end,
+        float            width ) noexcept;
+};
\ No newline at end of file
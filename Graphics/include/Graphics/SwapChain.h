@@ -0,0 +1,116 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Presenter.h"
+#include "Graphics/DirtyRegion.h"
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Rotates a set of framebuffers between the drawing thread 
+//      and a dedicated present thread, which presents each finished
+//      frame and clears it so the next frame can be drawn meanwhile
+class SwapChain
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Allocates the spare buffers and starts the present thread
+    //
+    // @param width: width of every buffer in pixels
+    // @param height: height of every buffer in pixels
+    // @param bufferCount: total buffers including the one held by the
+    //      drawing thread, at least 2
+    // @param presenter: destination for finished frames, may be null
+    // @param clearColor: pixel value buffers are cleared to
+    SwapChain(
+        int                        width,
+        int                        height,
+        unsigned                   bufferCount,
+        std::unique_ptr<Presenter> presenter,
+        uint32_t                   clearColor );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copy constructor is deleted, owns its thread
+    SwapChain( const SwapChain& ) = delete;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Presents every queued frame and stops the present thread
+    ~SwapChain();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Assignment operator is deleted, owns its thread
+    SwapChain& operator=( const SwapChain& ) = delete;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Queues a finished frame and hands back a cleared buffer, 
+    //      blocks only while every spare buffer is still in flight
+    //
+    // @param frame: finished frame, receives the cleared buffer
+    // @param drawn: tiles drawn into the finished frame, receives an
+    //      empty region
+    // @param presentAll: if the whole frame must be presented rather
+    //      than only what changed
+    void Swap( 
+        Framebuffer& frame, 
+        DirtyRegion& drawn, 
+        bool         presentAll );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Blocks until every queued frame has been presented
+    void Wait();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Waits for every queued frame and gives up the presenter
+    std::unique_ptr<Presenter> ReleasePresenter();
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the total number of buffers
+    unsigned GetBufferCount() const noexcept;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief A buffer along with the tiles drawn into it
+    struct Slot
+    {
+        Framebuffer frame;
+        DirtyRegion drawn;
+        bool presentAll = false;
+    };
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Presents and clears queued frames until stopped
+    void PresentLoop();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Presents what changed in a frame since the last one and
+    //      clears what was drawn into it
+    //
+    // @param slot: finished frame to present
+    void PresentSlot( Slot& slot );
+
+private:
+    std::unique_ptr<Presenter> presenter;
+    uint32_t clearColor;
+    unsigned bufferCount;
+
+    // Frames waiting to be presented and buffers ready to be drawn into
+    std::deque<Slot> queued;
+    std::vector<Slot> ready;
+    bool presenting = false;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable frameQueued;
+    std::condition_variable bufferReady;
+
+    // Only touched by the present thread
+    DirtyRegion shown;
+    std::vector<Rect> dirtyRects;
+
+    std::thread thread;
+};
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+#include "Graphics/Font.h"
+#include "Graphics/TextLayout.h"
+#include "Utility/LruCache.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Lays out strings and keeps what it made, each glyph is
+//      rasterized once per font and scale and each string laid out
+//      once until it goes unused for long enough to be dropped. A
+//      label drawn every frame is found in one lookup
+class TextCache
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs empty caches
+    //
+    // @param glyphCapacity: most glyphs kept at once
+    // @param layoutCapacity: most laid out strings kept at once
+    TextCache(
+        size_t glyphCapacity = defaultGlyphCapacity,
+        size_t layoutCapacity = defaultLayoutCapacity );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a string laid out on lines split at newlines,
+    //      with the font's kerning between characters
+    //
+    // @param font: font to draw with
+    // @param text: the string in UTF-8
+    // @param scale: how many pixels each pixel of the font covers,
+    //      clamped to 1 to maxScale
+    std::shared_ptr<const TextLayout> GetLayout(
+        const Font&      font,
+        std::string_view text,
+        int              scale );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a character rasterized, valid until the next
+    //      call that may rasterize another
+    //
+    // @param font: font to draw with
+    // @param character: the character
+    // @param scale: how many pixels each pixel of the font covers,
+    //      clamped to 1 to maxScale
+    const Glyph& GetGlyph(
+        const Font& font,
+        uint32_t    character,
+        int         scale );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Drops every glyph and layout, layouts still being drawn
+    //      stay alive until they are
+    void Clear();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of glyphs kept
+    size_t GetGlyphCount() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of laid out strings kept
+    size_t GetLayoutCount() const noexcept;
+
+public:
+    static constexpr int maxScale = 64;
+    static constexpr size_t defaultGlyphCapacity = 1024u;
+    static constexpr size_t defaultLayoutCapacity = 256u;
+
+private:
+    // Glyphs are keyed by font id, character and scale packed together
+    LruCache<uint64_t, Glyph> glyphs;
+
+    // Layouts are keyed by the font id and scale as bytes followed by the string
+    LruCache<std::string, std::shared_ptr<const TextLayout>> layouts;
+
+    // Reused for every lookup so strings already laid out allocate nothing
+    std::string key;
+};
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/Blend.h"
+#include "Graphics/Font.h"
+#include "Utility/Vec2.h"
+#include "Utility/Rect.h"
+#include <vector>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief A string laid out and rasterized, the ink of every glyph
+//      as one list of spans sorted by row so drawing is a single pass
+//      that starts at the first row inside the clip region
+class TextLayout
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Sorts the spans and joins those that touch
+    //
+    // @param spans: ink of every glyph from the top left pixel of the
+    //      text, rows below it are negative
+    // @param size: width of the longest line and height of every line
+    TextLayout(
+        std::vector<TextSpan> spans,
+        const Vec2<int>&      size );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws the text, only writing inside the clip region
+    //
+    // @param frame: surface to draw to
+    // @param clip: region of the surface that may be written
+    // @param position: where the top left pixel of the text goes, the
+    //      rest is to the right of and below it
+    // @param paint: color and blend mode to draw with
+    void Draw(
+        Framebuffer&     frame,
+        const Rect&      clip,
+        const Vec2<int>& position,
+        const Paint&     paint ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the pixels the ink covers from the top left pixel
+    //      of the text, rows below it are negative
+    const Rect& GetBounds() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of the longest line and the height of
+    //      every line, for placing text next to other things
+    const Vec2<int>& GetSize() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of spans drawn
+    size_t GetSpanCount() const noexcept;
+
+private:
+    std::vector<TextSpan> spans;
+    Rect bounds;
+    Vec2<int> size;
+};
\ No newline at end of file
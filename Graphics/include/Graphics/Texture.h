@@ -0,0 +1,179 @@
+#pragma once
+#include "Graphics/Shading.h"
+#include "Graphics/ImageView.h"
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief How texels are picked for a sample, nearest takes the one
+//      texel the sample falls in and bilinear weighs the four nearest
+enum class TextureFilter { NEAREST, BILINEAR };
+
+//////////////////////////////////////////////////////////////////
+// @brief An image for texturing triangles with a chain of mipmaps,
+//      each level is stored in 4x4 tiles of one cache line with the
+//      texels of a tile in Morton order, so texels that are near on
+//      screen in any direction are near in memory. Sizes are powers
+//      of two and coordinates repeat outside 0 to 1
+class Texture
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Copies an image into the tiled layout and builds its
+    //      mipmaps, each level a 2x2 box filter of the one above it
+    //
+    // @param width: width of the image, a power of two
+    // @param height: height of the image, a power of two
+    // @param pixels: the image, row 0 is at v = 0
+    // @param pitch: distance between rows of the image in pixels
+    // @param mipmaps: false to keep only the full size level
+    Texture(
+        int             width,
+        int             height,
+        const uint32_t* pixels,
+        ptrdiff_t       pitch,
+        bool            mipmaps = true );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copies an image such as a loaded file into the tiled
+    //      layout and builds its mipmaps
+    //
+    // @param image: the image, sides a power of two and row 0 at v = 0
+    // @param mipmaps: false to keep only the full size level
+    explicit Texture(
+        const ImageView& image,
+        bool             mipmaps = true );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns one texel of a level, coordinates repeat
+    //
+    // @param level: mip level, 0 is full size
+    // @param x: column of the texel
+    // @param y: row of the texel
+    uint32_t Fetch(
+        int level,
+        int x,
+        int y ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the color of a level at a point
+    //
+    // @param level: mip level, 0 is full size
+    // @param u: horizontal coordinate, 0 to 1 across the texture
+    // @param v: vertical coordinate, 0 to 1 across the texture
+    // @param filter: how texels are combined
+    uint32_t Sample(
+        int           level,
+        float         u,
+        float         v,
+        TextureFilter filter ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the mip level for a footprint, the level where
+    //      one pixel steps about one texel
+    //
+    // @param footprint: squared length in full size texels of the
+    //      longer of the pixel's steps in x and in y
+    int SelectLevel( float footprint ) const noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the width of the full size level
+    int GetWidth() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the height of the full size level
+    int GetHeight() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of mip levels
+    int GetLevelCount() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if every texel has full alpha
+    bool IsOpaque() const noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Span shader for textured triangles, samples at every
+    //      pixel with perspective correction and picks a mip level
+    //      every few pixels from the rate the coordinates change
+    //
+    // @param pixels: first pixel of the span on the surface
+    // @param span: position and length of the span
+    // @param mapping: the TextureMapping of the triangle
+    static void Shade(
+        uint32_t*         pixels,
+        const ShadedSpan& span,
+        const void*       mapping ) noexcept;
+
+public:
+    static constexpr int tileSize = 4;
+
+private:
+    struct Level
+    {
+        int width;
+        int height;
+        int tilesPerRow;
+        size_t offset;
+    };
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns where a texel of a level is stored
+    //
+    // @param level: the level
+    // @param x: column of the texel within the level
+    // @param y: row of the texel within the level
+    size_t Index(
+        const Level& level,
+        int          x,
+        int          y ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns one texel of a level, coordinates repeat
+    //
+    // @param level: the level
+    // @param x: column of the texel
+    // @param y: row of the texel
+    uint32_t Fetch(
+        const Level& level,
+        int          x,
+        int          y ) const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the color of a level at a point
+    //
+    // @param level: the level
+    // @param u: horizontal coordinate, 0 to 1 across the texture
+    // @param v: vertical coordinate, 0 to 1 across the texture
+    // @param filter: how texels are combined
+    uint32_t Sample(
+        const Level&  level,
+        float         u,
+        float         v,
+        TextureFilter filter ) const noexcept;
+
+    std::vector<Level> levels;
+    std::vector<uint32_t> texels;
+    bool opaque = true;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief The texture coordinates of a triangle as planes over the
+//      surface, u / w, v / w and 1 / w are linear on screen so
+//      dividing by the last one at each pixel corrects perspective.
+//      A plane is its value at the center of pixel (x0, y0) followed
+//      by its change per pixel in x and in y
+struct TextureMapping
+{
+    const Texture* texture;
+    TextureFilter filter;
+    int x0;
+    int y0;
+    float u[3];
+    float v[3];
+    float q[3];
+};
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include "Graphics/Framebuffer.h"
+#include "Graphics/DrawCommand.h"
+#include "Utility/ThreadPool.h"
+#include <vector>
+#include <atomic>
+#include <optional>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Deferred renderer that records draw calls, sorts them into
+//      screen tiles and rasterizes the tiles in parallel, each tile
+//      runs its commands in submission order so the output matches
+//      immediate drawing exactly
+class TileRenderer
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Starts the worker pool
+    //
+    // @param threadCount: threads rasterizing tiles including the
+    //      caller, 0 picks one per hardware thread
+    TileRenderer( unsigned threadCount );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a clear of the whole surface, discarding every
+    //      command recorded before it
+    //
+    // @param color: pixel value to clear to
+    void Clear( uint32_t color );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Records a draw call to run on the next flush
+    //
+    // @param command: draw call to record
+    void Submit( const DrawCommand& command );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Bins and rasterizes everything recorded into the surface
+    //      and resets for the next frame
+    //
+    // @param frame: surface to draw to
+    // @param depth: depth of the surface for depth triangles, may be
+    //      null
+    void Flush( 
+        Framebuffer& frame,
+        DepthBuffer* depth = nullptr );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of threads rasterizing tiles
+    unsigned GetThreadCount() const noexcept;
+
+public:
+    // A 64x64 tile of 32 bit pixels is 16KB and stays in L1 while it is drawn
+    static constexpr int tileSize = 64;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Sorts every recorded command into the tiles it touches
+    //
+    // @param frame: surface the tiles cover
+    void Bin( const Framebuffer& frame );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Clears a tile if needed and runs its commands in order
+    //
+    // @param frame: surface to draw to
+    // @param depth: depth of the surface, may be null
+    // @param tile: index of the tile to draw
+    void RenderTile( 
+        Framebuffer& frame, 
+        DepthBuffer* depth,
+        int          tile ) const noexcept;
+
+private:
+    std::vector<DrawCommand> commands;
+    std::vector<std::vector<uint32_t>> bins;
+    std::optional<uint32_t> clearColor;
+    int tilesX = 0;
+    int tilesY = 0;
+    std::atomic<int> nextTile = 0;
+    ThreadPool pool;
+};
\ No newline at end of file
@@ -22,4 +22,5 @@ private:
 
 private:
     Window wnd;
+    DisplayList scene;
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+#include "Utility/Vec2.h"
+#include "Utility/Mat3.h"
+#include <cmath>
+
+//////////////////////////////////////////////////////////////////
+// @brief A 2D affine transform, a point ( x, y ) goes to 
+//      ( xx * x + xy * y + tx, yx * x + yy * y + ty ). The top two rows
+//      of a Mat3 without the row that is always 0 0 1
+template <typename T>
+struct Affine2
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs the identity
+    constexpr Affine2() = default;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a transform from its elements
+    //
+    // @param xx: how far x moves per unit of x
+    // @param xy: how far x moves per unit of y
+    // @param yx: how far y moves per unit of x
+    // @param yy: how far y moves per unit of y
+    // @param tx: distance to move right
+    // @param ty: distance to move up
+    constexpr Affine2( T xx, T xy, T yx, T yy, T tx, T ty ) : xx( xx ), xy( xy ), yx( yx ), yy( yy ), tx( tx ), ty( ty ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a transform that moves points by an offset
+    //
+    // @param x: distance to move right
+    // @param y: distance to move up
+    static constexpr Affine2<T> Translation( T x, T y ) { return Affine2<T>( 1, 0, 0, 1, x, y ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a transform that scales about the origin
+    //
+    // @param x: horizontal scale
+    // @param y: vertical scale
+    static constexpr Affine2<T> Scale( T x, T y ) { return Affine2<T>( x, 0, 0, y, 0, 0 ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a transform that turns about the origin, from x
+    //      towards y which is counter clockwise on the y-up surface
+    //
+    // @param radians: angle to turn
+    static Affine2<T> Rotation( T radians )
+    {
+        const T c = static_cast<T>( std::cos( radians ) ), s = static_cast<T>( std::sin( radians ) );
+        return Affine2<T>( c, -s, s, c, 0, 0 );
+    }
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if both transforms map every point the same
+    //
+    // @param rhs: transform to compare with
+    constexpr bool operator==( const Affine2<T>& rhs ) const
+    {
+        return xx == rhs.xx && xy == rhs.xy && yx == rhs.yx && yy == rhs.yy && tx == rhs.tx && ty == rhs.ty;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if any point maps differently
+    //
+    // @param rhs: transform to compare with
+    constexpr bool operator!=( const Affine2<T>& rhs ) const { return !( *this == rhs ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the composition, applying it applies rhs first
+    //
+    // @param rhs: transform to apply first
+    constexpr Affine2<T> operator*( const Affine2<T>& rhs ) const
+    {
+        return Affine2<T>(
+            xx * rhs.xx + xy * rhs.yx, xx * rhs.xy + xy * rhs.yy,
+            yx * rhs.xx + yy * rhs.yx, yx * rhs.xy + yy * rhs.yy,
+            xx * rhs.tx + xy * rhs.ty + tx, yx * rhs.tx + yy * rhs.ty + ty );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a point moved by the transform
+    //
+    // @param point: point to transform
+    constexpr Vec2<T> Apply( const Vec2<T>& point ) const
+    {
+        return Vec2<T>( xx * point.x + xy * point.y + tx, yx * point.x + yy * point.y + ty );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a direction turned and scaled by the transform,
+    //      without the translation
+    //
+    // @param direction: direction to transform
+    constexpr Vec2<T> ApplyVector( const Vec2<T>& direction ) const
+    {
+        return Vec2<T>( xx * direction.x + xy * direction.y, yx * direction.x + yy * direction.y );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns how much the transform scales areas, negative if
+    //      it mirrors and zero if it flattens the plane
+    constexpr T Determinant() const { return xx * yy - xy * yx; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the transform that undoes this one, all zeros if
+    //      the determinant is zero
+    constexpr Affine2<T> Inverse() const
+    {
+        const T determinant = Determinant();
+        if ( determinant == 0 )
+            return Affine2<T>( 0, 0, 0, 0, 0, 0 );
+
+        const T ixx = yy / determinant, ixy = -xy / determinant, iyx = -yx / determinant, iyy = xx / determinant;
+        return Affine2<T>( ixx, ixy, iyx, iyy, -( ixx * tx + ixy * ty ), -( iyx * tx + iyy * ty ) );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the transform as a 3 by 3 matrix
+    constexpr Mat3<T> ToMat3() const { return Mat3<T>( { xx, xy, tx }, { yx, yy, ty }, { 0, 0, 1 } ); }
+
+public:
+    T xx = 1;
+    T xy = 0;
+    T yx = 0;
+    T yy = 1;
+    T tx = 0;
+    T ty = 0;
+};
\ No newline at end of file
@@ -2,15 +2,17 @@
 #include <stdint.h>
 
 //////////////////////////////////////////////////////////////////
-// @brief RGB color represented in 32 bits
+// @brief RGB color with an alpha channel represented in 32 bits,
+//      alpha is stored in the top byte and is opaque unless given
 struct Color
 {
 public:
     //////////////////////////////////////////////////////////////////
     // @brief Constructs the color object with a hex code
     //
-    // @param hex: hex value of the color
-    Color( uint32_t hex ) : hex( hex ) {}
+    // @param hex: hex value of the color as 0xRRGGBB
+    // @param a: alpha channel [0-255], 0 is fully transparent
+    Color( uint32_t hex, uint8_t a = 255 ) : hex( ( static_cast<uint32_t>( a ) << 24 ) | ( hex & 0xFFFFFFu ) ) {}
 
     //////////////////////////////////////////////////////////////////
     // @brief Constructs the color object with rgb values
@@ -18,7 +20,12 @@ public:
     // @param r: red channel [0-255]
     // @param g: green channel [0-255]
     // @param b: blue channel [0-255]
-    Color( uint8_t r, uint8_t g, uint8_t b ) : hex( ( r << 16 ) | ( g << 8 ) | b ) {}
+    // @param a: alpha channel [0-255], 0 is fully transparent
+    Color( uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255 ) : hex( ( static_cast<uint32_t>( a ) << 24 ) | ( r << 16 ) | ( g << 8 ) | b ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the alpha channel [0-255]
+    uint8_t GetAlpha() const { return static_cast<uint8_t>( hex >> 24 ); }
 
 public:
     uint32_t hex;
@@ -0,0 +1,74 @@
+#pragma once
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief A map that holds at most a fixed number of values, adding
+//      one more drops the value that was used least recently
+template <typename Key, typename Value>
+class LruCache
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty cache
+    //
+    // @param capacity: most values held at once, at least one
+    explicit LruCache( size_t capacity ) : capacity( capacity > 0u ? capacity : 1u ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the value of a key and marks it used, null if the
+    //      key isn't held
+    //
+    // @param key: key to look up
+    const Value* Find( const Key& key )
+    {
+        const auto found = index.find( key );
+        if ( found == index.end() )
+            return nullptr;
+
+        // Most recently used values are kept at the front
+        entries.splice( entries.begin(), entries, found->second );
+        return &found->second->second;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Adds a value for a key that isn't held and returns it,
+    //      the returned value stays valid until it is dropped
+    //
+    // @param key: key of the value
+    // @param value: value to hold
+    const Value& Insert( const Key& key, Value value )
+    {
+        if ( entries.size() >= capacity )
+        {
+            index.erase( entries.back().first );
+            entries.pop_back();
+        }
+        entries.emplace_front( key, std::move( value ) );
+        index.emplace( key, entries.begin() );
+        return entries.front().second;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Drops every value
+    void Clear()
+    {
+        index.clear();
+        entries.clear();
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of values held
+    size_t GetSize() const { return entries.size(); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the most values held at once
+    size_t GetCapacity() const { return capacity; }
+
+private:
+    std::list<std::pair<Key, Value>> entries;
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> index;
+    size_t capacity;
+};
\ No newline at end of file
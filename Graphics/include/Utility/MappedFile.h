@@ -0,0 +1,49 @@
+#pragma once
+#include <filesystem>
+#include <stddef.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief A whole file mapped read only into memory, pages are read
+//      from disk as they are touched and shared with the file cache
+//      so nothing is copied into a buffer of our own
+class MappedFile
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Maps a file, the mapping is empty if the file can't be
+    //      opened or has nothing in it
+    //
+    // @param path: file to map
+    explicit MappedFile( const std::filesystem::path& path );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copy constructor is deleted, owns its mapping
+    MappedFile( const MappedFile& ) = delete;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Unmaps the file
+    ~MappedFile();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Assignment operator is deleted, owns its mapping
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the first byte of the file, aligned to a page,
+    //      null if nothing is mapped
+    const uint8_t* GetData() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the size of the file in bytes
+    size_t GetSize() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if the file was mapped
+    bool IsOpen() const noexcept;
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0u;
+};
\ No newline at end of file
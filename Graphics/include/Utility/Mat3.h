@@ -0,0 +1,143 @@
+#pragma once
+#include "Utility/Vec3.h"
+#include <cmath>
+
+//////////////////////////////////////////////////////////////////
+// @brief 3 by 3 matrix stored row by row, vectors are columns
+//      multiplied on the right. As a 2D transform in homogeneous
+//      coordinates the bottom row is 0 0 1
+template <typename T>
+struct Mat3
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs the identity
+    constexpr Mat3() : m{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } } {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a matrix from its rows
+    //
+    // @param row0: top row
+    // @param row1: middle row
+    // @param row2: bottom row
+    constexpr Mat3(
+        const Vec3<T>& row0,
+        const Vec3<T>& row1,
+        const Vec3<T>& row2 )
+        :
+        m{ { row0.x, row0.y, row0.z }, { row1.x, row1.y, row1.z }, { row2.x, row2.y, row2.z } }
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a 2D transform that moves points by an offset
+    //
+    // @param x: distance to move right
+    // @param y: distance to move up
+    static constexpr Mat3<T> Translation( T x, T y ) { return Mat3<T>( { 1, 0, x }, { 0, 1, y }, { 0, 0, 1 } ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a 2D transform that scales about the origin
+    //
+    // @param x: horizontal scale
+    // @param y: vertical scale
+    static constexpr Mat3<T> Scale( T x, T y ) { return Mat3<T>( { x, 0, 0 }, { 0, y, 0 }, { 0, 0, 1 } ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a 2D transform that turns about the origin, from
+    //      x towards y which is counter clockwise on the y-up surface
+    //
+    // @param radians: angle to turn
+    static Mat3<T> Rotation( T radians )
+    {
+        const T c = static_cast<T>( std::cos( radians ) ), s = static_cast<T>( std::sin( radians ) );
+        return Mat3<T>( { c, -s, 0 }, { s, c, 0 }, { 0, 0, 1 } );
+    }
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if every element matches
+    //
+    // @param rhs: matrix to compare with
+    constexpr bool operator==( const Mat3<T>& rhs ) const
+    {
+        for ( int r = 0; r < 3; ++r )
+            for ( int c = 0; c < 3; ++c )
+                if ( m[r][c] != rhs.m[r][c] )
+                    return false;
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if any element differs
+    //
+    // @param rhs: matrix to compare with
+    constexpr bool operator!=( const Mat3<T>& rhs ) const { return !( *this == rhs ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the product, applying it applies rhs first
+    //
+    // @param rhs: matrix to multiply with
+    constexpr Mat3<T> operator*( const Mat3<T>& rhs ) const
+    {
+        Mat3<T> product;
+        for ( int r = 0; r < 3; ++r )
+            for ( int c = 0; c < 3; ++c )
+                product.m[r][c] = m[r][0] * rhs.m[0][c] + m[r][1] * rhs.m[1][c] + m[r][2] * rhs.m[2][c];
+        return product;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a vector multiplied by the matrix
+    //
+    // @param v: vector to transform
+    constexpr Vec3<T> operator*( const Vec3<T>& v ) const
+    {
+        return Vec3<T>(
+            m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+            m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+            m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the matrix flipped about its diagonal
+    constexpr Mat3<T> Transpose() const
+    {
+        return Mat3<T>( { m[0][0], m[1][0], m[2][0] }, { m[0][1], m[1][1], m[2][1] }, { m[0][2], m[1][2], m[2][2] } );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the determinant, zero if the matrix flattens space
+    constexpr T Determinant() const
+    {
+        return 
+            m[0][0] * ( m[1][1] * m[2][2] - m[1][2] * m[2][1] ) -
+            m[0][1] * ( m[1][0] * m[2][2] - m[1][2] * m[2][0] ) +
+            m[0][2] * ( m[1][0] * m[2][1] - m[1][1] * m[2][0] );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the inverse, all zeros if the determinant is zero
+    constexpr Mat3<T> Inverse() const
+    {
+        const T determinant = Determinant();
+        if ( determinant == 0 )
+            return Mat3<T>( { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } );
+
+        // The adjugate is the transpose of the cofactors
+        auto cofactor = [this]( int r0, int r1, int c0, int c1 ) { return m[r0][c0] * m[r1][c1] - m[r0][c1] * m[r1][c0]; };
+        const Mat3<T> adjugate(
+            { cofactor( 1, 2, 1, 2 ), -cofactor( 0, 2, 1, 2 ), cofactor( 0, 1, 1, 2 ) },
+            { -cofactor( 1, 2, 0, 2 ), cofactor( 0, 2, 0, 2 ), -cofactor( 0, 1, 0, 2 ) },
+            { cofactor( 1, 2, 0, 1 ), -cofactor( 0, 2, 0, 1 ), cofactor( 0, 1, 0, 1 ) } );
+
+        Mat3<T> inverse;
+        for ( int r = 0; r < 3; ++r )
+            for ( int c = 0; c < 3; ++c )
+                inverse.m[r][c] = adjugate.m[r][c] / determinant;
+        return inverse;
+    }
+
+public:
+    T m[3][3];
+};
\ No newline at end of file
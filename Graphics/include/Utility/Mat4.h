@@ -0,0 +1,161 @@
+#pragma once
+#include "Utility/Vec4.h"
+#include <cmath>
+
+//////////////////////////////////////////////////////////////////
+// @brief 4 by 4 matrix stored row by row, vectors are columns
+//      multiplied on the right. Transforms 3D points in homogeneous
+//      coordinates, including the projection onto the screen
+template <typename T>
+struct Mat4
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs the identity
+    constexpr Mat4() : m{ { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a matrix from its rows
+    //
+    // @param row0: top row
+    // @param row1: second row
+    // @param row2: third row
+    // @param row3: bottom row
+    constexpr Mat4(
+        const Vec4<T>& row0,
+        const Vec4<T>& row1,
+        const Vec4<T>& row2,
+        const Vec4<T>& row3 )
+        :
+        m{ 
+            { row0.x, row0.y, row0.z, row0.w }, 
+            { row1.x, row1.y, row1.z, row1.w }, 
+            { row2.x, row2.y, row2.z, row2.w }, 
+            { row3.x, row3.y, row3.z, row3.w } }
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a transform that moves points by an offset
+    //
+    // @param x: distance to move along x
+    // @param y: distance to move along y
+    // @param z: distance to move along z
+    static constexpr Mat4<T> Translation( T x, T y, T z )
+    {
+        return Mat4<T>( { 1, 0, 0, x }, { 0, 1, 0, y }, { 0, 0, 1, z }, { 0, 0, 0, 1 } );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a transform that scales about the origin
+    //
+    // @param x: scale along x
+    // @param y: scale along y
+    // @param z: scale along z
+    static constexpr Mat4<T> Scale( T x, T y, T z )
+    {
+        return Mat4<T>( { x, 0, 0, 0 }, { 0, y, 0, 0 }, { 0, 0, z, 0 }, { 0, 0, 0, 1 } );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a transform that turns about one axis, from the
+    //      next axis towards the one after it
+    //
+    // @param radians: angle to turn
+    static Mat4<T> RotationX( T radians )
+    {
+        const T c = static_cast<T>( std::cos( radians ) ), s = static_cast<T>( std::sin( radians ) );
+        return Mat4<T>( { 1, 0, 0, 0 }, { 0, c, -s, 0 }, { 0, s, c, 0 }, { 0, 0, 0, 1 } );
+    }
+    static Mat4<T> RotationY( T radians )
+    {
+        const T c = static_cast<T>( std::cos( radians ) ), s = static_cast<T>( std::sin( radians ) );
+        return Mat4<T>( { c, 0, s, 0 }, { 0, 1, 0, 0 }, { -s, 0, c, 0 }, { 0, 0, 0, 1 } );
+    }
+    static Mat4<T> RotationZ( T radians )
+    {
+        const T c = static_cast<T>( std::cos( radians ) ), s = static_cast<T>( std::sin( radians ) );
+        return Mat4<T>( { c, -s, 0, 0 }, { s, c, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a perspective projection looking down z with y
+    //      down the screen. After dividing by w, x and y are -1 to 1
+    //      across the view and z is 0 at the near plane and 1 at the
+    //      far one, w is the distance along z for perspective correct
+    //      texturing
+    //
+    // @param fovY: angle the view covers from top to bottom in radians
+    // @param aspect: width of the view over its height
+    // @param nearZ: distance to the near plane, above zero
+    // @param farZ: distance to the far plane, beyond the near one
+    static Mat4<T> Perspective(
+        T fovY,
+        T aspect,
+        T nearZ,
+        T farZ )
+    {
+        const T f = static_cast<T>( 1 / std::tan( fovY / 2 ) ), depth = farZ / ( farZ - nearZ );
+        return Mat4<T>( { f / aspect, 0, 0, 0 }, { 0, f, 0, 0 }, { 0, 0, depth, -nearZ * depth }, { 0, 0, 1, 0 } );
+    }
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if every element matches
+    //
+    // @param rhs: matrix to compare with
+    constexpr bool operator==( const Mat4<T>& rhs ) const
+    {
+        for ( int r = 0; r < 4; ++r )
+            for ( int c = 0; c < 4; ++c )
+                if ( m[r][c] != rhs.m[r][c] )
+                    return false;
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if any element differs
+    //
+    // @param rhs: matrix to compare with
+    constexpr bool operator!=( const Mat4<T>& rhs ) const { return !( *this == rhs ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the product, applying it applies rhs first
+    //
+    // @param rhs: matrix to multiply with
+    constexpr Mat4<T> operator*( const Mat4<T>& rhs ) const
+    {
+        Mat4<T> product;
+        for ( int r = 0; r < 4; ++r )
+            for ( int c = 0; c < 4; ++c )
+                product.m[r][c] = m[r][0] * rhs.m[0][c] + m[r][1] * rhs.m[1][c] + m[r][2] * rhs.m[2][c] + m[r][3] * rhs.m[3][c];
+        return product;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a vector multiplied by the matrix
+    //
+    // @param v: vector to transform
+    constexpr Vec4<T> operator*( const Vec4<T>& v ) const
+    {
+        return Vec4<T>(
+            m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3] * v.w,
+            m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3] * v.w,
+            m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3] * v.w,
+            m[3][0] * v.x + m[3][1] * v.y + m[3][2] * v.z + m[3][3] * v.w );
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the matrix flipped about its diagonal
+    constexpr Mat4<T> Transpose() const
+    {
+        Mat4<T> transposed;
+        for ( int r = 0; r < 4; ++r )
+            for ( int c = 0; c < 4; ++c )
+                transposed.m[r][c] = m[c][r];
+        return transposed;
+    }
+
+public:
+    T m[4][4];
+};
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////
+// @brief Axis aligned rectangle of pixels, includes left and 
+//      bottom but excludes right and top
+struct Rect
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty rectangle
+    Rect() : left( 0 ), bottom( 0 ), right( 0 ), top( 0 ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a rectangle from its edges
+    //
+    // @param left: first column inside the rectangle
+    // @param bottom: first row inside the rectangle
+    // @param right: first column past the rectangle
+    // @param top: first row past the rectangle
+    Rect( int left, int bottom, int right, int top ) : left( left ), bottom( bottom ), right( right ), top( top ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if the rectangle contains no pixels
+    bool IsEmpty() const { return left >= right || bottom >= top; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if a pixel lies inside the rectangle
+    //
+    // @param x: column of the pixel
+    // @param y: row of the pixel
+    bool Contains( int x, int y ) const { return x >= left && x < right && y >= bottom && y < top; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the overlap of two rectangles, may be empty
+    //
+    // @param rhs: rectangle to intersect with
+    Rect Intersect( const Rect& rhs ) const
+    {
+        return Rect( 
+            std::max( left, rhs.left ), 
+            std::max( bottom, rhs.bottom ), 
+            std::min( right, rhs.right ), 
+            std::min( top, rhs.top ) );
+    }
+
+public:
+    int left;
+    int bottom;
+    int right;
+    int top;
+};
\ No newline at end of file
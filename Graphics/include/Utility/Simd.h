@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+
+// Only x86 targets get vectorized kernels, everything else uses scalar fallbacks
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+#define GFX_X86 1
+#endif
+
+// MSVC allows any intrinsic in any function, GCC and Clang need per function permission
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define GFX_TARGET_AVX2 __attribute__( ( target( "avx2" ) ) )
+#else
+#define GFX_TARGET_AVX2
+#endif
+
+//////////////////////////////////////////////////////////////////
+// @brief Runtime selection of the instruction set used by kernels
+class Simd
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Instruction sets in increasing order of capability
+    enum class Level { SCALAR, SSE2, AVX2 };
+
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the best level supported by this processor
+    static Level GetSupportedLevel() noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the level kernels are currently dispatching to
+    static Level GetLevel() noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Forces kernels to a level, clamped to what is supported,
+    //      used to compare variants against each other
+    //
+    // @param desired: desired instruction set
+    static void SetLevel( Level desired ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a printable name for a level
+    //
+    // @param level: level to name
+    static const char* GetName( Level level ) noexcept;
+
+private:
+    static std::atomic<Level> level;
+};
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Fixed set of worker threads that run the same job 
+//      together, the calling thread always takes part as well
+class ThreadPool
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Starts the worker threads
+    //
+    // @param threadCount: total threads running each job including 
+    //      the caller, 0 picks one per hardware thread
+    ThreadPool( unsigned threadCount );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copy constructor is deleted, owns its threads
+    ThreadPool( const ThreadPool& ) = delete;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Stops and joins every worker thread
+    ~ThreadPool();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Assignment operator is deleted, owns its threads
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Runs a job once on every thread and returns when all of
+    //      them have finished
+    //
+    // @param job: work to run, receives the index of its thread
+    void Run( const std::function<void( unsigned )>& job );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the total number of threads running each job
+    unsigned GetThreadCount() const noexcept;
+
+private:
+    //////////////////////////////////////////////////////////////////
+    // @brief Waits for jobs and runs them until the pool is stopped
+    //
+    // @param index: index passed to every job run on this thread
+    void WorkerLoop( unsigned index );
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void( unsigned )>* job = nullptr;
+    uint64_t generation = 0u;
+    unsigned pending = 0u;
+    bool stopping = false;
+};
\ No newline at end of file
@@ -6,18 +6,77 @@ template <typename T>
 struct Vec2
 {
 public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a zero vector
+    constexpr Vec2() : x( 0 ), y( 0 ) {}
+
     //////////////////////////////////////////////////////////////////
     // @brief Constructs a 2D vector 
     //
     // @param x: x coordinate of the vector
     // @param y: y coordinate of the vector
-    Vec2( T x, T y ) : x( x ), y( y ) {}
+    constexpr Vec2( T x, T y ) : x( x ), y( y ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if both coordinates match
+    //
+    // @param rhs: vector to compare with
+    constexpr bool operator==( const Vec2<T>& rhs ) const { return x == rhs.x && y == rhs.y; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if either coordinate differs
+    //
+    // @param rhs: vector to compare with
+    constexpr bool operator!=( const Vec2<T>& rhs ) const { return !( *this == rhs ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the sum or difference of two vectors
+    //
+    // @param rhs: vector to add or subtract
+    constexpr Vec2<T> operator+( const Vec2<T>& rhs ) const { return Vec2<T>( x + rhs.x, y + rhs.y ); }
+    constexpr Vec2<T> operator-( const Vec2<T>& rhs ) const { return Vec2<T>( x - rhs.x, y - rhs.y ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the vector pointing the other way
+    constexpr Vec2<T> operator-() const { return Vec2<T>( -x, -y ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the vector scaled or divided by a number
+    //
+    // @param scale: number to scale or divide by
+    constexpr Vec2<T> operator*( T scale ) const { return Vec2<T>( x * scale, y * scale ); }
+    constexpr Vec2<T> operator/( T scale ) const { return Vec2<T>( x / scale, y / scale ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Adds, subtracts or scales in place
+    //
+    // @param rhs: vector or number to apply
+    constexpr Vec2<T>& operator+=( const Vec2<T>& rhs ) { return *this = *this + rhs; }
+    constexpr Vec2<T>& operator-=( const Vec2<T>& rhs ) { return *this = *this - rhs; }
+    constexpr Vec2<T>& operator*=( T scale ) { return *this = *this * scale; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the dot product
+    //
+    // @param rhs: vector to multiply with
+    constexpr T Dot( const Vec2<T>& rhs ) const { return x * rhs.x + y * rhs.y; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the z of the 3D cross product, twice the signed
+    //      area of the triangle the two vectors span
+    //
+    // @param rhs: vector to multiply with
+    constexpr T Cross( const Vec2<T>& rhs ) const { return x * rhs.y - y * rhs.x; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the squared length, exact for whole numbers
+    constexpr T LengthSquared() const { return Dot( *this ); }
 
     //////////////////////////////////////////////////////////////////
     // @brief Swaps the values of two vectors
     //
     // @param rhs: vector to swap with
-    void Swap( Vec2<T>& rhs )
+    constexpr void Swap( Vec2<T>& rhs )
     {
         // Swap x
         T temp = x;
@@ -0,0 +1,106 @@
+#pragma once
+#include "Utility/Vec2.h"
+#include "Utility/Affine2.h"
+#include <vector>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief Many 2D points stored as structure of arrays, every x
+//      then every y, so a transform runs 4 or 8 points per instruction
+//      with no shuffling. Transforms dispatch on the SIMD level and
+//      every level gives the same results bit for bit
+class Vec2Batch
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs an empty batch
+    Vec2Batch() = default;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a batch holding a copy of some points
+    //
+    // @param points: points to copy
+    // @param count: number of points
+    Vec2Batch(
+        const Vec2<float>* points,
+        size_t             count );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Replaces the points with a copy of others
+    //
+    // @param points: points to copy
+    // @param count: number of points
+    void Assign(
+        const Vec2<float>* points,
+        size_t             count );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Changes the number of points, added points are zero
+    //
+    // @param count: number of points
+    void Resize( size_t count );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Sets one point, does NOT check bounds
+    //
+    // @param i: index of the point
+    // @param point: its new value
+    void Set(
+        size_t             i,
+        const Vec2<float>& point ) noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns one point, does NOT check bounds
+    //
+    // @param i: index of the point
+    Vec2<float> Get( size_t i ) const noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes every point moved by a transform to a batch, which
+    //      may be this one
+    //
+    // @param transform: transform to apply
+    // @param out: batch to write, resized to match
+    void Transform(
+        const Affine2<float>& transform,
+        Vec2Batch&            out ) const;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Writes every point moved by a transform in fixed point,
+    //      ready for the rasterizers. Coordinates are rounded to the
+    //      nearest step, halves to even, and clamped to +-maxFixed
+    //
+    // @param transform: transform to apply
+    // @param fractionBits: bits below the point, 0 for whole pixels
+    //      or HalfSpace::subpixelBits for 28.4
+    // @param out: GetSize() points to write
+    void TransformToFixed(
+        const Affine2<float>& transform,
+        int                   fractionBits,
+        Vec2<int>*            out ) const noexcept;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns every x, GetSize() of them
+    float* GetX() noexcept;
+    const float* GetX() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns every y, GetSize() of them
+    float* GetY() noexcept;
+    const float* GetY() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of points
+    size_t GetSize() const noexcept;
+
+public:
+    // Far enough from the limits of int that edge setup can't overflow either
+    static constexpr float maxFixed = 67108864.0f;
+
+private:
+    std::vector<float> xs;
+    std::vector<float> ys;
+};
\ No newline at end of file
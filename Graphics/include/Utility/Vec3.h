@@ -0,0 +1,92 @@
+#pragma once
+#include "Utility/Vec2.h"
+
+//////////////////////////////////////////////////////////////////
+// @brief 3 dimensional vector with x, y and z, also a 2D point in
+//      homogeneous coordinates when z is 1
+template <typename T>
+struct Vec3
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a zero vector
+    constexpr Vec3() : x( 0 ), y( 0 ), z( 0 ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a 3D vector
+    //
+    // @param x: x coordinate of the vector
+    // @param y: y coordinate of the vector
+    // @param z: z coordinate of the vector
+    constexpr Vec3( T x, T y, T z ) : x( x ), y( y ), z( z ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a 3D vector from a 2D one
+    //
+    // @param xy: x and y coordinates of the vector
+    // @param z: z coordinate of the vector
+    constexpr Vec3( const Vec2<T>& xy, T z ) : x( xy.x ), y( xy.y ), z( z ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if every coordinate matches
+    //
+    // @param rhs: vector to compare with
+    constexpr bool operator==( const Vec3<T>& rhs ) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if any coordinate differs
+    //
+    // @param rhs: vector to compare with
+    constexpr bool operator!=( const Vec3<T>& rhs ) const { return !( *this == rhs ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the sum or difference of two vectors
+    //
+    // @param rhs: vector to add or subtract
+    constexpr Vec3<T> operator+( const Vec3<T>& rhs ) const { return Vec3<T>( x + rhs.x, y + rhs.y, z + rhs.z ); }
+    constexpr Vec3<T> operator-( const Vec3<T>& rhs ) const { return Vec3<T>( x - rhs.x, y - rhs.y, z - rhs.z ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the vector pointing the other way
+    constexpr Vec3<T> operator-() const { return Vec3<T>( -x, -y, -z ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the vector scaled or divided by a number
+    //
+    // @param scale: number to scale or divide by
+    constexpr Vec3<T> operator*( T scale ) const { return Vec3<T>( x * scale, y * scale, z * scale ); }
+    constexpr Vec3<T> operator/( T scale ) const { return Vec3<T>( x / scale, y / scale, z / scale ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Adds, subtracts or scales in place
+    //
+    // @param rhs: vector or number to apply
+    constexpr Vec3<T>& operator+=( const Vec3<T>& rhs ) { return *this = *this + rhs; }
+    constexpr Vec3<T>& operator-=( const Vec3<T>& rhs ) { return *this = *this - rhs; }
+    constexpr Vec3<T>& operator*=( T scale ) { return *this = *this * scale; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the dot product
+    //
+    // @param rhs: vector to multiply with
+    constexpr T Dot( const Vec3<T>& rhs ) const { return x * rhs.x + y * rhs.y + z * rhs.z; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the cross product, perpendicular to both vectors
+    //
+    // @param rhs: vector to multiply with
+    constexpr Vec3<T> Cross( const Vec3<T>& rhs ) const { return Vec3<T>( y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the squared length, exact for whole numbers
+    constexpr T LengthSquared() const { return Dot( *this ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns x and y
+    constexpr Vec2<T> GetXY() const { return Vec2<T>( x, y ); }
+
+public:
+    T x;
+    T y;
+    T z;
+};
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include "Utility/Vec3.h"
+
+//////////////////////////////////////////////////////////////////
+// @brief 4 dimensional vector with x, y, z and w, also a 3D point
+//      in homogeneous coordinates
+template <typename T>
+struct Vec4
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a zero vector
+    constexpr Vec4() : x( 0 ), y( 0 ), z( 0 ), w( 0 ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a 4D vector
+    //
+    // @param x: x coordinate of the vector
+    // @param y: y coordinate of the vector
+    // @param z: z coordinate of the vector
+    // @param w: w coordinate of the vector
+    constexpr Vec4( T x, T y, T z, T w ) : x( x ), y( y ), z( z ), w( w ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Constructs a 4D vector from a 3D one
+    //
+    // @param xyz: x, y and z coordinates of the vector
+    // @param w: w coordinate of the vector, 1 for a point and 0 for a
+    //      direction
+    constexpr Vec4( const Vec3<T>& xyz, T w ) : x( xyz.x ), y( xyz.y ), z( xyz.z ), w( w ) {}
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if every coordinate matches
+    //
+    // @param rhs: vector to compare with
+    constexpr bool operator==( const Vec4<T>& rhs ) const { return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns true if any coordinate differs
+    //
+    // @param rhs: vector to compare with
+    constexpr bool operator!=( const Vec4<T>& rhs ) const { return !( *this == rhs ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the sum or difference of two vectors
+    //
+    // @param rhs: vector to add or subtract
+    constexpr Vec4<T> operator+( const Vec4<T>& rhs ) const { return Vec4<T>( x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w ); }
+    constexpr Vec4<T> operator-( const Vec4<T>& rhs ) const { return Vec4<T>( x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the vector pointing the other way
+    constexpr Vec4<T> operator-() const { return Vec4<T>( -x, -y, -z, -w ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the vector scaled or divided by a number
+    //
+    // @param scale: number to scale or divide by
+    constexpr Vec4<T> operator*( T scale ) const { return Vec4<T>( x * scale, y * scale, z * scale, w * scale ); }
+    constexpr Vec4<T> operator/( T scale ) const { return Vec4<T>( x / scale, y / scale, z / scale, w / scale ); }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Adds, subtracts or scales in place
+    //
+    // @param rhs: vector or number to apply
+    constexpr Vec4<T>& operator+=( const Vec4<T>& rhs ) { return *this = *this + rhs; }
+    constexpr Vec4<T>& operator-=( const Vec4<T>& rhs ) { return *this = *this - rhs; }
+    constexpr Vec4<T>& operator*=( T scale ) { return *this = *this * scale; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the dot product
+    //
+    // @param rhs: vector to multiply with
+    constexpr T Dot( const Vec4<T>& rhs ) const { return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w; }
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns x, y and z
+    constexpr Vec3<T> GetXYZ() const { return Vec3<T>( x, y, z ); }
+
+public:
+    T x;
+    T y;
+    T z;
+    T w;
+};
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include "Windows/Win.h"
+#include "Graphics/Presenter.h"
+
+//////////////////////////////////////////////////////////////////
+// @brief Presents frames to a window's client area through GDI
+class GdiPresenter : public Presenter
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Acquires the device context of a window
+    //
+    // @param hWindow: a Windows window handle
+    GdiPresenter( HWND hWindow );
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Copy constructor is deleted, owns the device context
+    GdiPresenter( const GdiPresenter& ) = delete;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Releases the device context
+    ~GdiPresenter();
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Assignment operator is deleted, owns the device context
+    GdiPresenter& operator=( const GdiPresenter& ) = delete;
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws the frame to the window with StretchDIBits
+    //
+    // @param frame: finished frame to display
+    void Present( const Framebuffer& frame ) override;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Draws only the changed regions of the frame to the 
+    //      window, one StretchDIBits call per rectangle
+    //
+    // @param frame: finished frame to display
+    // @param rects: regions of the frame that changed
+    void PresentRegion( 
+        const Framebuffer&       frame, 
+        const std::vector<Rect>& rects ) override;
+
+private:
+    HWND hWnd;
+    HDC hdc;
+    BITMAPINFO bitmap = {};
+};
\ No newline at end of file
@@ -0,0 +1,354 @@
+#include "Graphics/Blend.h"
+#include "Graphics/SpanFill.h"
+#include "Utility/Simd.h"
+#ifdef GFX_X86
+#include <immintrin.h>
+#endif
+
+/* ======================================================================================================= */
+/*                           Kernels                                                                       */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// Rounds x / 255 exactly for any product of two bytes using only
+//      adds and shifts, the vector kernels do the same per lane
+static inline uint32_t Div255( uint32_t x ) noexcept
+{
+    x += 128u;
+    return ( x + ( x >> 8 ) ) >> 8;
+}
+
+//////////////////////////////////////////////////////////////////
+// Blends one pixel at a time, also finishes the vector tails
+static inline void BlendScalar(
+    uint32_t*    dst,
+    size_t       count,
+    const Paint& paint ) noexcept
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        uint32_t out = 0u;
+        for ( int c = 0; c < 4; ++c )
+        {
+            const uint32_t scale = static_cast<uint32_t>( paint.scale >> ( c * 16 ) ) & 0xFFFFu;
+            const uint32_t value = Div255( ( ( dst[i] >> ( c * 8 ) ) & 0xFFu ) * scale ) + ( ( paint.offset >> ( c * 8 ) ) & 0xFFu );
+            out |= ( value > 255u ? 255u : value ) << ( c * 8 );
+        }
+        dst[i] = out;
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Blends pixels of their own color one at a time, also finishes the
+//      vector tails
+static inline void ColorsScalar(
+    uint32_t*       dst,
+    const uint32_t* colors,
+    size_t          count,
+    BlendMode       mode ) noexcept
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        const uint32_t alpha = colors[i] >> 24;
+        if ( mode == BlendMode::SRC_OVER && alpha == 255u )
+            dst[i] = colors[i];
+        else if ( alpha != 0u )
+            BlendScalar( dst + i, 1u, Paint( colors[i], mode ) );
+    }
+}
+
+#ifdef GFX_X86
+//////////////////////////////////////////////////////////////////
+// Blends 4 pixels per iteration, two at a time widened to 16 bits
+static void BlendSse2(
+    uint32_t*    dst,
+    size_t       count,
+    const Paint& paint ) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16( 128 );
+    const __m128i scale = _mm_set1_epi64x( static_cast<long long>( paint.scale ) );
+    const __m128i offset = _mm_set1_epi32( static_cast<int>( paint.offset ) );
+
+    for ( ; count >= 4u; count -= 4u, dst += 4 )
+    {
+        __m128i* p = reinterpret_cast<__m128i*>( dst );
+        const __m128i pixels = _mm_loadu_si128( p );
+
+        // Products of two bytes fit in 16 bits, so the division by 255 stays in 16 bit lanes
+        __m128i lo = _mm_add_epi16( _mm_mullo_epi16( _mm_unpacklo_epi8( pixels, zero ), scale ), round );
+        __m128i hi = _mm_add_epi16( _mm_mullo_epi16( _mm_unpackhi_epi8( pixels, zero ), scale ), round );
+        lo = _mm_srli_epi16( _mm_add_epi16( lo, _mm_srli_epi16( lo, 8 ) ), 8 );
+        hi = _mm_srli_epi16( _mm_add_epi16( hi, _mm_srli_epi16( hi, 8 ) ), 8 );
+
+        _mm_storeu_si128( p, _mm_adds_epu8( _mm_packus_epi16( lo, hi ), offset ) );
+    }
+
+    BlendScalar( dst, count, paint );
+}
+
+//////////////////////////////////////////////////////////////////
+// Blends 8 pixels per iteration, four at a time widened to 16 bits
+GFX_TARGET_AVX2 static void BlendAvx2(
+    uint32_t*    dst,
+    size_t       count,
+    const Paint& paint ) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16( 128 );
+    const __m256i scale = _mm256_set1_epi64x( static_cast<long long>( paint.scale ) );
+    const __m256i offset = _mm256_set1_epi32( static_cast<int>( paint.offset ) );
+
+    for ( ; count >= 8u; count -= 8u, dst += 8 )
+    {
+        __m256i* p = reinterpret_cast<__m256i*>( dst );
+        const __m256i pixels = _mm256_loadu_si256( p );
+
+        // Unpacking and packing both work within 128 bit lanes, so pixels come back in order
+        __m256i lo = _mm256_add_epi16( _mm256_mullo_epi16( _mm256_unpacklo_epi8( pixels, zero ), scale ), round );
+        __m256i hi = _mm256_add_epi16( _mm256_mullo_epi16( _mm256_unpackhi_epi8( pixels, zero ), scale ), round );
+        lo = _mm256_srli_epi16( _mm256_add_epi16( lo, _mm256_srli_epi16( lo, 8 ) ), 8 );
+        hi = _mm256_srli_epi16( _mm256_add_epi16( hi, _mm256_srli_epi16( hi, 8 ) ), 8 );
+
+        _mm256_storeu_si256( p, _mm256_adds_epu8( _mm256_packus_epi16( lo, hi ), offset ) );
+    }
+
+    BlendScalar( dst, count, paint );
+}
+
+//////////////////////////////////////////////////////////////////
+// Source over blends 4 pixels of their own color per iteration, the
+//      same sums a Paint of each color makes with its alpha spread to
+//      every channel. Transparent pixels keep the surface as it was
+static void ColorsOverSse2(
+    uint32_t*       dst,
+    const uint32_t* colors,
+    size_t          count ) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16( 128 );
+    const __m128i full = _mm_set1_epi16( 255 );
+    const __m128i opaque = _mm_set1_epi32( static_cast<int>( 0xFF000000u ) );
+
+    for ( ; count >= 4u; count -= 4u, dst += 4, colors += 4 )
+    {
+        __m128i* p = reinterpret_cast<__m128i*>( dst );
+        const __m128i src = _mm_loadu_si128( reinterpret_cast<const __m128i*>( colors ) );
+        const __m128i pixels = _mm_loadu_si128( p );
+
+        // Both products are of two bytes and divided by 255 the same way as a span, their sum saturates
+        // when packed back to bytes
+        __m128i blended[2];
+        for ( int h = 0; h < 2; ++h )
+        {
+            const __m128i color = h ? _mm_unpackhi_epi8( src, zero ) : _mm_unpacklo_epi8( src, zero );
+            const __m128i surface = h ? _mm_unpackhi_epi8( pixels, zero ) : _mm_unpacklo_epi8( pixels, zero );
+            const __m128i alpha = _mm_shufflehi_epi16( _mm_shufflelo_epi16( color, 0xFF ), 0xFF );
+            __m128i over = _mm_add_epi16( _mm_mullo_epi16( color, alpha ), round );
+            __m128i under = _mm_add_epi16( _mm_mullo_epi16( surface, _mm_sub_epi16( full, alpha ) ), round );
+            over = _mm_srli_epi16( _mm_add_epi16( over, _mm_srli_epi16( over, 8 ) ), 8 );
+            under = _mm_srli_epi16( _mm_add_epi16( under, _mm_srli_epi16( under, 8 ) ), 8 );
+            blended[h] = _mm_add_epi16( over, under );
+        }
+        const __m128i result = _mm_or_si128( _mm_packus_epi16( blended[0], blended[1] ), opaque );
+
+        const __m128i transparent = _mm_cmpeq_epi32( _mm_srli_epi32( src, 24 ), zero );
+        _mm_storeu_si128( p, _mm_or_si128( _mm_and_si128( transparent, pixels ), _mm_andnot_si128( transparent, result ) ) );
+    }
+
+    ColorsScalar( dst, colors, count, BlendMode::SRC_OVER );
+}
+
+//////////////////////////////////////////////////////////////////
+// Source over blends 8 pixels of their own color per iteration
+GFX_TARGET_AVX2 static void ColorsOverAvx2(
+    uint32_t*       dst,
+    const uint32_t* colors,
+    size_t          count ) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16( 128 );
+    const __m256i full = _mm256_set1_epi16( 255 );
+    const __m256i opaque = _mm256_set1_epi32( static_cast<int>( 0xFF000000u ) );
+
+    for ( ; count >= 8u; count -= 8u, dst += 8, colors += 8 )
+    {
+        __m256i* p = reinterpret_cast<__m256i*>( dst );
+        const __m256i src = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( colors ) );
+        const __m256i pixels = _mm256_loadu_si256( p );
+
+        // Unpacking and packing both work within 128 bit lanes, so pixels come back in order
+        __m256i blended[2];
+        for ( int h = 0; h < 2; ++h )
+        {
+            const __m256i color = h ? _mm256_unpackhi_epi8( src, zero ) : _mm256_unpacklo_epi8( src, zero );
+            const __m256i surface = h ? _mm256_unpackhi_epi8( pixels, zero ) : _mm256_unpacklo_epi8( pixels, zero );
+            const __m256i alpha = _mm256_shufflehi_epi16( _mm256_shufflelo_epi16( color, 0xFF ), 0xFF );
+            __m256i over = _mm256_add_epi16( _mm256_mullo_epi16( color, alpha ), round );
+            __m256i under = _mm256_add_epi16( _mm256_mullo_epi16( surface, _mm256_sub_epi16( full, alpha ) ), round );
+            over = _mm256_srli_epi16( _mm256_add_epi16( over, _mm256_srli_epi16( over, 8 ) ), 8 );
+            under = _mm256_srli_epi16( _mm256_add_epi16( under, _mm256_srli_epi16( under, 8 ) ), 8 );
+            blended[h] = _mm256_add_epi16( over, under );
+        }
+        const __m256i result = _mm256_or_si256( _mm256_packus_epi16( blended[0], blended[1] ), opaque );
+
+        const __m256i transparent = _mm256_cmpeq_epi32( _mm256_srli_epi32( src, 24 ), zero );
+        _mm256_storeu_si256( p, _mm256_blendv_epi8( result, pixels, transparent ) );
+    }
+
+    ColorsScalar( dst, colors, count, BlendMode::SRC_OVER );
+}
+#endif
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Paint                                                                */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Precomputes the constants of a blend
+Paint::Paint(
+    uint32_t  color,
+    BlendMode mode ) noexcept
+    :
+    color( color ),
+    replace( mode == BlendMode::SRC_OVER && ( color >> 24 ) == 255u ),
+    invisible( ( color >> 24 ) == 0u ),
+    scale( 0u ),
+    offset( 0u )
+{
+    const uint32_t alpha = color >> 24;
+    for ( int c = 0; c < 3; ++c )
+    {
+        const uint32_t channel = ( color >> ( c * 8 ) ) & 0xFFu;
+        const uint32_t premultiplied = Div255( channel * alpha );
+
+        uint32_t channelScale = 0u, channelOffset = 0u;
+        switch ( mode )
+        {
+        case BlendMode::SRC_OVER:
+            channelScale = 255u - alpha;
+            channelOffset = premultiplied;
+            break;
+        case BlendMode::ADDITIVE:
+            channelScale = 255u;
+            channelOffset = premultiplied;
+            break;
+        case BlendMode::MULTIPLY:
+            // Lerp between the surface and the surface times the color, dst * ( c * a + 255 - a ) / 255
+            channelScale = premultiplied + 255u - alpha;
+            break;
+        }
+        scale |= static_cast<uint64_t>( channelScale ) << ( c * 16 );
+        offset |= channelOffset << ( c * 8 );
+    }
+
+    // The surface is always opaque, a zero scale and full offset keeps its alpha that way
+    offset |= 0xFF000000u;
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Blend                                                                */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Blends a paint into a run of pixels
+void Blend::Span(
+    uint32_t*    dst,
+    size_t       count,
+    const Paint& paint ) noexcept
+{
+    if ( paint.replace )
+        return SpanFill::Fill( dst, count, paint.color );
+    if ( paint.invisible )
+        return;
+
+#ifdef GFX_X86
+    switch ( Simd::GetLevel() )
+    {
+    case Simd::Level::AVX2: return BlendAvx2( dst, count, paint );
+    case Simd::Level::SSE2: return BlendSse2( dst, count, paint );
+    default: break;
+    }
+#endif
+    BlendScalar( dst, count, paint );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Blends a run of pixels that each have their own color
+void Blend::Colors(
+    uint32_t*       dst,
+    const uint32_t* colors,
+    size_t          count,
+    BlendMode       mode ) noexcept
+{
+    // Only source over has one sum for every alpha, the other modes make a paint per pixel
+#ifdef GFX_X86
+    if ( mode == BlendMode::SRC_OVER )
+    {
+        switch ( Simd::GetLevel() )
+        {
+        case Simd::Level::AVX2: return ColorsOverAvx2( dst, colors, count );
+        case Simd::Level::SSE2: return ColorsOverSse2( dst, colors, count );
+        default: break;
+        }
+    }
+#endif
+    ColorsScalar( dst, colors, count, mode );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Blends one color into a run of pixels that each cover a
+//          fraction of it
+void Blend::Coverage(
+    uint32_t*      dst,
+    const uint8_t* coverage,
+    size_t         count,
+    uint32_t       color,
+    BlendMode      mode ) noexcept
+{
+    const Paint full( color, mode );
+    if ( full.invisible )
+        return;
+
+    for ( size_t i = 0; i < count; )
+    {
+        // Covered runs are the inside of wide lines, blend them like any other span
+        if ( coverage[i] == 255u )
+        {
+            const size_t start = i;
+            while ( i < count && coverage[i] == 255u )
+                ++i;
+            Span( dst + start, i - start, full );
+            continue;
+        }
+
+        // Blending with the alpha scaled by the coverage is the same as moving that far from the pixel
+        // towards it fully blended, two channels at a time in 16 bit lanes
+        const uint32_t weight = coverage[i];
+        if ( weight != 0u )
+        {
+            const uint32_t to = Pixel( dst[i], full ), from = dst[i];
+            uint32_t rb = ( from & 0x00FF00FFu ) * ( 255u - weight ) + ( to & 0x00FF00FFu ) * weight + 0x00800080u;
+            uint32_t ag = ( ( from >> 8 ) & 0x00FF00FFu ) * ( 255u - weight ) + ( ( to >> 8 ) & 0x00FF00FFu ) * weight + 0x00800080u;
+            rb = ( ( rb + ( ( rb >> 8 ) & 0x00FF00FFu ) ) >> 8 ) & 0x00FF00FFu;
+            ag = ( ( ag + ( ( ag >> 8 ) & 0x00FF00FFu ) ) >> 8 ) & 0x00FF00FFu;
+            dst[i] = rb | ( ag << 8 );
+        }
+        ++i;
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a single pixel with a paint blended into it
+uint32_t Blend::Pixel(
+    uint32_t     dst,
+    const Paint& paint ) noexcept
+{
+    if ( paint.replace )
+        return paint.color;
+    if ( paint.invisible )
+        return dst;
+
+    BlendScalar( &dst, 1u, paint );
+    return dst;
+}
@@ -0,0 +1,165 @@
+#include "Graphics/DepthBuffer.h"
+#include "Utility/Simd.h"
+#include <algorithm>
+#include <cassert>
+#ifdef GFX_X86
+#include <immintrin.h>
+#endif
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] DepthBuffer                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Allocates depth for every pixel of a surface
+DepthBuffer::DepthBuffer(
+    int width,
+    int height )
+    :
+    width( width ),
+    height( height ),
+    pitch( ( width + 15 ) / 16 * 16 ),
+    blocksX( ( width + blockSize - 1 ) / blockSize ),
+    blocksY( ( height + blockSize - 1 ) / blockSize ),
+    tilesX( ( width + tileSize - 1 ) / tileSize ),
+    tilesY( ( height + tileSize - 1 ) / tileSize ),
+    depths( static_cast<size_t>( pitch ) * height ),
+    blockMin( static_cast<size_t>( blocksX ) * blocksY ),
+    blockMax( static_cast<size_t>( blocksX ) * blocksY ),
+    tileMax( static_cast<size_t>( tilesX ) * tilesY ),
+    tileStale( static_cast<size_t>( tilesX ) * tilesY )
+{
+    assert( width >= 0 && height >= 0 );
+    Clear();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Sets every depth, including the coarse levels
+void DepthBuffer::Clear( float value ) noexcept
+{
+    std::fill( depths.begin(), depths.end(), value );
+    std::fill( blockMin.begin(), blockMin.end(), value );
+    std::fill( blockMax.begin(), blockMax.end(), value );
+    std::fill( tileMax.begin(), tileMax.end(), value );
+    std::fill( tileStale.begin(), tileStale.end(), uint8_t( 0u ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Recomputes the nearest and farthest depth of a block
+void DepthBuffer::UpdateBlock(
+    int blockX,
+    int blockY ) noexcept
+{
+    // Blocks on the right and top edges only count the pixels on the surface
+    const int left = blockX * blockSize, right = std::min( left + blockSize, width );
+    const int bottom = blockY * blockSize, top = std::min( bottom + blockSize, height );
+
+    float nearest, farthest;
+#ifdef GFX_X86
+    if ( right - left == blockSize && Simd::GetLevel() != Simd::Level::SCALAR )
+    {
+        // Whole blocks reduce two halves of every row at once
+        __m128 lo = _mm_loadu_ps( GetRow( bottom ) + left ), hi = lo;
+        for ( int y = bottom; y < top; ++y )
+        {
+            const __m128 a = _mm_loadu_ps( GetRow( y ) + left ), b = _mm_loadu_ps( GetRow( y ) + left + 4 );
+            lo = _mm_min_ps( lo, _mm_min_ps( a, b ) );
+            hi = _mm_max_ps( hi, _mm_max_ps( a, b ) );
+        }
+        lo = _mm_min_ps( lo, _mm_shuffle_ps( lo, lo, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+        hi = _mm_max_ps( hi, _mm_shuffle_ps( hi, hi, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+        nearest = _mm_cvtss_f32( _mm_min_ss( lo, _mm_shuffle_ps( lo, lo, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) );
+        farthest = _mm_cvtss_f32( _mm_max_ss( hi, _mm_shuffle_ps( hi, hi, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) );
+    }
+    else
+#endif
+    {
+        nearest = farthest = GetRow( bottom )[left];
+        for ( int y = bottom; y < top; ++y )
+        {
+            const float* row = GetRow( y );
+            for ( int x = left; x < right; ++x )
+            {
+                nearest = row[x] < nearest ? row[x] : nearest;
+                farthest = row[x] > farthest ? row[x] : farthest;
+            }
+        }
+    }
+
+    const size_t index = static_cast<size_t>( blockY ) * blocksX + blockX;
+    const size_t tile = static_cast<size_t>( blockY / blocksPerTile ) * tilesX + blockX / blocksPerTile;
+    if ( farthest < blockMax[index] && blockMax[index] == tileMax[tile] )
+        tileStale[tile] = 1u;
+
+    blockMin[index] = nearest;
+    blockMax[index] = farthest;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Recomputes the farthest depth of a tile from its blocks
+void DepthBuffer::UpdateTile(
+    int tileX,
+    int tileY ) noexcept
+{
+    const size_t tile = static_cast<size_t>( tileY ) * tilesX + tileX;
+    if ( !tileStale[tile] )
+        return;
+
+    const int left = tileX * blocksPerTile, right = std::min( left + blocksPerTile, blocksX );
+    const int bottom = tileY * blocksPerTile, top = std::min( bottom + blocksPerTile, blocksY );
+
+    float farthest = blockMax[static_cast<size_t>( bottom ) * blocksX + left];
+    for ( int y = bottom; y < top; ++y )
+        for ( int x = left; x < right; ++x )
+            farthest = std::max( farthest, blockMax[static_cast<size_t>( y ) * blocksX + x] );
+
+    tileMax[tile] = farthest;
+    tileStale[tile] = 0u;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of the surface in pixels
+int DepthBuffer::GetWidth() const noexcept { return width; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the height of the surface in pixels
+int DepthBuffer::GetHeight() const noexcept { return height; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the distance between rows in depths
+int DepthBuffer::GetPitch() const noexcept { return pitch; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a pointer to the first depth of a row
+float* DepthBuffer::GetRow( int y ) noexcept { return depths.data() + static_cast<size_t>( y ) * pitch; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a pointer to the first depth of a row
+const float* DepthBuffer::GetRow( int y ) const noexcept { return depths.data() + static_cast<size_t>( y ) * pitch; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the nearest depth in a block
+float DepthBuffer::GetBlockMin(
+    int blockX,
+    int blockY ) const noexcept
+{
+    return blockMin[static_cast<size_t>( blockY ) * blocksX + blockX];
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the farthest depth in a block
+float DepthBuffer::GetBlockMax(
+    int blockX,
+    int blockY ) const noexcept
+{
+    return blockMax[static_cast<size_t>( blockY ) * blocksX + blockX];
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the farthest depth in a tile
+float DepthBuffer::GetTileMax(
+    int tileX,
+    int tileY ) const noexcept
+{
+    return tileMax[static_cast<size_t>( tileY ) * tilesX + tileX];
+}
@@ -0,0 +1,137 @@
+#include "Graphics/DirtyRegion.h"
+#include <algorithm>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] DirtyRegion                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Constructs a clean region covering a surface
+DirtyRegion::DirtyRegion( 
+    int width, 
+    int height )
+    :
+    width( width ),
+    height( height ),
+    tilesX( ( width + tileSize - 1 ) / tileSize ),
+    tilesY( ( height + tileSize - 1 ) / tileSize ),
+    tiles( static_cast<size_t>( tilesX ) * tilesY, 0u )
+{}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Marks every tile a rectangle touches
+void DirtyRegion::Add( const Rect& rect ) noexcept
+{
+    const Rect visible = rect.Intersect( Rect( 0, 0, width, height ) );
+    if ( visible.IsEmpty() || markedCount == tiles.size() )
+        return;
+
+    const int tileLeft = visible.left / tileSize, tileRight = ( visible.right - 1 ) / tileSize;
+    const int tileBottom = visible.bottom / tileSize, tileTop = ( visible.top - 1 ) / tileSize;
+    for ( int ty = tileBottom; ty <= tileTop; ++ty )
+    {
+        uint8_t* row = tiles.data() + static_cast<size_t>( ty ) * tilesX;
+        for ( int tx = tileLeft; tx <= tileRight; ++tx )
+        {
+            markedCount += row[tx] ^ 1u;
+            row[tx] = 1u;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Marks the whole surface
+void DirtyRegion::AddAll() noexcept
+{
+    std::fill( tiles.begin(), tiles.end(), uint8_t( 1u ) );
+    markedCount = tiles.size();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Marks every tile marked in another region over the same
+//          surface
+void DirtyRegion::Merge( const DirtyRegion& rhs ) noexcept
+{
+    // Regions over different surfaces can't be lined up, fall back to everything
+    if ( rhs.width != width || rhs.height != height )
+        return AddAll();
+
+    markedCount = 0u;
+    for ( size_t i = 0; i < tiles.size(); ++i )
+    {
+        tiles[i] |= rhs.tiles[i];
+        markedCount += tiles[i];
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Marks every tile as clean
+void DirtyRegion::Reset() noexcept
+{
+    if ( markedCount == 0u )
+        return;
+
+    std::fill( tiles.begin(), tiles.end(), uint8_t( 0u ) );
+    markedCount = 0u;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if no tile is marked
+bool DirtyRegion::IsEmpty() const noexcept { return markedCount == 0u; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the fraction of tiles that are marked
+float DirtyRegion::GetCoverage() const noexcept
+{
+    return tiles.empty() ? 0.0f : static_cast<float>( markedCount ) / static_cast<float>( tiles.size() );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Converts the marked tiles into as few rectangles as the
+//          tile rows allow
+void DirtyRegion::GetRects( std::vector<Rect>& rects ) const
+{
+    rects.clear();
+    if ( markedCount == 0u )
+        return;
+
+    // Runs of marked tiles in each row, a run that exactly matches an open one in the row below grows it
+    std::vector<Rect> open, next;
+    for ( int ty = 0; ty < tilesY; ++ty )
+    {
+        const uint8_t* row = tiles.data() + static_cast<size_t>( ty ) * tilesX;
+        const int bottom = ty * tileSize, top = std::min( bottom + tileSize, height );
+
+        next.clear();
+        size_t o = 0u;
+        for ( int tx = 0; tx < tilesX; )
+        {
+            if ( !row[tx] )
+            {
+                ++tx;
+                continue;
+            }
+
+            const int first = tx;
+            while ( tx < tilesX && row[tx] )
+                ++tx;
+            const int left = first * tileSize, right = std::min( tx * tileSize, width );
+
+            // Both rows are sorted by left edge, anything left of this run can't grow any further
+            while ( o < open.size() && open[o].left < left )
+                rects.push_back( open[o++] );
+
+            if ( o < open.size() && open[o].left == left && open[o].right == right )
+            {
+                next.push_back( open[o++] );
+                next.back().top = top;
+            }
+            else
+                next.emplace_back( left, bottom, right, top );
+        }
+
+        rects.insert( rects.end(), open.begin() + o, open.end() );
+        std::swap( open, next );
+    }
+    rects.insert( rects.end(), open.begin(), open.end() );
+}
@@ -0,0 +1,152 @@
+#include "Graphics/DisplayList.h"
+#include "Graphics/SpanFill.h"
+#include <algorithm>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] DisplayList                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Removes every recorded draw call
+void DisplayList::Clear() noexcept
+{
+    commands.clear();
+    bounds = Rect();
+    ++version;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a draw call at the end of the list
+void DisplayList::Append( const DrawCommand& command )
+{
+    if ( command.bounds.IsEmpty() )
+        return;
+
+    bounds = commands.empty() ? command.bounds : Rect(
+        std::min( bounds.left, command.bounds.left ),
+        std::min( bounds.bottom, command.bounds.bottom ),
+        std::max( bounds.right, command.bounds.right ),
+        std::max( bounds.top, command.bounds.top ) );
+    commands.push_back( command );
+    ++version;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills the cached runs into a surface, building them 
+//          first if the list has been replayed unchanged before
+bool DisplayList::ReplayCached( Framebuffer& frame ) const
+{
+    if ( runsVersion != version || runsWidth != frame.GetWidth() || runsHeight != frame.GetHeight() )
+    {
+        // A list drawn once may be edited straight away, only pay for the runs on the second replay
+        if ( replayedVersion != version )
+        {
+            replayedVersion = version;
+            return false;
+        }
+        BuildRuns( frame.GetWidth(), frame.GetHeight() );
+    }
+
+    if ( !runsUsable )
+        return false;
+
+    for ( const Run& run : runs )
+        SpanFill::Fill( frame.GetRow( run.y ) + run.left, static_cast<size_t>( run.right - run.left ), run.color );
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the recorded draw calls in order
+const std::vector<DrawCommand>& DisplayList::GetCommands() const noexcept { return commands; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the union of the bounds of every draw call
+const Rect& DisplayList::GetBounds() const noexcept { return bounds; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a counter that changes whenever the list is 
+//          edited
+uint64_t DisplayList::GetVersion() const noexcept { return version; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if replays currently fill cached runs
+bool DisplayList::IsCached() const noexcept { return runsVersion == version && runsUsable; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] DisplayList                                                         */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Rasterizes the list and keeps the pixels it writes as 
+//           runs of constant color
+void DisplayList::BuildRuns(
+    int width,
+    int height ) const
+{
+    runs.clear();
+    runsVersion = version;
+    runsWidth = width;
+    runsHeight = height;
+    runsUsable = false;
+
+    // Depth tested output depends on the depth buffer it is replayed against, a shader may combine
+    // with the background in any way at all and textures, images and sprites rarely leave runs worth
+    // caching, the caller may also change their pixels between replays. Anything
+    // blended or anti-aliased depends on the background too, runs can only hold what was overwritten
+    for ( const DrawCommand& command : commands )
+    {
+        const Paint paint( command.color, command.blend );
+        if ( command.type == DrawCommand::Type::TRIANGLE_DEPTH || command.type == DrawCommand::Type::TRIANGLE_SHADED ||
+             command.type == DrawCommand::Type::TRIANGLE_TEXTURED || command.type == DrawCommand::Type::IMAGE ||
+             command.type == DrawCommand::Type::SPRITE || ( command.type == DrawCommand::Type::STROKE && command.antialias ) ||
+             ( !paint.replace && !paint.invisible ) )
+            return;
+    }
+
+    const Rect area = bounds.Intersect( Rect( 0, 0, width, height ) );
+    if ( area.IsEmpty() )
+    {
+        runsUsable = true;
+        return;
+    }
+
+    // Draw over two different backgrounds, a pixel that comes out the same in both was written
+    const size_t areaWidth = static_cast<size_t>( area.right - area.left );
+    Framebuffer first( width, height ), second( width, height );
+    for ( int y = area.bottom; y < area.top; ++y )
+    {
+        SpanFill::Fill( first.GetRow( y ) + area.left, areaWidth, 0x00000000u );
+        SpanFill::Fill( second.GetRow( y ) + area.left, areaWidth, 0xFFFFFFFFu );
+    }
+    for ( const DrawCommand& command : commands )
+    {
+        command.Execute( first, area );
+        command.Execute( second, area );
+    }
+
+    size_t pixels = 0u;
+    for ( int y = area.bottom; y < area.top; ++y )
+    {
+        const uint32_t* a = first.GetRow( y );
+        const uint32_t* b = second.GetRow( y );
+        for ( int x = area.left; x < area.right; )
+        {
+            if ( a[x] != b[x] )
+            {
+                ++x;
+                continue;
+            }
+
+            const int left = x;
+            while ( x < area.right && a[x] == b[x] && a[x] == a[left] )
+                ++x;
+            runs.push_back( { y, left, x, a[left] } );
+            pixels += static_cast<size_t>( x - left );
+        }
+    }
+
+    // Fragmented output is cheaper to rasterize again than to fill pixel by pixel
+    runsUsable = runs.size() * minAverageRun <= pixels;
+    if ( !runsUsable )
+        runs = std::vector<Run>();
+}
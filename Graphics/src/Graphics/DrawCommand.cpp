@@ -0,0 +1,285 @@
+#include "Graphics/DrawCommand.h"
+#include "Graphics/Rasterizer.h"
+#include "Graphics/HalfSpace.h"
+#include "Graphics/Stroke.h"
+#include <algorithm>
+#include <utility>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] DrawCommand                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a primitive and computes the pixels it may 
+//          touch
+DrawCommand::DrawCommand(
+    Type             type,
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    uint32_t         color,
+    BlendMode        blend ) noexcept
+    :
+    type( type ),
+    color( color ),
+    blend( blend ),
+    v{ v1, v2, v3 },
+    joins{ v1, v2 }
+{
+    // Ends past the last pixel and radii reach past the range of int, such bounds are found in 64 bits and
+    // kept within it
+    auto limit = []( int64_t value ) { return static_cast<int>( std::clamp<int64_t>( value, INT32_MIN, INT32_MAX ) ); };
+    switch ( type )
+    {
+    case Type::PIXEL:
+        bounds = Rect( v1.x, v1.y, limit( int64_t( v1.x ) + 1 ), limit( int64_t( v1.y ) + 1 ) );
+        break;
+    case Type::LINE:
+        bounds = Rect( 
+            std::min( v1.x, v2.x ), std::min( v1.y, v2.y ), 
+            limit( int64_t( std::max( v1.x, v2.x ) ) + 1 ), limit( int64_t( std::max( v1.y, v2.y ) ) + 1 ) );
+        break;
+    case Type::STROKE:
+        bounds = Stroke::GetBounds( v1, v2, width );
+        break;
+    case Type::RECTANGLE:
+        bounds = Rect( std::min( v1.x, v2.x ), std::min( v1.y, v2.y ), std::max( v1.x, v2.x ), std::max( v1.y, v2.y ) );
+        break;
+    case Type::ELLIPSE:
+    case Type::ELLIPSE_FILLED:
+    {
+        const int64_t rx = std::max( v2.x, 0 ), ry = std::max( v2.y, 0 );
+        bounds = Rect( limit( v1.x - rx ), limit( v1.y - ry ), limit( v1.x + rx + 1 ), limit( v1.y + ry + 1 ) );
+        break;
+    }
+    case Type::POLYGON:
+    case Type::IMAGE:
+    case Type::SPRITE:
+    case Type::TEXT:
+        // Known once the polygon, image, sprite or text is attached
+        break;
+    case Type::TRIANGLE_SCANLINE:
+        bounds = Rect( 
+            std::min( { v1.x, v2.x, v3.x } ), std::min( { v1.y, v2.y, v3.y } ), 
+            limit( int64_t( std::max( { v1.x, v2.x, v3.x } ) ) + 1 ), limit( int64_t( std::max( { v1.y, v2.y, v3.y } ) ) + 1 ) );
+        break;
+    case Type::TRIANGLE_HALFSPACE:
+    case Type::TRIANGLE_DEPTH:
+    case Type::TRIANGLE_SHADED:
+    case Type::TRIANGLE_TEXTURED:
+        // Round outwards to whole pixels
+        bounds = Rect(
+            std::min( { v1.x, v2.x, v3.x } ) >> HalfSpace::subpixelBits,
+            std::min( { v1.y, v2.y, v3.y } ) >> HalfSpace::subpixelBits,
+            ( std::max( { v1.x, v2.x, v3.x } ) >> HalfSpace::subpixelBits ) + 1,
+            ( std::max( { v1.y, v2.y, v3.y } ) >> HalfSpace::subpixelBits ) + 1 );
+        break;
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a depth tested triangle
+DrawCommand::DrawCommand(
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const float*     z,
+    uint32_t         color,
+    BlendMode        blend ) noexcept
+    :
+    DrawCommand( Type::TRIANGLE_DEPTH, v1, v2, v3, color, blend )
+{
+    std::copy( z, z + 3, this->z );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a triangle with interpolated attributes
+DrawCommand::DrawCommand(
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const float*     z,
+    const float*     attributes,
+    int              attributeCount,
+    SpanShader       shader,
+    const void*      user,
+    BlendMode        blend ) noexcept
+    :
+    DrawCommand( Type::TRIANGLE_SHADED, v1, v2, v3, 0xFFFFFFFFu, blend )
+{
+    this->hasDepth = z != nullptr;
+    if ( z )
+        std::copy( z, z + 3, this->z );
+
+    this->attributeCount = std::clamp( attributeCount, 0, Shading::maxAttributes );
+    std::copy( attributes, attributes + this->attributeCount * 3, this->attributes );
+    this->shader = shader;
+    this->user = user;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a textured triangle
+DrawCommand::DrawCommand(
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const float*     uvw,
+    const Texture&   texture,
+    TextureFilter    filter,
+    BlendMode        blend ) noexcept
+    :
+    DrawCommand( Type::TRIANGLE_TEXTURED, v1, v2, v3, 0xFFFFFFFFu, blend )
+{
+    std::copy( uvw, uvw + 9, this->attributes );
+    this->texture = &texture;
+    this->filter = filter;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records one segment of a wide or anti-aliased line
+DrawCommand::DrawCommand(
+    const Vec2<int>& start,
+    const Vec2<int>& end,
+    const Vec2<int>& previous,
+    const Vec2<int>& next,
+    float            width,
+    bool             antialias,
+    uint32_t         color,
+    BlendMode        blend ) noexcept
+    :
+    DrawCommand( Type::STROKE, start, end, end, color, blend )
+{
+    this->joins[0] = previous;
+    this->joins[1] = next;
+    this->width = width;
+    this->antialias = antialias;
+
+    // Recorded with the default width above, wide lines reach further
+    this->bounds = Stroke::GetBounds( start, end, width );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a filled polygon
+DrawCommand::DrawCommand(
+    std::shared_ptr<const Polygon> polygon,
+    uint32_t                       color,
+    BlendMode                      blend ) noexcept
+    :
+    DrawCommand( Type::POLYGON, { 0, 0 }, { 0, 0 }, { 0, 0 }, color, blend )
+{
+    this->bounds = polygon->GetBounds();
+    this->polygon = std::move( polygon );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records an image copied onto the surface as it is
+DrawCommand::DrawCommand(
+    const ImageView& image,
+    const Vec2<int>& position ) noexcept
+    :
+    DrawCommand( Type::IMAGE, position, position, position, 0xFFFFFFFFu, BlendMode::SRC_OVER )
+{
+    this->bounds = ImageView::GetArea( position, image.width, image.height );
+    this->image = image;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a sprite
+DrawCommand::DrawCommand(
+    const Sprite&    sprite,
+    const Vec2<int>& position,
+    BlendMode        blend ) noexcept
+    :
+    DrawCommand( Type::SPRITE, position, position, position, 0xFFFFFFFFu, blend )
+{
+    this->bounds = ImageView::GetArea( position, sprite.GetWidth(), sprite.GetHeight() );
+    this->sprite = &sprite;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a string of text
+DrawCommand::DrawCommand(
+    std::shared_ptr<const TextLayout> text,
+    const Vec2<int>&                  position,
+    uint32_t                          color,
+    BlendMode                         blend ) noexcept
+    :
+    DrawCommand( Type::TEXT, position, position, position, color, blend )
+{
+    const Rect& ink = text->GetBounds();
+    this->bounds = Rect( position.x + ink.left, position.y + ink.bottom, position.x + ink.right, position.y + ink.top );
+    this->text = std::move( text );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws the primitive, only writing inside the clip 
+//          region
+void DrawCommand::Execute(
+    Framebuffer& frame,
+    const Rect&  clip,
+    DepthBuffer* depth ) const noexcept
+{
+    // Transparent commands still mark their bounds dirty but never touch a pixel, shaded and textured
+    // triangles, images and sprites record white so only their pixels decide
+    const Paint paint( color, blend );
+    if ( paint.invisible )
+        return;
+
+    switch ( type )
+    {
+    case Type::PIXEL:
+        if ( clip.Contains( v[0].x, v[0].y ) )
+        {
+            uint32_t& pixel = frame.GetRow( v[0].y )[v[0].x];
+            pixel = Blend::Pixel( pixel, paint );
+        }
+        break;
+    case Type::LINE:
+        Rasterizer::DrawLine( frame, clip, v[0], v[1], paint, joins[0] == v[0] );
+        break;
+    case Type::STROKE:
+        Stroke::DrawSegment( frame, clip, v[0], v[1], joins[0], joins[1], width, antialias, color, blend );
+        break;
+    case Type::RECTANGLE:
+        Rasterizer::FillRectangle( frame, clip, v[0], v[1], paint );
+        break;
+    case Type::ELLIPSE:
+        Rasterizer::DrawEllipse( frame, clip, v[0], v[1].x, v[1].y, paint );
+        break;
+    case Type::ELLIPSE_FILLED:
+        Rasterizer::FillEllipse( frame, clip, v[0], v[1].x, v[1].y, paint );
+        break;
+    case Type::POLYGON:
+        polygon->Fill( frame, clip, paint );
+        break;
+    case Type::IMAGE:
+        Rasterizer::CopyImage( frame, clip, image, v[0] );
+        break;
+    case Type::SPRITE:
+        sprite->Draw( frame, clip, v[0], blend );
+        break;
+    case Type::TEXT:
+        text->Draw( frame, clip, v[0], paint );
+        break;
+    case Type::TRIANGLE_SCANLINE:
+        Rasterizer::FillTriangle( frame, clip, v[0], v[1], v[2], paint );
+        break;
+    case Type::TRIANGLE_HALFSPACE:
+        HalfSpace::FillTriangle( frame, clip, v[0], v[1], v[2], paint );
+        break;
+    case Type::TRIANGLE_DEPTH:
+        if ( depth )
+            HalfSpace::FillTriangle( frame, *depth, clip, v[0], v[1], v[2], z, paint );
+        else
+            HalfSpace::FillTriangle( frame, clip, v[0], v[1], v[2], paint );
+        break;
+    case Type::TRIANGLE_SHADED:
+        HalfSpace::ShadeTriangle( 
+            frame, depth, clip, v[0], v[1], v[2], hasDepth ? z : nullptr, 
+            attributes, attributeCount, shader, user, blend );
+        break;
+    case Type::TRIANGLE_TEXTURED:
+        HalfSpace::TextureTriangle( frame, clip, v[0], v[1], v[2], attributes, *texture, filter, blend );
+        break;
+    }
+}
@@ -0,0 +1,278 @@
+#include "Graphics/Font.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+//////////////////////////////////////////////////////////////////
+// Every font and every change to one takes the next id, so glyphs
+//      and layouts cached for what a font was are never used again
+static std::atomic<uint64_t> nextId{ 1u };
+
+// The built in font covers printable ASCII, rows top to bottom with the leftmost pixel in the lowest bit.
+// Capitals stand on row 6 and descenders reach row 7
+static constexpr uint32_t builtinFirst = ' ';
+static constexpr int builtinCount = 95;
+static constexpr int builtinWidth = 5;
+static constexpr int builtinHeight = 8;
+static const uint8_t builtinGlyphs[builtinCount][builtinHeight] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00 }, // '!'
+    { 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+    { 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A, 0x00 }, // '#'
+    { 0x04, 0x1E, 0x05, 0x0E, 0x14, 0x0F, 0x04, 0x00 }, // '$'
+    { 0x03, 0x13, 0x08, 0x04, 0x02, 0x19, 0x18, 0x00 }, // '%'
+    { 0x06, 0x09, 0x05, 0x02, 0x15, 0x09, 0x16, 0x00 }, // '&'
+    { 0x04, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '''
+    { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08, 0x00 }, // '('
+    { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02, 0x00 }, // ')'
+    { 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00, 0x00 }, // '*'
+    { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00, 0x00 }, // '+'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x04, 0x02 }, // ','
+    { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00 }, // '-'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06, 0x00 }, // '.'
+    { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 }, // '/'
+    { 0x0E, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0E, 0x00 }, // '0'
+    { 0x04, 0x06, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00 }, // '1'
+    { 0x0E, 0x11, 0x10, 0x08, 0x04, 0x02, 0x1F, 0x00 }, // '2'
+    { 0x1F, 0x08, 0x04, 0x08, 0x10, 0x11, 0x0E, 0x00 }, // '3'
+    { 0x08, 0x0C, 0x0A, 0x09, 0x1F, 0x08, 0x08, 0x00 }, // '4'
+    { 0x1F, 0x01, 0x0F, 0x10, 0x10, 0x11, 0x0E, 0x00 }, // '5'
+    { 0x0C, 0x02, 0x01, 0x0F, 0x11, 0x11, 0x0E, 0x00 }, // '6'
+    { 0x1F, 0x10, 0x08, 0x04, 0x02, 0x02, 0x02, 0x00 }, // '7'
+    { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E, 0x00 }, // '8'
+    { 0x0E, 0x11, 0x11, 0x1E, 0x10, 0x08, 0x06, 0x00 }, // '9'
+    { 0x00, 0x06, 0x06, 0x00, 0x06, 0x06, 0x00, 0x00 }, // ':'
+    { 0x00, 0x06, 0x06, 0x00, 0x06, 0x04, 0x02, 0x00 }, // ';'
+    { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00 }, // '<'
+    { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // '='
+    { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02, 0x00 }, // '>'
+    { 0x0E, 0x11, 0x10, 0x08, 0x04, 0x00, 0x04, 0x00 }, // '?'
+    { 0x0E, 0x11, 0x10, 0x16, 0x15, 0x15, 0x0E, 0x00 }, // '@'
+    { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00 }, // 'A'
+    { 0x0F, 0x11, 0x11, 0x0F, 0x11, 0x11, 0x0F, 0x00 }, // 'B'
+    { 0x0E, 0x11, 0x01, 0x01, 0x01, 0x11, 0x0E, 0x00 }, // 'C'
+    { 0x07, 0x09, 0x11, 0x11, 0x11, 0x09, 0x07, 0x00 }, // 'D'
+    { 0x1F, 0x01, 0x01, 0x0F, 0x01, 0x01, 0x1F, 0x00 }, // 'E'
+    { 0x1F, 0x01, 0x01, 0x0F, 0x01, 0x01, 0x01, 0x00 }, // 'F'
+    { 0x0E, 0x11, 0x01, 0x1D, 0x11, 0x11, 0x1E, 0x00 }, // 'G'
+    { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00 }, // 'H'
+    { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00 }, // 'I'
+    { 0x1C, 0x08, 0x08, 0x08, 0x08, 0x09, 0x06, 0x00 }, // 'J'
+    { 0x11, 0x09, 0x05, 0x03, 0x05, 0x09, 0x11, 0x00 }, // 'K'
+    { 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x1F, 0x00 }, // 'L'
+    { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11, 0x00 }, // 'M'
+    { 0x11, 0x11, 0x13, 0x15, 0x19, 0x11, 0x11, 0x00 }, // 'N'
+    { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00 }, // 'O'
+    { 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x01, 0x01, 0x00 }, // 'P'
+    { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x09, 0x16, 0x00 }, // 'Q'
+    { 0x0F, 0x11, 0x11, 0x0F, 0x05, 0x09, 0x11, 0x00 }, // 'R'
+    { 0x1E, 0x01, 0x01, 0x0E, 0x10, 0x10, 0x0F, 0x00 }, // 'S'
+    { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00 }, // 'T'
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00 }, // 'U'
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00 }, // 'V'
+    { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A, 0x00 }, // 'W'
+    { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11, 0x00 }, // 'X'
+    { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x00 }, // 'Y'
+    { 0x1F, 0x10, 0x08, 0x04, 0x02, 0x01, 0x1F, 0x00 }, // 'Z'
+    { 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E, 0x00 }, // '['
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00 }, // backslash
+    { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E, 0x00 }, // ']'
+    { 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '^'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00 }, // '_'
+    { 0x02, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '`'
+    { 0x00, 0x00, 0x0E, 0x10, 0x1E, 0x11, 0x1E, 0x00 }, // 'a'
+    { 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F, 0x00 }, // 'b'
+    { 0x00, 0x00, 0x0E, 0x01, 0x01, 0x11, 0x0E, 0x00 }, // 'c'
+    { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E, 0x00 }, // 'd'
+    { 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x01, 0x0E, 0x00 }, // 'e'
+    { 0x0C, 0x12, 0x02, 0x07, 0x02, 0x02, 0x02, 0x00 }, // 'f'
+    { 0x00, 0x00, 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x0E }, // 'g'
+    { 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x11, 0x00 }, // 'h'
+    { 0x04, 0x00, 0x06, 0x04, 0x04, 0x04, 0x0E, 0x00 }, // 'i'
+    { 0x08, 0x00, 0x0C, 0x08, 0x08, 0x08, 0x09, 0x06 }, // 'j'
+    { 0x01, 0x01, 0x09, 0x05, 0x03, 0x05, 0x09, 0x00 }, // 'k'
+    { 0x06, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00 }, // 'l'
+    { 0x00, 0x00, 0x0B, 0x15, 0x15, 0x11, 0x11, 0x00 }, // 'm'
+    { 0x00, 0x00, 0x0D, 0x13, 0x11, 0x11, 0x11, 0x00 }, // 'n'
+    { 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00 }, // 'o'
+    { 0x00, 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x01 }, // 'p'
+    { 0x00, 0x00, 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10 }, // 'q'
+    { 0x00, 0x00, 0x0D, 0x13, 0x01, 0x01, 0x01, 0x00 }, // 'r'
+    { 0x00, 0x00, 0x1E, 0x01, 0x0E, 0x10, 0x0F, 0x00 }, // 's'
+    { 0x02, 0x02, 0x07, 0x02, 0x02, 0x12, 0x0C, 0x00 }, // 't'
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x19, 0x16, 0x00 }, // 'u'
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00 }, // 'v'
+    { 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A, 0x00 }, // 'w'
+    { 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x00 }, // 'x'
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x1E, 0x10, 0x0E }, // 'y'
+    { 0x00, 0x00, 0x1F, 0x08, 0x04, 0x02, 0x1F, 0x00 }, // 'z'
+    { 0x18, 0x04, 0x04, 0x02, 0x04, 0x04, 0x18, 0x00 }, // '{'
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00 }, // '|'
+    { 0x03, 0x04, 0x04, 0x08, 0x04, 0x04, 0x03, 0x00 }, // '}'
+    { 0x00, 0x00, 0x02, 0x15, 0x08, 0x00, 0x00, 0x00 }, // '~'
+};
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Font                                                                 */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Reads a font from a sheet of equal cells
+Font::Font(
+    const ImageView& sheet,
+    int              cellWidth,
+    int              cellHeight,
+    uint32_t         firstCharacter,
+    bool             proportional )
+    :
+    cellWidth( cellWidth ),
+    cellHeight( cellHeight ),
+    firstCharacter( firstCharacter ),
+    cellCount( 0u ),
+    id( nextId++ )
+{
+    assert( cellWidth > 0 && cellHeight > 0 );
+    if ( sheet.IsEmpty() )
+        return;
+
+    const int columns = sheet.width / cellWidth, rows = sheet.height / cellHeight;
+    cellCount = static_cast<size_t>( columns ) * rows;
+    ink.resize( cellCount * cellWidth * cellHeight );
+    advances.resize( cellCount );
+
+    uint8_t* cell = ink.data();
+    for ( size_t c = 0; c < cellCount; ++c, cell += cellWidth * cellHeight )
+    {
+        const int left = static_cast<int>( c % columns ) * cellWidth, top = static_cast<int>( c / columns ) * cellHeight;
+        int inkWidth = 0;
+        for ( int y = 0; y < cellHeight; ++y )
+        {
+            const uint32_t* row = sheet.GetRow( top + y ) + left;
+            for ( int x = 0; x < cellWidth; ++x )
+            {
+                cell[y * cellWidth + x] = ( row[x] >> 24 ) >= 128u;
+                if ( cell[y * cellWidth + x] )
+                    inkWidth = std::max( inkWidth, x + 1 );
+            }
+        }
+
+        // Proportional characters leave a pixel after their ink, blank ones like the space are half a cell
+        advances[c] = !proportional ? cellWidth : inkWidth > 0 ? inkWidth + 1 : std::max( cellWidth / 2, 1 );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the built in font
+const Font& Font::GetDefault()
+{
+    // Expanded into a sheet of one row the first time it is asked for, each glyph in a cell a pixel
+    // wider and taller for the gaps between characters and lines
+    static const Font font = []
+    {
+        constexpr int cellWidth = builtinWidth + 1, cellHeight = builtinHeight + 1;
+        constexpr int width = cellWidth * builtinCount;
+        std::vector<uint32_t> sheet( static_cast<size_t>( width ) * cellHeight, 0u );
+        for ( int c = 0; c < builtinCount; ++c )
+            for ( int y = 0; y < builtinHeight; ++y )
+                for ( int x = 0; x < builtinWidth; ++x )
+                    if ( builtinGlyphs[c][y] & ( 1u << x ) )
+                        sheet[static_cast<size_t>( y ) * width + c * cellWidth + x] = 0xFFFFFFFFu;
+        return Font( ImageView( sheet.data(), width, cellHeight, width ), cellWidth, cellHeight, builtinFirst, false );
+    }();
+    return font;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the ink of a character as spans
+Glyph Font::Rasterize(
+    uint32_t character,
+    int      scale ) const
+{
+    Glyph glyph;
+    glyph.advance = GetAdvance( character ) * scale;
+    const ptrdiff_t c = FindCell( character );
+    if ( c < 0 )
+        return glyph;
+
+    // Each row of the cell is scale rows of the glyph with every run of ink scale times as long
+    const uint8_t* cell = ink.data() + c * cellWidth * cellHeight;
+    for ( int y = 0; y < cellHeight * scale; ++y )
+    {
+        const uint8_t* row = cell + ( y / scale ) * cellWidth;
+        for ( int x = 0; x < cellWidth; )
+        {
+            if ( !row[x] )
+            {
+                ++x;
+                continue;
+            }
+            const int start = x;
+            while ( x < cellWidth && row[x] )
+                ++x;
+            glyph.spans.push_back( { y, start * scale, x * scale } );
+        }
+    }
+    return glyph;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Sets how much further apart a pair of characters are
+void Font::SetKerning(
+    uint32_t left,
+    uint32_t right,
+    int      adjust )
+{
+    const uint64_t pair = ( static_cast<uint64_t>( left ) << 32 ) | right;
+    if ( adjust != 0 )
+        kerning[pair] = adjust;
+    else
+        kerning.erase( pair );
+    id = nextId++;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the pixels added to the advance between a pair
+int Font::GetKerning(
+    uint32_t left,
+    uint32_t right ) const noexcept
+{
+    if ( kerning.empty() )
+        return 0;
+    const auto found = kerning.find( ( static_cast<uint64_t>( left ) << 32 ) | right );
+    return found != kerning.end() ? found->second : 0;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns how far a character moves the pen in pixels
+int Font::GetAdvance( uint32_t character ) const noexcept
+{
+    const ptrdiff_t c = FindCell( character );
+    return c >= 0 ? advances[c] : cellWidth;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of a cell in pixels
+int Font::GetCellWidth() const noexcept { return cellWidth; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the height of a cell in pixels
+int Font::GetCellHeight() const noexcept { return cellHeight; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a number no other font shares
+uint64_t Font::GetId() const noexcept { return id; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] Font                                                                */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Returns the cell of a character
+ptrdiff_t Font::FindCell( uint32_t character ) const noexcept
+{
+    if ( character - firstCharacter < cellCount )
+        return static_cast<ptrdiff_t>( character - firstCharacter );
+    if ( replacement - firstCharacter < cellCount )
+        return static_cast<ptrdiff_t>( replacement - firstCharacter );
+    return -1;
+}
\ No newline at end of file
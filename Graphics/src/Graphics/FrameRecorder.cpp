@@ -0,0 +1,391 @@
+#include "Graphics/FrameRecorder.h"
+#include "Graphics/Qoi.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+// Sizes of the file header and of the header before each frame
+static constexpr size_t fileHeaderSize = 20u;
+static constexpr size_t frameHeaderSize = 16u;
+
+//////////////////////////////////////////////////////////////////
+// Writes a little endian number of some bytes into a buffer
+static void PutLittle(
+    uint8_t* out,
+    uint64_t value,
+    int      bytes ) noexcept
+{
+    for ( int i = 0; i < bytes; ++i )
+        out[i] = static_cast<uint8_t>( value >> ( 8 * i ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// Reads a little endian number of some bytes from a buffer
+static uint64_t GetLittle(
+    const uint8_t* in,
+    int            bytes ) noexcept
+{
+    uint64_t value = 0u;
+    for ( int i = bytes - 1; i >= 0; --i )
+        value = ( value << 8 ) | in[i];
+    return value;
+}
+
+//////////////////////////////////////////////////////////////////
+// Returns a path as UTF-8 for messages
+static std::string PathString( const std::filesystem::path& path )
+{
+    const std::u8string name = path.u8string();
+    return std::string( name.begin(), name.end() );
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] FrameRecorder::Exception                                             */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Constructs a custom FrameRecorder::Exception
+FrameRecorder::Exception::Exception(
+    int                line,
+    const char*        file,
+    const std::string& path,
+    const std::string& reason )
+    :
+    GraphicsException( line, file ),
+    path( path ),
+    reason( reason )
+{}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Human readable error string recovered from exception
+const char* FrameRecorder::Exception::what() const noexcept
+{
+    // Format the error string and store in buffer
+    std::ostringstream oss;
+    oss << GetType() << std::endl
+        << "[Capture] " << GetPath() << std::endl
+        << "[Description] " << GetReason() << std::endl
+        << GetOriginString();
+    whatBuffer = oss.str();
+
+    // Return pointer to persistent buffer string
+    return whatBuffer.c_str();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns Capture Error type of exception
+const char* FrameRecorder::Exception::GetType() const noexcept { return "Capture Exception"; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the capture file
+const std::string& FrameRecorder::Exception::GetPath() const noexcept { return path; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns what went wrong with the capture file
+const std::string& FrameRecorder::Exception::GetReason() const noexcept { return reason; }
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] FrameRecorder                                                        */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Creates the file, allocates every slot and starts the 
+//          writer thread
+FrameRecorder::FrameRecorder(
+    const std::filesystem::path& path,
+    int                          width,
+    int                          height,
+    CaptureFormat                format,
+    unsigned                     slotCount )
+    :
+    path( PathString( path ) ),
+    file( path, std::ios::binary | std::ios::trunc ),
+    format( format )
+{
+    assert( width > 0 && height > 0 );
+    if ( !file )
+        throw CAPTURE_EXCEPT( this->path, "The file could not be created" );
+
+    // Every slot is allocated up front so capturing never allocates
+    slots.resize( std::max( slotCount, 1u ) );
+    for ( Framebuffer& slot : slots )
+        slot = Framebuffer( width, height );
+    numbers.resize( slots.size() );
+
+    uint8_t header[fileHeaderSize];
+    PutLittle( header, magic, 4 );
+    PutLittle( header + 4, version, 4 );
+    PutLittle( header + 8, static_cast<uint32_t>( width ), 4 );
+    PutLittle( header + 12, static_cast<uint32_t>( height ), 4 );
+    PutLittle( header + 16, static_cast<uint32_t>( format ), 4 );
+    if ( !file.write( reinterpret_cast<const char*>( header ), sizeof( header ) ) )
+        throw CAPTURE_EXCEPT( this->path, "The file could not be written" );
+    bytesWritten = sizeof( header );
+
+    thread = std::thread( &FrameRecorder::WriteLoop, this );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Writes every captured frame and stops the writer thread
+FrameRecorder::~FrameRecorder()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    frameCaptured.notify_one();
+    thread.join();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Copies a frame into a free slot to be written
+bool FrameRecorder::Capture( const Framebuffer& frame )
+{
+    assert( frame.GetWidth() == slots[0].GetWidth() && frame.GetHeight() == slots[0].GetHeight() );
+    const uint64_t number = captured++;
+
+    // The writer never touches the slot after the filled ones, so it can be copied into unlocked
+    size_t slot;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if ( filled == slots.size() || failed )
+        {
+            ++dropped;
+            return false;
+        }
+        slot = ( first + filled ) % slots.size();
+    }
+
+    slots[slot].CopyFrom( frame );
+    numbers[slot] = number;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        ++filled;
+    }
+    frameCaptured.notify_one();
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Blocks until every captured frame has been written
+void FrameRecorder::Wait()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    frameWritten.wait( lock, [this] { return filled == 0u; } );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of frames passed to Capture
+uint64_t FrameRecorder::GetCapturedCount() const noexcept { return captured; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of frames dropped
+uint64_t FrameRecorder::GetDroppedCount() const noexcept { return dropped; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of frames written to the file
+uint64_t FrameRecorder::GetWrittenCount() const noexcept { return written; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the size of the file so far in bytes
+uint64_t FrameRecorder::GetBytesWritten() const noexcept { return bytesWritten; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if writing failed
+bool FrameRecorder::HasFailed() const noexcept { return failed; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] FrameRecorder                                                       */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Writes captured frames until stopped
+void FrameRecorder::WriteLoop()
+{
+    for ( ;; )
+    {
+        // Frames still waiting when stopped are written before the thread ends
+        size_t slot;
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            frameCaptured.wait( lock, [this] { return filled > 0u || stopping; } );
+            if ( filled == 0u )
+                break;
+            slot = first;
+        }
+
+        WriteFrame( slots[slot], numbers[slot] );
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            first = ( first + 1u ) % slots.size();
+            --filled;
+        }
+        frameWritten.notify_all();
+    }
+    file.flush();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Encodes a frame and writes it to the file
+void FrameRecorder::WriteFrame(
+    const Framebuffer& frame,
+    uint64_t           number )
+{
+    if ( failed )
+        return;
+
+    // The header goes first with the size filled in once the frame is encoded
+    const int width = frame.GetWidth(), height = frame.GetHeight();
+    encoded.resize( frameHeaderSize );
+    uint32_t flags = keyFrameFlag;
+    if ( format == CaptureFormat::RAW )
+    {
+        // Rows are written straight from the slot without the padding at their ends
+        const size_t rowBytes = static_cast<size_t>( width ) * sizeof( uint32_t );
+        PutLittle( encoded.data(), number, 8 );
+        PutLittle( encoded.data() + 8, flags, 4 );
+        PutLittle( encoded.data() + 12, rowBytes * height, 4 );
+        file.write( reinterpret_cast<const char*>( encoded.data() ), frameHeaderSize );
+        for ( int y = 0; y < height; ++y )
+            file.write( reinterpret_cast<const char*>( frame.GetRow( y ) ), static_cast<std::streamsize>( rowBytes ) );
+        bytesWritten += frameHeaderSize + rowBytes * height;
+    }
+    else
+    {
+        // Delta frames are what changed since the last frame written, unchanged pixels become long runs of zero
+        const size_t count = static_cast<size_t>( width ) * height;
+        if ( format == CaptureFormat::DELTA && !previous.empty() && sinceKeyFrame < keyFrameInterval )
+        {
+            delta.resize( count );
+            for ( int y = 0; y < height; ++y )
+            {
+                const uint32_t* row = frame.GetRow( y );
+                uint32_t* last = previous.data() + static_cast<size_t>( y ) * width;
+                uint32_t* out = delta.data() + static_cast<size_t>( y ) * width;
+                for ( int x = 0; x < width; ++x )
+                {
+                    out[x] = row[x] ^ last[x];
+                    last[x] = row[x];
+                }
+            }
+            Qoi::Encode( ImageView( delta.data(), width, height, width ), true, encoded );
+            flags = 0u;
+            ++sinceKeyFrame;
+        }
+        else
+        {
+            Qoi::Encode( ImageView( frame.GetPixels(), width, height, frame.GetPitch() ), true, encoded );
+            if ( format == CaptureFormat::DELTA )
+            {
+                previous.resize( count );
+                for ( int y = 0; y < height; ++y )
+                    std::memcpy( previous.data() + static_cast<size_t>( y ) * width, frame.GetRow( y ), static_cast<size_t>( width ) * sizeof( uint32_t ) );
+                sinceKeyFrame = 1u;
+            }
+        }
+
+        PutLittle( encoded.data(), number, 8 );
+        PutLittle( encoded.data() + 8, flags, 4 );
+        PutLittle( encoded.data() + 12, encoded.size() - frameHeaderSize, 4 );
+        file.write( reinterpret_cast<const char*>( encoded.data() ), static_cast<std::streamsize>( encoded.size() ) );
+        bytesWritten += encoded.size();
+    }
+
+    if ( !file )
+        failed = true;
+    else
+        ++written;
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] FrameReader                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Opens a capture and reads its header
+FrameReader::FrameReader( const std::filesystem::path& path )
+    :
+    file( path, std::ios::binary )
+{
+    if ( !file )
+        throw CAPTURE_EXCEPT( PathString( path ), "The file could not be opened" );
+
+    uint8_t header[fileHeaderSize];
+    if ( !file.read( reinterpret_cast<char*>( header ), sizeof( header ) ) || GetLittle( header, 4 ) != FrameRecorder::magic )
+        throw CAPTURE_EXCEPT( PathString( path ), "The file is not a capture" );
+    if ( GetLittle( header + 4, 4 ) != FrameRecorder::version )
+        throw CAPTURE_EXCEPT( PathString( path ), "The capture was written by another version" );
+
+    const uint64_t w = GetLittle( header + 8, 4 ), h = GetLittle( header + 12, 4 ), f = GetLittle( header + 16, 4 );
+    if ( w == 0u || h == 0u || w > Qoi::maxPixels / h || f > static_cast<uint64_t>( CaptureFormat::DELTA ) )
+        throw CAPTURE_EXCEPT( PathString( path ), "The capture header is malformed" );
+
+    width = static_cast<int>( w );
+    height = static_cast<int>( h );
+    format = static_cast<CaptureFormat>( f );
+    pixels.resize( static_cast<size_t>( width ) * height );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Reads the next frame
+bool FrameReader::Next()
+{
+    uint8_t header[frameHeaderSize];
+    if ( !file.read( reinterpret_cast<char*>( header ), sizeof( header ) ) )
+        return false;
+
+    const uint64_t frameNumber = GetLittle( header, 8 );
+    const bool keyFrame = ( GetLittle( header + 8, 4 ) & FrameRecorder::keyFrameFlag ) != 0u;
+    encoded.resize( GetLittle( header + 12, 4 ) );
+    if ( !file.read( reinterpret_cast<char*>( encoded.data() ), static_cast<std::streamsize>( encoded.size() ) ) )
+        return false;
+
+    if ( format == CaptureFormat::RAW )
+    {
+        if ( encoded.size() != pixels.size() * sizeof( uint32_t ) )
+            return false;
+        std::memcpy( pixels.data(), encoded.data(), encoded.size() );
+    }
+    else
+    {
+        // A delta can only be applied to the frame it was taken against
+        int w, h;
+        if ( !Qoi::ReadHeader( encoded.data(), encoded.size(), w, h ) || w != width || h != height || ( !keyFrame && !started ) )
+            return false;
+
+        std::vector<uint32_t>& target = keyFrame ? pixels : decoded;
+        target.resize( pixels.size() );
+        if ( !Qoi::Decode( encoded.data(), encoded.size(), target.data(), target.size() ) )
+            return false;
+        if ( !keyFrame )
+        {
+            for ( size_t i = 0u; i < pixels.size(); ++i )
+                pixels[i] ^= decoded[i];
+        }
+    }
+
+    number = frameNumber;
+    started = true;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the pixels of the frame last read
+ImageView FrameReader::GetView() const noexcept { return ImageView( pixels.data(), width, height, width ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number the frame last read was captured as
+uint64_t FrameReader::GetFrameNumber() const noexcept { return number; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of every frame in pixels
+int FrameReader::GetWidth() const noexcept { return width; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the height of every frame in pixels
+int FrameReader::GetHeight() const noexcept { return height; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns how the frames are stored
+CaptureFormat FrameReader::GetFormat() const noexcept { return format; }
@@ -0,0 +1,122 @@
+#include "Graphics/Framebuffer.h"
+#include <new>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Framebuffer                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Allocates aligned pixel memory for the given 
+//          dimensions
+Framebuffer::Framebuffer( 
+    int width, 
+    int height )
+    :
+    width( width ),
+    height( height )
+{
+    assert( width >= 0 && height >= 0 );
+
+    // Pad every row out to a whole number of cache lines
+    constexpr int pixelsPerLine = static_cast<int>( alignment / sizeof( uint32_t ) );
+    pitch = ( width + pixelsPerLine - 1 ) / pixelsPerLine * pixelsPerLine;
+
+    // Allocate our memory for storing pixel values, throws std::bad_alloc on failure
+    if ( GetSizeInBytes() > 0 )
+        pixels = static_cast<uint32_t*>( ::operator new[]( GetSizeInBytes(), std::align_val_t{ alignment } ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Takes ownership of another framebuffer's memory
+Framebuffer::Framebuffer( Framebuffer&& rhs ) noexcept
+    :
+    width( std::exchange( rhs.width, 0 ) ),
+    height( std::exchange( rhs.height, 0 ) ),
+    pitch( std::exchange( rhs.pitch, 0 ) ),
+    pixels( std::exchange( rhs.pixels, nullptr ) )
+{}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Frees the pixel memory
+Framebuffer::~Framebuffer() { Release(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Frees our memory and takes ownership of another's
+Framebuffer& Framebuffer::operator=( Framebuffer&& rhs ) noexcept
+{
+    if ( this != &rhs )
+    {
+        Release();
+        width = std::exchange( rhs.width, 0 );
+        height = std::exchange( rhs.height, 0 );
+        pitch = std::exchange( rhs.pitch, 0 );
+        pixels = std::exchange( rhs.pixels, nullptr );
+    }
+    return *this;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Copies the contents of another framebuffer, 
+//          reallocating if the dimensions do not match
+void Framebuffer::CopyFrom( const Framebuffer& src )
+{
+    if ( width != src.width || height != src.height )
+        *this = Framebuffer( src.width, src.height );
+
+    // Pitch is derived from width so the whole block can be copied at once
+    if ( pixels )
+        std::memcpy( pixels, src.pixels, GetSizeInBytes() );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of the surface in pixels
+int Framebuffer::GetWidth() const noexcept { return width; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the height of the surface in pixels
+int Framebuffer::GetHeight() const noexcept { return height; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the distance between rows in pixels
+int Framebuffer::GetPitch() const noexcept { return pitch; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the size of the pixel memory in bytes
+size_t Framebuffer::GetSizeInBytes() const noexcept
+{
+    return static_cast<size_t>( pitch ) * static_cast<size_t>( height ) * sizeof( uint32_t );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a pointer to the first pixel of the surface
+uint32_t* Framebuffer::GetPixels() noexcept { return pixels; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a pointer to the first pixel of the surface
+const uint32_t* Framebuffer::GetPixels() const noexcept { return pixels; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a pointer to the first pixel of a row
+uint32_t* Framebuffer::GetRow( int y ) noexcept { return pixels + static_cast<ptrdiff_t>( y ) * pitch; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a pointer to the first pixel of a row
+const uint32_t* Framebuffer::GetRow( int y ) const noexcept { return pixels + static_cast<ptrdiff_t>( y ) * pitch; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] Framebuffer                                                         */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Releases the pixel memory and resets to empty
+void Framebuffer::Release() noexcept
+{
+    if ( pixels )
+        ::operator delete[]( pixels, std::align_val_t{ alignment } );
+
+    width = height = pitch = 0;
+    pixels = nullptr;
+}
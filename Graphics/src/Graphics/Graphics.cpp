@@ -1,49 +1,50 @@
 #include "Graphics/Graphics.h"
-#include <new>
+#include "Graphics/SpanFill.h"
+#include "Graphics/HalfSpace.h"
+#include <utility>
 #include <cassert>
 #include <algorithm>
 
+//////////////////////////////////////////////////////////////////
+// Splits a color into the attributes Shading::Gouraud expects, in
+//      the byte order of a pixel
+static void ColorAttributes(
+    const Color& color,
+    float*       attributes ) noexcept
+{
+    for ( int c = 0; c < 4; ++c )
+        attributes[c] = static_cast<float>( ( color.hex >> ( c * 8 ) ) & 0xFFu );
+}
+
+//////////////////////////////////////////////////////////////////
+// Converts a whole pixel to the 28.4 fixed point position of its 
+//      center, where strokes through it are centered
+static Vec2<int> PixelCenter( const Vec2<int>& pos ) noexcept
+{
+    constexpr int half = HalfSpace::subpixelScale / 2;
+    const Vec2<int> corner = HalfSpace::ToSubpixel( pos );
+    return { corner.x + half, corner.y + half };
+}
+
 /* ======================================================================================================= */
 /*                           [PUBLIC] Graphics                                                             */
 /* ======================================================================================================= */
 
 //////////////////////////////////////////////////////////////////
-// [PUBLIC] Constructs the graphics object and stores necessary 
-//          data
-Graphics::Graphics( const HWND& hWindow )
-{
-    // Get device handle to our window
-    hdc = GetDC( hWindow );
-
-    // Get window rectangle and store info about it
-    RECT rect;
-    GetClientRect( hWindow, &rect );
-    clientWidth = rect.right - rect.left;
-    clientHeight = rect.bottom - rect.top;
-
-    // Allocate our memory for storing pixel values
-    memory = VirtualAlloc(
-        NULL,													// Location of desired memory (null means we dont care)
-        static_cast<size_t>(clientWidth * clientHeight) 
-            * sizeof( uint32_t ),		                        // Amount of memory we want in bytes (num pixels * num bytes per pixel)
-        MEM_RESERVE | MEM_COMMIT,								// Type of memory allocation (we want to reserve it and commit to it)
-        PAGE_READWRITE											// Memory protection (we will be writing and reading the memory)
-    );
-
-    // Throw an error if we did not receive memory
-    if ( !memory ) 
-        throw std::bad_alloc();
-
-    // Initialize values for the bitmap so it can be passed as our new frame each loop
-    bitmap.bmiHeader.biSize = sizeof( bitmap.bmiHeader );		// Number of bytes required by the struct (not including color table)
-    bitmap.bmiHeader.biWidth = clientWidth;						// Width of the bitmap in pixels (i.e. the width of our window)
-    bitmap.bmiHeader.biHeight = clientHeight;					// Height of the bitmap in pixels (i.e. the height of our window)
-    bitmap.bmiHeader.biPlanes = 1;								// Must be set to 1 (says that the data is ordered in memory?)
-    bitmap.bmiHeader.biBitCount = sizeof( unsigned int ) * 8;	// Number of bits per pixel (num bytes per pixel * num bits in a byte)
-    bitmap.bmiHeader.biCompression = BI_RGB;					// Compression type (ours is uncompressed RGB values)
-
+// [PUBLIC] Constructs the graphics object and allocates its 
+//          surface
+Graphics::Graphics(
+    int                        width,
+    int                        height,
+    std::unique_ptr<Presenter> presenter )
+    :
+    framebuffer( width, height ),
+    presenter( std::move( presenter ) ),
+    drawn( width, height ),
+    shown( width, height )
+{
     // Set the screen to the default grey color
-    ClearScreen( 0x333333 );
+    ClearScreen( defaultColor );
 }
 
 //////////////////////////////////////////////////////////////////
@@ -53,33 +54,7 @@ void Graphics::DrawRectangle(
     const Vec2<int>& corner2, 
     const Color&	 color )
 {
-    // Initialize variables
-    int top, bottom, left, right;
-    if ( corner1.y > corner2.y )
-    {
-        top = corner1.y;
-        bottom = corner2.y;
-    }
-    else
-    {
-        top = corner2.y;
-        bottom = corner1.y;
-    }
-    if ( corner1.x < corner2.x )
-    {
-        left = corner1.x;
-        right = corner2.x;
-    }
-    else
-    {
-        left = corner2.x;
-        right = corner1.x;
-    }
-
-    // Draw every line in the rectangle, skip Bresenham's because horizontal
-    for ( int y = bottom; y < top; ++y )
-        for ( int x = left; x < right; ++x )
-            ChangePixel( { x, y }, color );
+    Submit( DrawCommand( DrawCommand::Type::RECTANGLE, corner1, corner2, corner2, color.hex, blendMode ) );
 }
 
 //////////////////////////////////////////////////////////////////
@@ -90,300 +65,833 @@ void Graphics::DrawTriangle(
     const Vec2<int>& v3,
     const Color&     color )
 {
-    // Initialize variables
-    Vec2<int> top = v1, middle = v2, bottom = v3;
+    switch ( triangleRasterizer )
+    {
+    case TriangleRasterizer::HALFSPACE:
+        Submit( DrawCommand(
+            DrawCommand::Type::TRIANGLE_HALFSPACE,
+            HalfSpace::ToSubpixel( v1 ),
+            HalfSpace::ToSubpixel( v2 ),
+            HalfSpace::ToSubpixel( v3 ),
+            color.hex, blendMode ) );
+        break;
+    case TriangleRasterizer::SCANLINE:
+        Submit( DrawCommand( DrawCommand::Type::TRIANGLE_SCANLINE, v1, v2, v3, color.hex, blendMode ) );
+        break;
+    }
+}
 
-    // Order all of the verticies in descending order
-    if ( top.y < middle.y )
-        top.Swap( middle );
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a triangle with a depth per vertex
+void Graphics::DrawTriangle(
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    float            z1,
+    float            z2,
+    float            z3,
+    const Color&     color )
+{
+    const float z[3] = { z1, z2, z3 };
+    Submit( DrawCommand(
+        HalfSpace::ToSubpixel( v1 ),
+        HalfSpace::ToSubpixel( v2 ),
+        HalfSpace::ToSubpixel( v3 ),
+        z, color.hex, blendMode ) );
+}
 
-    if ( middle.y < bottom.y )
-    {
-        middle.Swap( bottom );
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a triangle with a color per vertex
+void Graphics::DrawTriangle(
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const Color&     c1,
+    const Color&     c2,
+    const Color&     c3 )
+{
+    float attributes[12];
+    ColorAttributes( c1, attributes );
+    ColorAttributes( c2, attributes + 4 );
+    ColorAttributes( c3, attributes + 8 );
+    DrawTriangleShaded( v1, v2, v3, attributes, 4, Shading::Gouraud );
+}
 
-        if ( top.y < middle.y )
-            top.Swap( middle );
-    }
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a triangle whose pixels are written by a shader
+void Graphics::DrawTriangleShaded(
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const float*     attributes,
+    int              attributeCount,
+    SpanShader       shader,
+    const void*      user )
+{
+    assert( attributeCount >= 0 && attributeCount <= Shading::maxAttributes );
+    Submit( DrawCommand(
+        HalfSpace::ToSubpixel( v1 ),
+        HalfSpace::ToSubpixel( v2 ),
+        HalfSpace::ToSubpixel( v3 ),
+        nullptr, attributes, attributeCount, shader, user, blendMode ) );
+}
 
-    // Handle coincident points edge case
-    int dx = top.x - bottom.x;
-    int dy = top.y - bottom.y;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a triangle mapped with a texture
+void Graphics::DrawTriangleTextured(
+    const Vec2<int>&   v1,
+    const Vec2<int>&   v2,
+    const Vec2<int>&   v3,
+    const Vec2<float>& uv1,
+    const Vec2<float>& uv2,
+    const Vec2<float>& uv3,
+    const Texture&     texture,
+    float              w1,
+    float              w2,
+    float              w3 )
+{
+    const float uvw[9] = { uv1.x, uv1.y, w1, uv2.x, uv2.y, w2, uv3.x, uv3.y, w3 };
+    Submit( DrawCommand(
+        HalfSpace::ToSubpixel( v1 ),
+        HalfSpace::ToSubpixel( v2 ),
+        HalfSpace::ToSubpixel( v3 ),
+        uvw, texture, textureFilter, blendMode ) );
+}
 
-    if ( dy == 0 )
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a triangle with sub-pixel precise vertices
+void Graphics::DrawTriangleSubpixel(
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const Color&     color )
+{
+    switch ( triangleRasterizer )
     {
-        int left = std::min( std::min( top.x, middle.x ), bottom.x );
-        int right = std::max( std::max( top.x, middle.x ), bottom.x );
-
-        DrawLine( { left, middle.y }, { right, middle.y }, color );
-        return;
+    case TriangleRasterizer::HALFSPACE:
+        Submit( DrawCommand( DrawCommand::Type::TRIANGLE_HALFSPACE, v1, v2, v3, color.hex, blendMode ) );
+        break;
+    case TriangleRasterizer::SCANLINE:
+    {
+        // The scanline walker only understands whole pixels, round to the nearest
+        constexpr int half = HalfSpace::subpixelScale / 2;
+        Submit( DrawCommand(
+            DrawCommand::Type::TRIANGLE_SCANLINE,
+            { ( v1.x + half ) >> HalfSpace::subpixelBits, ( v1.y + half ) >> HalfSpace::subpixelBits },
+            { ( v2.x + half ) >> HalfSpace::subpixelBits, ( v2.y + half ) >> HalfSpace::subpixelBits },
+            { ( v3.x + half ) >> HalfSpace::subpixelBits, ( v3.y + half ) >> HalfSpace::subpixelBits },
+            color.hex, blendMode ) );
+        break;
     }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a batch of triangles that share vertices
+void Graphics::DrawTriangles(
+    const Vec2<int>* vertices,
+    size_t           vertexCount,
+    const uint32_t*  indices,
+    size_t           indexCount,
+    const Color*     colors,
+    MeshColors       colorMode,
+    const float*     depths )
+{
+    const DrawCommand::Type type = GetMeshType( colorMode, depths );
+    const int shift = type != DrawCommand::Type::TRIANGLE_SCANLINE ? HalfSpace::subpixelBits : 0;
+
+    // Shared vertices are converted once rather than once per triangle using them
+    meshVertices.clear();
+    meshVertices.reserve( vertexCount );
+    for ( size_t i = 0; i < vertexCount; ++i )
+        meshVertices.push_back( shift ? HalfSpace::ToSubpixel( vertices[i] ) : vertices[i] );
 
-    // Find new middle vertex
-    int newX = static_cast<int>( static_cast<float>( dx ) / static_cast<float>( dy ) * ( middle.y - top.y ) + top.x );
+    SubmitMesh( indices, indexCount, colors, colorMode, depths, type, shift );
+}
 
-    // Order middle vertices
-    Vec2<int> middleLeft = { newX, middle.y }, middleRight = middle;
-    if ( middleLeft.x > middleRight.x ) 
-        middleLeft.Swap( middleRight );
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a batch of triangles that share vertices moved by
+//          a transform
+void Graphics::DrawTriangles(
+    const Vec2Batch&      vertices,
+    const Affine2<float>& transform,
+    const uint32_t*       indices,
+    size_t                indexCount,
+    const Color*          colors,
+    MeshColors            colorMode,
+    const float*          depths )
+{
+    const DrawCommand::Type type = GetMeshType( colorMode, depths );
+    const int shift = type != DrawCommand::Type::TRIANGLE_SCANLINE ? HalfSpace::subpixelBits : 0;
 
+    // Every vertex is transformed, scaled and rounded in one vectorized pass
+    meshVertices.resize( vertices.GetSize() );
+    vertices.TransformToFixed( transform, shift, meshVertices.data() );
 
-    //// DRAW FLAT BOTTOM TRIANGLE
-    int lx1 = middleLeft.x, ly1 = middleLeft.y;
-    int lx2 = top.x, ly2 = top.y;
+    SubmitMesh( indices, indexCount, colors, colorMode, depths, type, shift );
+}
 
-    int ldx = abs( lx2 - lx1 );
-    int lxStep = lx1 < lx2 ? 1 : -1;
-    int ldy = -abs( ly2 - ly1 );
-    int lyStep = ly1 < ly2 ? 1 : -1;
-    int lerror = ldx + ldy;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a line between two points
+void Graphics::DrawLine(
+    const Vec2<int>& pos1,
+    const Vec2<int>& pos2,
+    const Color&     color )
+{
+    if ( !lineAntialiasing && lineWidth <= 1.0f )
+        return Submit( DrawCommand( DrawCommand::Type::LINE, pos1, pos2, pos2, color.hex, blendMode ) );
 
-    int rx1 = middleRight.x, ry1 = middleRight.y;
-    int rx2 = top.x, ry2 = top.y;
+    const Vec2<int> start = PixelCenter( pos1 ), end = PixelCenter( pos2 );
+    Submit( DrawCommand( start, end, start, end, lineWidth, lineAntialiasing, color.hex, blendMode ) );
+}
 
-    int rdx = abs( rx2 - rx1 );
-    int rxStep = rx1 < rx2 ? 1 : -1;
-    int rdy = -abs( ry2 - ry1 );
-    int ryStep = ry1 < ry2 ? 1 : -1;
-    int rerror = rdx + rdy;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws connected lines through a list of points
+void Graphics::DrawPolyline(
+    const Vec2<int>* points,
+    size_t           pointCount,
+    const Color&     color )
+{
+    if ( pointCount == 0 )
+        return;
 
-    //  Draw the left line
-    while ( true )
+    // A repeated point would make a line of no length that can't tell its neighbours where the turn is
+    const bool stroke = lineAntialiasing || lineWidth > 1.0f;
+    polylinePoints.clear();
+    for ( size_t i = 0; i < pointCount; ++i )
     {
-        if ( lx1 == lx2 && ly1 == ly2 ) break;
+        const Vec2<int> point = stroke ? PixelCenter( points[i] ) : points[i];
+        if ( polylinePoints.empty() || polylinePoints.back() != point )
+            polylinePoints.push_back( point );
+    }
+    if ( polylinePoints.size() == 1 )
+        polylinePoints.push_back( polylinePoints.back() );
 
-        int le2 = 2 * lerror;
+    SubmitPolyline( polylinePoints.data(), polylinePoints.size(), false, stroke, color );
+}
 
-        // If we are in the negative half-plane
-        if ( le2 >= ldy )
-        {
-            if ( lx1 == lx2 ) break;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills the inside of a path
+void Graphics::FillPath(
+    const Path&           path,
+    const Color&          color,
+    const Affine2<float>& transform )
+{
+    // The path keeps the polygon, an unchanged path and transform submit the same edges again
+    std::shared_ptr<const Polygon> polygon = path.GetPolygon( transform, curveTolerance, fillRule );
+    if ( !polygon->GetBounds().IsEmpty() )
+        Submit( DrawCommand( std::move( polygon ), color.hex, blendMode ) );
+}
 
-            // Step along x and accumulate y error
-            lerror += ldy;
-            lx1 += lxStep;
-        }
-        // If we are in the positive half-plane
-        if ( le2 <= ldx )
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws the outline of a path
+void Graphics::StrokePath(
+    const Path&           path,
+    const Color&          color,
+    const Affine2<float>& transform )
+{
+    // Strokes take the flattened 28.4 points as they are, lines take the pixels the points are in
+    const bool stroke = lineAntialiasing || lineWidth > 1.0f;
+    const Path::Flattened& lines = path.Flatten( transform, curveTolerance );
+    const Vec2<int>* contour = lines.points.data();
+    for ( size_t c = 0; c < lines.contourSizes.size(); contour += lines.contourSizes[c++] )
+    {
+        polylinePoints.clear();
+        for ( size_t i = 0; i < lines.contourSizes[c]; ++i )
         {
-            if ( ly1 == ly2 ) break;
-
-            // Start drawing the right line
-            while ( true )
-            {
-                // Double the error for comparison (avoids floating points)
-                int re2 = 2 * rerror;
-
-                // If we are in the negative half-plane
-                if ( re2 >= rdy )
-                {
-                    // Step along x and accumulate y error
-                    rerror += rdy;
-                    rx1 += rxStep;
-                }
-                // If we are in the positive half-plane
-                if ( re2 <= rdx )
-                {
-                    // Draw the horizontal line between the left and right line
-                    for ( int x = lx1; x <= rx1; x++ )
-                        ChangePixel( { x, ly1 }, color );
-
-                    // Step along y and accumulate x error
-                    rerror = rerror + rdx;
-                    ry1 += ryStep;
-
-                    break;
-                }
-            }
-
-            // Step along y and accumulate x error
-            lerror = lerror + ldx;
-            ly1 += lyStep;
+            const Vec2<int> point = stroke ? contour[i] : 
+                Vec2<int>( contour[i].x >> HalfSpace::subpixelBits, contour[i].y >> HalfSpace::subpixelBits );
+            if ( polylinePoints.empty() || polylinePoints.back() != point )
+                polylinePoints.push_back( point );
         }
+
+        // A closed contour that ends where it started would draw its first point twice, and one of two
+        // points is a single line
+        if ( lines.closed[c] && polylinePoints.size() > 1 && polylinePoints.back() == polylinePoints.front() )
+            polylinePoints.pop_back();
+        if ( polylinePoints.size() > 1 )
+            SubmitPolyline( polylinePoints.data(), polylinePoints.size(), lines.closed[c] && polylinePoints.size() > 2, stroke, color );
     }
+}
 
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws the outline of a circle one pixel wide
+void Graphics::DrawCircle(
+    const Vec2<int>& center,
+    int              radius,
+    const Color&     color )
+{
+    DrawEllipse( center, radius, radius, color );
+}
 
-    //// DRAW FLAT TOP TRIANGLE
-    lx1 = middleLeft.x, ly1 = middleLeft.y;
-    lx2 = bottom.x, ly2 = bottom.y;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a filled circle
+void Graphics::FillCircle(
+    const Vec2<int>& center,
+    int              radius,
+    const Color&     color )
+{
+    FillEllipse( center, radius, radius, color );
+}
 
-    ldx = abs( lx2 - lx1 );
-    lxStep = lx1 < lx2 ? 1 : -1;
-    ldy = -abs( ly2 - ly1 );
-    lyStep = ly1 < ly2 ? 1 : -1;
-    lerror = ldx + ldy;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws the outline of an axis aligned ellipse one pixel
+//          wide
+void Graphics::DrawEllipse(
+    const Vec2<int>& center,
+    int              radiusX,
+    int              radiusY,
+    const Color&     color )
+{
+    if ( radiusX >= 0 && radiusY >= 0 )
+        Submit( DrawCommand( DrawCommand::Type::ELLIPSE, center, { radiusX, radiusY }, center, color.hex, blendMode ) );
+}
 
-    rx1 = middleRight.x, ry1 = middleRight.y;
-    rx2 = bottom.x, ry2 = bottom.y;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a filled axis aligned ellipse
+void Graphics::FillEllipse(
+    const Vec2<int>& center,
+    int              radiusX,
+    int              radiusY,
+    const Color&     color )
+{
+    if ( radiusX >= 0 && radiusY >= 0 )
+        Submit( DrawCommand( DrawCommand::Type::ELLIPSE_FILLED, center, { radiusX, radiusY }, center, color.hex, blendMode ) );
+}
 
-    rdx = abs( rx2 - rx1 );
-    rxStep = rx1 < rx2 ? 1 : -1;
-    rdy = -abs( ry2 - ry1 );
-    ryStep = ry1 < ry2 ? 1 : -1;
-    rerror = rdx + rdy;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a filled polygon without triangulating it
+void Graphics::DrawPolygon(
+    const Vec2<int>* points,
+    size_t           pointCount,
+    const Color&     color )
+{
+    DrawPolygon( points, &pointCount, 1u, color );
+}
 
-    // Draw the left line
-    while ( true )
-    {
-        if ( lx1 == lx2 && ly1 == ly2 ) break;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a filled polygon made of several outlines
+void Graphics::DrawPolygon(
+    const Vec2<int>* points,
+    const size_t*    contourSizes,
+    size_t           contourCount,
+    const Color&     color )
+{
+    size_t pointCount = 0u;
+    for ( size_t c = 0; c < contourCount; ++c )
+        pointCount += contourSizes[c];
+
+    // Corners sit on pixel corners like the vertices of triangles, so shapes drawn both ways agree
+    polygonPoints.clear();
+    polygonPoints.reserve( pointCount );
+    for ( size_t i = 0; i < pointCount; ++i )
+        polygonPoints.push_back( HalfSpace::ToSubpixel( points[i] ) );
+
+    auto polygon = std::make_shared<const Polygon>( polygonPoints.data(), contourSizes, contourCount, fillRule );
+    if ( !polygon->GetBounds().IsEmpty() )
+        Submit( DrawCommand( std::move( polygon ), color.hex, blendMode ) );
+}
 
-        int le2 = 2 * lerror;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Copies an image onto the surface a row at a time
+void Graphics::DrawImage(
+    const ImageView& image,
+    const Vec2<int>& position )
+{
+    if ( !image.IsEmpty() )
+        Submit( DrawCommand( image, position ) );
+}
 
-        // If we are in the negative half-plane
-        if ( le2 >= ldy )
-        {
-            if ( lx1 == lx2 ) break;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a sprite with the current blend mode
+void Graphics::DrawSprite(
+    const Sprite&    sprite,
+    const Vec2<int>& position )
+{
+    if ( sprite.GetPixelCount() > 0u )
+        Submit( DrawCommand( sprite, position, blendMode ) );
+}
 
-            // Step along x and accumulate y error
-            lerror += ldy;
-            lx1 += lxStep;
-        }
-        // If we are in the positive half-plane
-        if ( le2 <= ldx )
-        {
-            if ( ly1 == ly2 ) break;
-
-            // Start drawing the right line
-            while ( true )
-            {
-                // Double the error for comparison (avoids floating points)
-                int re2 = 2 * rerror;
-
-                // If we are in the negative half-plane
-                if ( re2 >= rdy )
-                {
-                    // Step along x and accumulate y error
-                    rerror += rdy;
-                    rx1 += rxStep;
-                }
-                // If we are in the positive half-plane
-                if ( re2 <= rdx )
-                {
-                    // Draw the horizontal line between the left and right line
-                    for ( int x = lx1; x <= rx1; x++ )
-                        ChangePixel( { x, ly1 }, color );
-
-                    // Step along y and accumulate x error
-                    rerror = rerror + rdx;
-                    ry1 += ryStep;
-
-                    break;
-                }
-            }
-
-            // Step along y and accumulate x error
-            lerror = lerror + ldx;
-            ly1 += lyStep;
-        }
-    }
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a string with the current font and text scale
+void Graphics::DrawString(
+    std::string_view text,
+    const Vec2<int>& position,
+    const Color&     color )
+{
+    // The command shares the layout with the cache, dropping it from there can't pull it from under a flush
+    std::shared_ptr<const TextLayout> layout = textCache.GetLayout( *font, text, textScale );
+    if ( !layout->GetBounds().IsEmpty() )
+        Submit( DrawCommand( std::move( layout ), position, color.hex, blendMode ) );
 }
 
 //////////////////////////////////////////////////////////////////
-// [PUBLIC] Draws a line between two points
-void Graphics::DrawLine(
-    const Vec2<int>& pos1,
-    const Vec2<int>& pos2,
+// [PUBLIC] Returns the size of a string
+Vec2<int> Graphics::MeasureString( std::string_view text ) { return textCache.GetLayout( *font, text, textScale )->GetSize(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Changes the color of a single pixel
+void Graphics::ChangePixel(
+    const Vec2<int>& pos,
     const Color&     color )
 {
-    // Unpack coordinates
-    int x1 = pos1.x, y1 = pos1.y;
-    int x2 = pos2.x, y2 = pos2.y;
+    // Deferred and recorded pixels have to wait their turn behind earlier draw calls
+    if ( tiles || recording )
+        return Submit( DrawCommand( DrawCommand::Type::PIXEL, pos, pos, pos, color.hex, blendMode ) );
+
+    assert( pos.x >= 0 && pos.x < framebuffer.GetWidth() );
+    assert( pos.y >= 0 && pos.y < framebuffer.GetHeight() );
 
-    // Find differences and steps based on incrementing or decrementing
-    int dx = abs( x2 - x1 );
-    int xStep = x1 < x2 ? 1 : -1;
-    int dy = -abs( y2 - y1 );
-    int yStep = y1 < y2 ? 1 : -1;
+    // Find the address of the desired coordinate
+    uint32_t* pixel = framebuffer.GetRow( pos.y ) + pos.x;
 
-    // Initialize error
-    int error = dx + dy;
+    // Blend our passed in color into the pixel stored at this coordinate
+    *pixel = Blend::Pixel( *pixel, Paint( color.hex, blendMode ) );
+    drawn.Add( Rect( pos.x, pos.y, pos.x + 1, pos.y + 1 ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Clears a display list and records every following draw
+//          call into it
+void Graphics::BeginDisplayList( DisplayList& list )
+{
+    list.Clear();
+    recording = &list;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Stops recording and returns to drawing
+void Graphics::EndDisplayList() noexcept { recording = nullptr; }
 
-    while ( true )
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws every call recorded in a display list
+void Graphics::DrawDisplayList( const DisplayList& list )
+{
+    // Only immediate drawing can use the runs, they bypass the order of deferred and recorded commands
+    if ( !tiles && !recording && list.ReplayCached( framebuffer ) )
     {
-        // Draw current pixel
-        ChangePixel( { x1, y1 }, color );
+        drawn.Add( list.GetBounds() );
+        return;
+    }
 
-        // End if we reach the other point
-        if ( x1 == x2 && y1 == y2 ) break;
+    for ( const DrawCommand& command : list.GetCommands() )
+        Submit( command );
+}
 
-        // Double the error for comparison (avoids floating points)
-        int e2 = 2 * error;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Displays the current frame to the screen and resets
+void Graphics::Update()
+{
+    // Finish any recorded draw calls first, depth only orders the draw calls of a single frame
+    Flush();
+    if ( depthBuffer )
+        depthBuffer->Clear();
 
-        // If we are in the negative half-plane
-        if ( e2 >= dy )
-        {
-            if ( x1 == x2 ) break;
+    // The finished frame is copied aside before anything presents or clears it
+    if ( recorder )
+        recorder->Capture( framebuffer );
 
-            // Step along x and accumulate y error
-            error += dy;
-            x1 += xStep;
-        }
-        // If we are in the positive half-plane
-        if ( e2 <= dx )
-        {
-            if ( y1 == y2 ) break;
+    // The swap chain presents and clears on its own thread and hands back a clean buffer
+    if ( swapChain )
+    {
+        swapChain->Swap( framebuffer, drawn, presentAll );
+        presentAll = false;
+        return;
+    }
 
-            // Step along y and accumulate x error
-            error = error + dx;
-            y1 += yStep;
+    // What changed on screen is what was drawn this frame plus what was drawn last frame and cleared since
+    shown.Merge( drawn );
+
+    // Hand the finished frame to whatever is displaying it
+    if ( presenter )
+    {
+        if ( presentAll || shown.GetCoverage() >= DirtyRegion::fullCoverage )
+            presenter->Present( framebuffer );
+        else
+        {
+            shown.GetRects( dirtyRects );
+            presenter->PresentRegion( framebuffer, dirtyRects );
         }
+        presentAll = false;
     }
+
+    // Everything not drawn this frame still holds the default color
+    if ( drawn.GetCoverage() >= DirtyRegion::fullCoverage )
+        ClearScreen( defaultColor );
+    else
+        ClearRegion( drawn, defaultColor );
+
+    std::swap( shown, drawn );
+    drawn.Reset();
 }
 
 //////////////////////////////////////////////////////////////////
-// [PUBLIC] Changes the color of a single pixel
-void Graphics::ChangePixel(
-    const Vec2<int>& pos,
-    const Color&     color )
+// [PUBLIC] Presents the whole frame on the next update
+void Graphics::Invalidate() noexcept { presentAll = true; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Rasterizes every deferred draw call into the 
+//          framebuffer
+void Graphics::Flush()
 {
-    assert( pos.x >= 0 && pos.x < clientWidth );
-    assert( pos.y >= 0 && pos.y < clientHeight );
+    if ( tiles )
+        tiles->Flush( framebuffer, depthBuffer.get() );
+}
 
-    // Set our pixel variable to the address of the start of our memory block
-    uint32_t* pixel = (uint32_t*)memory;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records draw calls instead of drawing them
+void Graphics::EnableDeferred( unsigned threadCount )
+{
+    // Anything recorded with a previous pool must be finished first
+    Flush();
+    tiles = std::make_unique<TileRenderer>( threadCount );
+}
 
-    // Move to the desired coordinate
-    pixel += pos.y * clientWidth + pos.x;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Flushes any recorded draw calls and returns to drawing
+//          immediately on the calling thread
+void Graphics::DisableDeferred()
+{
+    Flush();
+    tiles.reset();
+}
 
-    // Change the pixel stored at this coordinate to our passed in color
-    *pixel = color.hex;
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if draw calls are currently being recorded
+bool Graphics::DeferredIsEnabled() const noexcept { return tiles != nullptr; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Presents and clears frames on a dedicated thread
+void Graphics::EnableSwapChain( unsigned bufferCount )
+{
+    DisableSwapChain();
+    swapChain = std::make_unique<SwapChain>( 
+        framebuffer.GetWidth(), 
+        framebuffer.GetHeight(), 
+        bufferCount, 
+        std::move( presenter ), 
+        defaultColor.hex );
+
+    // The spare buffers are clean but the screen may not match the last frame presented here
+    presentAll = true;
 }
 
 //////////////////////////////////////////////////////////////////
-// [PUBLIC] Displays the current frame to the screen and resets
-void Graphics::Update()
+// [PUBLIC] Waits for queued frames and returns to presenting on 
+//          the calling thread
+void Graphics::DisableSwapChain()
 {
-    // Method that takes in a device independent bitmap and draws it to the screen
-    StretchDIBits(
-        hdc,				// Handle to destination (window)
-        0,					// Upper left x coordinate of destination (window)
-        0,					// Upper left y coordinate of destination (window)
-        clientWidth,		// Width of destination (window)
-        clientHeight,		// Height of destination (window)
-        0,					// Upper left x coordinate of source (bitmap)
-        0,					// Upper left y coordinate of source (bitmap)
-        clientWidth,		// Width of source (bitmap)
-        clientHeight,		// Height of source (bitmap)
-        memory,				// Pointer to our allocated location in memory
-        &bitmap,			// The bitmap we created and will display to screen
-        DIB_RGB_COLORS,		// Tells the function that we are using RGB values
-        SRCCOPY				// Directly copy the source to destination, no funny business
-    );
-
-    // Set the screen to the default color
-    ClearScreen( defaultColor );
+    if ( !swapChain )
+        return;
+
+    presenter = swapChain->ReleasePresenter();
+    swapChain.reset();
+    shown.Reset();
+    presentAll = true;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if frames are presented on their own 
+//          thread
+bool Graphics::SwapChainIsEnabled() const noexcept { return swapChain != nullptr; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Blocks until every frame passed to Update has been 
+//          presented
+void Graphics::WaitForPresent()
+{
+    if ( swapChain )
+        swapChain->Wait();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records every frame passed to Update to a file
+void Graphics::EnableCapture(
+    const std::filesystem::path& path,
+    CaptureFormat                format,
+    unsigned                     slotCount )
+{
+    // The previous capture is finished first so it never shares a file with the new one
+    DisableCapture();
+    recorder = std::make_unique<FrameRecorder>( path, framebuffer.GetWidth(), framebuffer.GetHeight(), format, slotCount );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Writes every frame still waiting and closes the capture
+void Graphics::DisableCapture() { recorder.reset(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the recorder frames are captured with
+const FrameRecorder* Graphics::GetCapture() const noexcept { return recorder.get(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the surface that all draw calls target
+Framebuffer& Graphics::GetFramebuffer() noexcept
+{
+    drawn.AddAll();
+    return framebuffer;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the surface that all draw calls target
+const Framebuffer& Graphics::GetFramebuffer() const noexcept { return framebuffer; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Allocates a depth buffer that triangles drawn with depth
+//          are tested against
+void Graphics::EnableDepth()
+{
+    // Recorded draw calls were submitted without depth and run without it
+    Flush();
+    if ( !depthBuffer )
+        depthBuffer = std::make_unique<DepthBuffer>( framebuffer.GetWidth(), framebuffer.GetHeight() );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Frees the depth buffer
+void Graphics::DisableDepth()
+{
+    Flush();
+    depthBuffer.reset();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if triangles with depth are depth tested
+bool Graphics::DepthIsEnabled() const noexcept { return depthBuffer != nullptr; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the depth buffer, null when depth is disabled
+const DepthBuffer* Graphics::GetDepthBuffer() const noexcept { return depthBuffer.get(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects the algorithm used by DrawTriangle
+void Graphics::SetTriangleRasterizer( TriangleRasterizer rasterizer ) noexcept { triangleRasterizer = rasterizer; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the algorithm used by DrawTriangle
+Graphics::TriangleRasterizer Graphics::GetTriangleRasterizer() const noexcept { return triangleRasterizer; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects how following draw calls combine with the 
+//          surface
+void Graphics::SetBlendMode( BlendMode mode ) noexcept { blendMode = mode; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns how draw calls combine with the surface
+BlendMode Graphics::GetBlendMode() const noexcept { return blendMode; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects the width of following lines
+void Graphics::SetLineWidth( float width ) noexcept { lineWidth = std::max( width, 1.0f ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of lines in pixels
+float Graphics::GetLineWidth() const noexcept { return lineWidth; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects whether following lines blend their edges by 
+//          how much of each pixel they cover
+void Graphics::SetLineAntialiasing( bool antialias ) noexcept { lineAntialiasing = antialias; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if lines are anti-aliased
+bool Graphics::GetLineAntialiasing() const noexcept { return lineAntialiasing; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects which parts of following polygons are filled
+void Graphics::SetFillRule( FillRule rule ) noexcept { fillRule = rule; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns which parts of polygons are filled
+FillRule Graphics::GetFillRule() const noexcept { return fillRule; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects how closely following paths follow their curves
+void Graphics::SetCurveTolerance( float tolerance ) noexcept { curveTolerance = std::max( tolerance, 1.0f / HalfSpace::subpixelScale ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns how far in pixels flattened curves may stray
+float Graphics::GetCurveTolerance() const noexcept { return curveTolerance; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects the font of following strings
+void Graphics::SetFont( const Font& font ) noexcept { this->font = &font; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the font strings are drawn with
+const Font& Graphics::GetFont() const noexcept { return *font; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects how large following strings are drawn
+void Graphics::SetTextScale( int scale ) noexcept { textScale = std::clamp( scale, 1, TextCache::maxScale ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns how many pixels each pixel of the font covers
+int Graphics::GetTextScale() const noexcept { return textScale; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Selects how following textured triangles combine texels
+void Graphics::SetTextureFilter( TextureFilter filter ) noexcept { textureFilter = filter; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns how textured triangles combine texels
+TextureFilter Graphics::GetTextureFilter() const noexcept { return textureFilter; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] Graphics                                                            */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Submits the lines of a polyline whose points are 
+//           already in the coordinates of its commands
+void Graphics::SubmitPolyline(
+    const Vec2<int>* points,
+    size_t           pointCount,
+    bool             closed,
+    bool             stroke,
+    const Color&     color )
+{
+    if ( pointCount < 2 )
+        return;
+
+    // Each line knows its neighbours, an aliased line skips the point the line before it drew and a
+    // stroke leaves the pixels around each joint to whichever side covers them more
+    const size_t lineCount = closed ? pointCount : pointCount - 1;
+    for ( size_t i = 0; i < lineCount; ++i )
+    {
+        const Vec2<int>& start = points[i];
+        const Vec2<int>& end = points[( i + 1 ) % pointCount];
+        const Vec2<int>& previous = closed ? points[( i + pointCount - 1 ) % pointCount] : points[i > 0 ? i - 1 : i];
+        const Vec2<int>& next = closed ? points[( i + 2 ) % pointCount] : points[i + 2 < pointCount ? i + 2 : i + 1];
+        if ( stroke )
+        {
+            Submit( DrawCommand( start, end, previous, next, lineWidth, lineAntialiasing, color.hex, blendMode ) );
+            continue;
+        }
+
+        DrawCommand command( DrawCommand::Type::LINE, start, end, end, color.hex, blendMode );
+        command.joins[0] = previous;
+        Submit( command );
+    }
 }
 
 //////////////////////////////////////////////////////////////////
 // [PRIVATE] Clears the entire screen with a single color
 void Graphics::ClearScreen( const Color& color )
 {
-    // Set our pixel variable to the address of the start of our memory block
-    uint32_t* pixel = (uint32_t*)memory;
+    // Deferred clears happen per tile while the tile is in cache
+    if ( tiles )
+        return tiles->Clear( color.hex );
+
+    // Vectorized fill over the whole surface
+    SpanFill::Clear( framebuffer, color.hex );
+}
 
-    // Loop through every pixel in the memory
-    for ( size_t i = 0; i < static_cast<size_t>( clientWidth * clientHeight ); ++i )
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Clears the tiles of a region with a single color
+void Graphics::ClearRegion(
+    const DirtyRegion& region,
+    const Color&       color )
+{
+    region.GetRects( dirtyRects );
+    for ( const Rect& rect : dirtyRects )
     {
-        // Set the current pixel to our passed in color and move on to the next
-        *pixel++ = color.hex;
+        // Deferred clears are recorded as rectangles so they are binned with the tiles they cover
+        if ( tiles )
+            tiles->Submit( DrawCommand( 
+                DrawCommand::Type::RECTANGLE, 
+                { rect.left, rect.bottom }, 
+                { rect.right, rect.top }, 
+                { rect.right, rect.top }, 
+                color.hex ) );
+        else
+            for ( int y = rect.bottom; y < rect.top; ++y )
+                SpanFill::Fill( framebuffer.GetRow( y ) + rect.left, static_cast<size_t>( rect.right - rect.left ), color.hex );
     }
 }
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Returns the command a mesh's triangles are drawn with
+DrawCommand::Type Graphics::GetMeshType(
+    MeshColors   colorMode,
+    const float* depths ) const noexcept
+{
+    // Depth and interpolated colors are only supported by the half-space rasterizer
+    if ( colorMode == MeshColors::PER_VERTEX )
+        return DrawCommand::Type::TRIANGLE_SHADED;
+    if ( depths )
+        return DrawCommand::Type::TRIANGLE_DEPTH;
+    return triangleRasterizer == TriangleRasterizer::HALFSPACE ? DrawCommand::Type::TRIANGLE_HALFSPACE : DrawCommand::Type::TRIANGLE_SCANLINE;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Culls and submits the triangles of a mesh whose 
+//          vertices are already converted
+void Graphics::SubmitMesh(
+    const uint32_t*   indices,
+    size_t            indexCount,
+    const Color*      colors,
+    MeshColors        colorMode,
+    const float*      depths,
+    DrawCommand::Type type,
+    int               shift )
+{
+    const bool shaded = colorMode == MeshColors::PER_VERTEX;
+    const size_t vertexCount = meshVertices.size();
+    const Rect surface( 0, 0, framebuffer.GetWidth() << shift, framebuffer.GetHeight() << shift );
+    const size_t triangleCount = ( indices ? indexCount : vertexCount ) / 3;
+    for ( size_t t = 0; t < triangleCount; ++t )
+    {
+        const size_t i0 = indices ? indices[t * 3] : t * 3;
+        const size_t i1 = indices ? indices[t * 3 + 1] : t * 3 + 1;
+        const size_t i2 = indices ? indices[t * 3 + 2] : t * 3 + 2;
+        assert( i0 < vertexCount && i1 < vertexCount && i2 < vertexCount );
+
+        // Collinear vertices cover nothing, cull before a command is ever built
+        const Vec2<int>& a = meshVertices[i0];
+        const Vec2<int>& b = meshVertices[i1];
+        const Vec2<int>& c = meshVertices[i2];
+        const int64_t area = 
+            static_cast<int64_t>( b.x - a.x ) * ( c.y - a.y ) - 
+            static_cast<int64_t>( b.y - a.y ) * ( c.x - a.x );
+        if ( area == 0 )
+            continue;
+
+        // So are triangles entirely off the surface
+        if ( std::max( { a.x, b.x, c.x } ) < surface.left || std::min( { a.x, b.x, c.x } ) >= surface.right ||
+             std::max( { a.y, b.y, c.y } ) < surface.bottom || std::min( { a.y, b.y, c.y } ) >= surface.top )
+            continue;
+
+        const float z[3] = { depths ? depths[i0] : 0.0f, depths ? depths[i1] : 0.0f, depths ? depths[i2] : 0.0f };
+        if ( shaded )
+        {
+            float attributes[12];
+            ColorAttributes( colors[i0], attributes );
+            ColorAttributes( colors[i1], attributes + 4 );
+            ColorAttributes( colors[i2], attributes + 8 );
+            Submit( DrawCommand( 
+                a, b, c, depths ? z : nullptr, 
+                attributes, 4, Shading::Gouraud, nullptr, blendMode ) );
+        }
+        else if ( depths )
+            Submit( DrawCommand( a, b, c, z, colors[t].hex, blendMode ) );
+        else
+            Submit( DrawCommand( type, a, b, c, colors[t].hex, blendMode ) );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Draws a command now or records it if deferred
+void Graphics::Submit( const DrawCommand& command )
+{
+    if ( recording )
+        return recording->Append( command );
+
+    drawn.Add( command.bounds );
+    if ( tiles )
+        tiles->Submit( command );
+    else
+        command.Execute( framebuffer, Rect( 0, 0, framebuffer.GetWidth(), framebuffer.GetHeight() ), depthBuffer.get() );
+}
+
+
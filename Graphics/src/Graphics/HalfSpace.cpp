@@ -0,0 +1,981 @@
+#include "Graphics/HalfSpace.h"
+#include "Graphics/TileRenderer.h"
+#include "Utility/Simd.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#ifdef GFX_X86
+#include <immintrin.h>
+#endif
+
+//////////////////////////////////////////////////////////////////
+// Linear edge function stepped per pixel, positive on the inside
+struct Edge
+{
+    int64_t stepX;
+    int64_t stepY;
+    int64_t origin;
+};
+
+//////////////////////////////////////////////////////////////////
+// A block clipped to the region along with the values of the
+//      edges that straddle it, at the center of its first pixel
+struct Block
+{
+    uint32_t* row;
+    int pitch;
+    int left;
+    int right;
+    int rows;
+    int32_t value[3];
+    int32_t stepX[3];
+    int32_t stepY[3];
+};
+
+//////////////////////////////////////////////////////////////////
+// Depths of the rows of a block and the triangle's depth plane, a
+//      pixel's depth is ( plane[0] + plane[2] * y ) + plane[1] * x
+//      in every kernel so they all agree to the bit
+struct DepthRows
+{
+    float* row;
+    int pitch;
+    int x;
+    int y;
+    const float* plane;
+
+    // Blocks the triangle is entirely in front of skip the comparison
+    bool test;
+};
+
+static_assert( DepthBuffer::blockSize == HalfSpace::blockSize, "Depth blocks must match rasterizer blocks" );
+static_assert( DepthBuffer::tileSize == TileRenderer::tileSize, "Depth tiles must match render tiles" );
+
+//////////////////////////////////////////////////////////////////
+// Returns the depth of the triangle's plane at the center of a pixel
+static inline float DepthAt(
+    const float* plane,
+    int          x,
+    int          y ) noexcept
+{
+    const float row = plane[0] + plane[2] * static_cast<float>( y );
+    return row + plane[1] * static_cast<float>( x );
+}
+
+//////////////////////////////////////////////////////////////////
+// Finds the nearest and farthest depth of the plane over a range of
+//      pixels, rounding is monotonic in x and in y so the corners 
+//      bound every pixel exactly as the kernels compute it
+static void DepthRange(
+    const float* plane,
+    int          left,
+    int          bottom,
+    int          right,
+    int          top,
+    float&       nearest,
+    float&       farthest ) noexcept
+{
+    const float corners[4] = { 
+        DepthAt( plane, left, bottom ), DepthAt( plane, right, bottom ), 
+        DepthAt( plane, left, top ), DepthAt( plane, right, top ) };
+    nearest = std::min( { corners[0], corners[1], corners[2], corners[3] } );
+    farthest = std::max( { corners[0], corners[1], corners[2], corners[3] } );
+}
+
+//////////////////////////////////////////////////////////////////
+// Solves for the change per subpixel in x and in y of a value given
+//      at each vertex, false for triangles with no area
+static bool Gradient(
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    double           a1,
+    double           a2,
+    double           a3,
+    double&          dx,
+    double&          dy ) noexcept
+{
+    const double x1 = v2.x - v1.x, y1 = v2.y - v1.y, x2 = v3.x - v1.x, y2 = v3.y - v1.y;
+    const double area = x1 * y2 - y1 * x2;
+    if ( area == 0.0 )
+        return false;
+
+    const double d1 = a2 - a1, d2 = a3 - a1;
+    dx = ( d1 * y2 - d2 * y1 ) / area;
+    dy = ( d2 * x1 - d1 * x2 ) / area;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// Divides rounding toward negative infinity, the divisor is positive
+static inline int64_t FloorDivide(
+    int64_t value,
+    int64_t divisor ) noexcept
+{
+    return value >= 0 ? value / divisor : -( ( divisor - 1 - value ) / divisor );
+}
+
+/* ======================================================================================================= */
+/*                           Kernels                                                                       */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// Fills every pixel of a fully covered, unclipped block
+static void FillFull(
+    uint32_t*    row,
+    int          pitch,
+    const Paint& paint ) noexcept
+{
+    for ( int y = 0; y < HalfSpace::blockSize; ++y, row += pitch )
+        for ( int x = 0; x < HalfSpace::blockSize; ++x )
+            row[x] = paint.color;
+}
+
+//////////////////////////////////////////////////////////////////
+// Blends into the covered pixels of a block row a run at a time, a
+//      triangle alone covers a single run of any row but the depth 
+//      test can split it
+static inline void BlendCovered(
+    uint32_t*    row,
+    unsigned     covered,
+    const Paint& paint ) noexcept
+{
+    while ( covered != 0u )
+    {
+        const int start = std::countr_zero( covered );
+        const int length = std::countr_one( covered >> start );
+        Blend::Span( row + start, static_cast<size_t>( length ), paint );
+        covered &= ~( ( ( 1u << length ) - 1u ) << start );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Tests each pixel of a partially covered block one at a time
+static void FillPartialScalar(
+    const Block& block,
+    const Paint& paint ) noexcept
+{
+    int32_t rowValue[3] = { block.value[0], block.value[1], block.value[2] };
+    uint32_t* row = block.row;
+
+    for ( int y = 0; y < block.rows; ++y, row += block.pitch )
+    {
+        int32_t value[3] = { rowValue[0], rowValue[1], rowValue[2] };
+        for ( int x = 0; x < HalfSpace::blockSize; ++x )
+        {
+            // Inside when no edge function has its sign bit set
+            if ( x >= block.left && x < block.right && ( value[0] | value[1] | value[2] ) >= 0 )
+                row[x] = Blend::Pixel( row[x], paint );
+
+            for ( int i = 0; i < 3; ++i )
+                value[i] += block.stepX[i];
+        }
+
+        for ( int i = 0; i < 3; ++i )
+            rowValue[i] += block.stepY[i];
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Tests coverage and depth of each pixel of a block one at a time
+static void FillDepthScalar(
+    const Block&     block,
+    const DepthRows& depth,
+    const Paint&     paint ) noexcept
+{
+    int32_t rowValue[3] = { block.value[0], block.value[1], block.value[2] };
+    uint32_t* row = block.row;
+    float* depthRow = depth.row;
+
+    for ( int y = 0; y < block.rows; ++y, row += block.pitch, depthRow += depth.pitch )
+    {
+        int32_t value[3] = { rowValue[0], rowValue[1], rowValue[2] };
+        for ( int x = 0; x < HalfSpace::blockSize; ++x )
+        {
+            if ( x >= block.left && x < block.right && ( value[0] | value[1] | value[2] ) >= 0 )
+            {
+                const float z = DepthAt( depth.plane, depth.x + x, depth.y + y );
+                if ( !depth.test || z < depthRow[x] )
+                {
+                    depthRow[x] = z;
+                    row[x] = Blend::Pixel( row[x], paint );
+                }
+            }
+
+            for ( int i = 0; i < 3; ++i )
+                value[i] += block.stepX[i];
+        }
+
+        for ( int i = 0; i < 3; ++i )
+            rowValue[i] += block.stepY[i];
+    }
+}
+
+#ifdef GFX_X86
+//////////////////////////////////////////////////////////////////
+// Tests 4 pixels at a time, selecting the color into each half row
+static void FillPartialSse2(
+    const Block& block,
+    const Paint& paint ) noexcept
+{
+    const __m128i lane = _mm_setr_epi32( 0, 1, 2, 3 );
+    const __m128i fill = _mm_set1_epi32( static_cast<int>( paint.color ) );
+
+    // Lanes outside of the clipped columns are never written
+    const __m128i left = _mm_set1_epi32( block.left - 1 );
+    const __m128i right = _mm_set1_epi32( block.right );
+    const __m128i four = _mm_set1_epi32( 4 );
+    const __m128i lo = _mm_and_si128( _mm_cmpgt_epi32( lane, left ), _mm_cmplt_epi32( lane, right ) );
+    const __m128i laneHi = _mm_add_epi32( lane, four );
+    const __m128i hi = _mm_and_si128( _mm_cmpgt_epi32( laneHi, left ), _mm_cmplt_epi32( laneHi, right ) );
+
+    // Edge values for the left half of the first row, the right half is four steps further
+    __m128i valueLo[3], valueHi[3], stepY[3];
+    for ( int i = 0; i < 3; ++i )
+    {
+        const __m128i stepX = _mm_set1_epi32( block.stepX[i] );
+        const __m128i offset = _mm_setr_epi32( 0, block.stepX[i], block.stepX[i] * 2, block.stepX[i] * 3 );
+        valueLo[i] = _mm_add_epi32( _mm_set1_epi32( block.value[i] ), offset );
+        valueHi[i] = _mm_add_epi32( valueLo[i], _mm_slli_epi32( stepX, 2 ) );
+        stepY[i] = _mm_set1_epi32( block.stepY[i] );
+    }
+
+    uint32_t* row = block.row;
+    for ( int y = 0; y < block.rows; ++y, row += block.pitch )
+    {
+        // Sign bit of the combined values is set if any edge rejects the pixel
+        const __m128i outLo = _mm_or_si128( _mm_or_si128( valueLo[0], valueLo[1] ), valueLo[2] );
+        const __m128i outHi = _mm_or_si128( _mm_or_si128( valueHi[0], valueHi[1] ), valueHi[2] );
+        const __m128i maskLo = _mm_andnot_si128( _mm_srai_epi32( outLo, 31 ), lo );
+        const __m128i maskHi = _mm_andnot_si128( _mm_srai_epi32( outHi, 31 ), hi );
+
+        if ( !paint.replace )
+        {
+            const int covered = _mm_movemask_ps( _mm_castsi128_ps( maskLo ) ) | ( _mm_movemask_ps( _mm_castsi128_ps( maskHi ) ) << 4 );
+            BlendCovered( row, static_cast<unsigned>( covered ), paint );
+        }
+        else
+        {
+            __m128i* p = reinterpret_cast<__m128i*>( row );
+            const __m128i dstLo = _mm_loadu_si128( p );
+            const __m128i dstHi = _mm_loadu_si128( p + 1 );
+            _mm_storeu_si128( p, _mm_or_si128( _mm_and_si128( maskLo, fill ), _mm_andnot_si128( maskLo, dstLo ) ) );
+            _mm_storeu_si128( p + 1, _mm_or_si128( _mm_and_si128( maskHi, fill ), _mm_andnot_si128( maskHi, dstHi ) ) );
+        }
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            valueLo[i] = _mm_add_epi32( valueLo[i], stepY[i] );
+            valueHi[i] = _mm_add_epi32( valueHi[i], stepY[i] );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Tests a whole row of 8 pixels at a time with masked stores
+GFX_TARGET_AVX2 static void FillPartialAvx2(
+    const Block& block,
+    const Paint& paint ) noexcept
+{
+    const __m256i lane = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+    const __m256i fill = _mm256_set1_epi32( static_cast<int>( paint.color ) );
+
+    // Lanes outside of the clipped columns are never written
+    const __m256i columns = _mm256_and_si256( 
+        _mm256_cmpgt_epi32( lane, _mm256_set1_epi32( block.left - 1 ) ),
+        _mm256_cmpgt_epi32( _mm256_set1_epi32( block.right ), lane ) );
+
+    __m256i value[3], stepY[3];
+    for ( int i = 0; i < 3; ++i )
+    {
+        value[i] = _mm256_add_epi32( _mm256_set1_epi32( block.value[i] ), _mm256_mullo_epi32( lane, _mm256_set1_epi32( block.stepX[i] ) ) );
+        stepY[i] = _mm256_set1_epi32( block.stepY[i] );
+    }
+
+    uint32_t* row = block.row;
+    for ( int y = 0; y < block.rows; ++y, row += block.pitch )
+    {
+        // Sign bit of the combined values is set if any edge rejects the pixel
+        const __m256i out = _mm256_or_si256( _mm256_or_si256( value[0], value[1] ), value[2] );
+        const __m256i mask = _mm256_andnot_si256( out, columns );
+        if ( !paint.replace )
+            BlendCovered( row, static_cast<unsigned>( _mm256_movemask_ps( _mm256_castsi256_ps( mask ) ) ), paint );
+        else
+            _mm256_maskstore_epi32( reinterpret_cast<int*>( row ), mask, fill );
+
+        for ( int i = 0; i < 3; ++i )
+            value[i] = _mm256_add_epi32( value[i], stepY[i] );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Tests coverage and depth 4 pixels at a time
+static void FillDepthSse2(
+    const Block&     block,
+    const DepthRows& depth,
+    const Paint&     paint ) noexcept
+{
+    const __m128i lane = _mm_setr_epi32( 0, 1, 2, 3 );
+    const __m128i fill = _mm_set1_epi32( static_cast<int>( paint.color ) );
+
+    const __m128i left = _mm_set1_epi32( block.left - 1 );
+    const __m128i right = _mm_set1_epi32( block.right );
+    const __m128i four = _mm_set1_epi32( 4 );
+    const __m128i laneHi = _mm_add_epi32( lane, four );
+    const __m128i lo = _mm_and_si128( _mm_cmpgt_epi32( lane, left ), _mm_cmplt_epi32( lane, right ) );
+    const __m128i hi = _mm_and_si128( _mm_cmpgt_epi32( laneHi, left ), _mm_cmplt_epi32( laneHi, right ) );
+
+    // Depth per column is the row's depth plus a constant offset, the same products the scalar kernel forms
+    const __m128 stepZ = _mm_set1_ps( depth.plane[1] );
+    const __m128 columnLo = _mm_mul_ps( stepZ, _mm_cvtepi32_ps( _mm_add_epi32( _mm_set1_epi32( depth.x ), lane ) ) );
+    const __m128 columnHi = _mm_mul_ps( stepZ, _mm_cvtepi32_ps( _mm_add_epi32( _mm_set1_epi32( depth.x ), laneHi ) ) );
+
+    __m128i valueLo[3], valueHi[3], stepY[3];
+    for ( int i = 0; i < 3; ++i )
+    {
+        const __m128i stepX = _mm_set1_epi32( block.stepX[i] );
+        const __m128i offset = _mm_setr_epi32( 0, block.stepX[i], block.stepX[i] * 2, block.stepX[i] * 3 );
+        valueLo[i] = _mm_add_epi32( _mm_set1_epi32( block.value[i] ), offset );
+        valueHi[i] = _mm_add_epi32( valueLo[i], _mm_slli_epi32( stepX, 2 ) );
+        stepY[i] = _mm_set1_epi32( block.stepY[i] );
+    }
+
+    uint32_t* row = block.row;
+    float* depthRow = depth.row;
+    for ( int y = 0; y < block.rows; ++y, row += block.pitch, depthRow += depth.pitch )
+    {
+        const __m128i outLo = _mm_or_si128( _mm_or_si128( valueLo[0], valueLo[1] ), valueLo[2] );
+        const __m128i outHi = _mm_or_si128( _mm_or_si128( valueHi[0], valueHi[1] ), valueHi[2] );
+        __m128i maskLo = _mm_andnot_si128( _mm_srai_epi32( outLo, 31 ), lo );
+        __m128i maskHi = _mm_andnot_si128( _mm_srai_epi32( outHi, 31 ), hi );
+
+        const __m128 rowZ = _mm_set1_ps( depth.plane[0] + depth.plane[2] * static_cast<float>( depth.y + y ) );
+        const __m128 zLo = _mm_add_ps( rowZ, columnLo ), zHi = _mm_add_ps( rowZ, columnHi );
+        const __m128 oldLo = _mm_loadu_ps( depthRow ), oldHi = _mm_loadu_ps( depthRow + 4 );
+        if ( depth.test )
+        {
+            maskLo = _mm_and_si128( maskLo, _mm_castps_si128( _mm_cmplt_ps( zLo, oldLo ) ) );
+            maskHi = _mm_and_si128( maskHi, _mm_castps_si128( _mm_cmplt_ps( zHi, oldHi ) ) );
+        }
+
+        const __m128 passLo = _mm_castsi128_ps( maskLo ), passHi = _mm_castsi128_ps( maskHi );
+        _mm_storeu_ps( depthRow, _mm_or_ps( _mm_and_ps( passLo, zLo ), _mm_andnot_ps( passLo, oldLo ) ) );
+        _mm_storeu_ps( depthRow + 4, _mm_or_ps( _mm_and_ps( passHi, zHi ), _mm_andnot_ps( passHi, oldHi ) ) );
+
+        if ( !paint.replace )
+            BlendCovered( row, static_cast<unsigned>( _mm_movemask_ps( passLo ) | ( _mm_movemask_ps( passHi ) << 4 ) ), paint );
+        else
+        {
+            __m128i* p = reinterpret_cast<__m128i*>( row );
+            const __m128i dstLo = _mm_loadu_si128( p );
+            const __m128i dstHi = _mm_loadu_si128( p + 1 );
+            _mm_storeu_si128( p, _mm_or_si128( _mm_and_si128( maskLo, fill ), _mm_andnot_si128( maskLo, dstLo ) ) );
+            _mm_storeu_si128( p + 1, _mm_or_si128( _mm_and_si128( maskHi, fill ), _mm_andnot_si128( maskHi, dstHi ) ) );
+        }
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            valueLo[i] = _mm_add_epi32( valueLo[i], stepY[i] );
+            valueHi[i] = _mm_add_epi32( valueHi[i], stepY[i] );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Tests coverage and depth of a whole row of 8 pixels at a time
+GFX_TARGET_AVX2 static void FillDepthAvx2(
+    const Block&     block,
+    const DepthRows& depth,
+    const Paint&     paint ) noexcept
+{
+    const __m256i lane = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+    const __m256i fill = _mm256_set1_epi32( static_cast<int>( paint.color ) );
+    const __m256i columns = _mm256_and_si256( 
+        _mm256_cmpgt_epi32( lane, _mm256_set1_epi32( block.left - 1 ) ),
+        _mm256_cmpgt_epi32( _mm256_set1_epi32( block.right ), lane ) );
+    const __m256 column = _mm256_mul_ps( 
+        _mm256_set1_ps( depth.plane[1] ), 
+        _mm256_cvtepi32_ps( _mm256_add_epi32( _mm256_set1_epi32( depth.x ), lane ) ) );
+
+    __m256i value[3], stepY[3];
+    for ( int i = 0; i < 3; ++i )
+    {
+        value[i] = _mm256_add_epi32( _mm256_set1_epi32( block.value[i] ), _mm256_mullo_epi32( lane, _mm256_set1_epi32( block.stepX[i] ) ) );
+        stepY[i] = _mm256_set1_epi32( block.stepY[i] );
+    }
+
+    uint32_t* row = block.row;
+    float* depthRow = depth.row;
+    for ( int y = 0; y < block.rows; ++y, row += block.pitch, depthRow += depth.pitch )
+    {
+        const __m256i out = _mm256_or_si256( _mm256_or_si256( value[0], value[1] ), value[2] );
+        __m256i mask = _mm256_andnot_si256( out, columns );
+
+        // Only sign bits of the mask are meaningful. Blocks never straddle tiles, so writing back 
+        // unchanged lanes can't race another thread
+        const __m256 z = _mm256_add_ps( _mm256_set1_ps( depth.plane[0] + depth.plane[2] * static_cast<float>( depth.y + y ) ), column );
+        const __m256 old = _mm256_loadu_ps( depthRow );
+        if ( depth.test )
+            mask = _mm256_and_si256( mask, _mm256_castps_si256( _mm256_cmp_ps( z, old, _CMP_LT_OQ ) ) );
+        _mm256_storeu_ps( depthRow, _mm256_blendv_ps( old, z, _mm256_castsi256_ps( mask ) ) );
+
+        if ( !paint.replace )
+            BlendCovered( row, static_cast<unsigned>( _mm256_movemask_ps( _mm256_castsi256_ps( mask ) ) ), paint );
+        else
+        {
+            float* p = reinterpret_cast<float*>( row );
+            _mm256_storeu_ps( p, _mm256_blendv_ps( _mm256_loadu_ps( p ), _mm256_castsi256_ps( fill ), _mm256_castsi256_ps( mask ) ) );
+        }
+
+        for ( int i = 0; i < 3; ++i )
+            value[i] = _mm256_add_epi32( value[i], stepY[i] );
+    }
+}
+#endif
+
+//////////////////////////////////////////////////////////////////
+// Walks the rows of a shaded triangle, solving each edge for the 
+//      exact span it leaves covered so the pixels match the block 
+//      walk and the shader sees whole runs. With depth the span is
+//      split into runs of pixels that pass the test
+static void ShadeRows(
+    Framebuffer&     frame,
+    DepthBuffer*     depth,
+    const Edge*      edges,
+    int              minX,
+    int              minY,
+    int              maxX,
+    int              maxY,
+    const float*     plane,
+    const Gradients& shade ) noexcept
+{
+    ShadedSpan span;
+    span.attributeCount = shade.count;
+    span.blend = shade.blend;
+    for ( int c = 0; c < shade.count; ++c )
+        span.step[c] = static_cast<int32_t>( shade.stepX[c] );
+
+    for ( int y = minY; y < maxY; ++y )
+    {
+        // Each edge bounds the row from one side, or covers all or none of it when horizontal
+        int64_t left = minX, right = maxX;
+        for ( int i = 0; i < 3; ++i )
+        {
+            const int64_t row = edges[i].origin + edges[i].stepY * y;
+            if ( edges[i].stepX > 0 )
+                left = std::max( left, -FloorDivide( row, edges[i].stepX ) );
+            else if ( edges[i].stepX < 0 )
+                right = std::min( right, FloorDivide( row, -edges[i].stepX ) + 1 );
+            else if ( row < 0 )
+                right = left;
+        }
+        if ( left >= right )
+            continue;
+
+        uint32_t* pixels = frame.GetRow( y );
+        auto emit = [&]( int from, int to )
+        {
+            span.x = from;
+            span.y = y;
+            span.count = to - from;
+            for ( int c = 0; c < shade.count; ++c )
+                span.value[c] = static_cast<int32_t>( shade.value[c] + shade.stepX[c] * ( from - shade.x0 ) + shade.stepY[c] * ( y - shade.y0 ) );
+            shade.shader( pixels + from, span, shade.user );
+        };
+
+        if ( !depth )
+        {
+            emit( static_cast<int>( left ), static_cast<int>( right ) );
+            continue;
+        }
+
+        float* depths = depth->GetRow( y );
+        int run = -1;
+        for ( int x = static_cast<int>( left ); x < right; ++x )
+        {
+            const float z = DepthAt( plane, x, y );
+            if ( z < depths[x] )
+            {
+                depths[x] = z;
+                if ( run < 0 )
+                    run = x;
+            }
+            else if ( run >= 0 )
+            {
+                emit( run, x );
+                run = -1;
+            }
+        }
+        if ( run >= 0 )
+            emit( run, static_cast<int>( right ) );
+    }
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] HalfSpace                                                            */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills every pixel whose center lies inside a triangle
+void HalfSpace::FillTriangle(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const Paint&     paint ) noexcept
+{
+    Draw( frame, nullptr, clip, v1, v2, v3, nullptr, nullptr, paint );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills the pixels of a triangle that are nearer than the
+//          depth already stored there
+void HalfSpace::FillTriangle(
+    Framebuffer&     frame,
+    DepthBuffer&     depth,
+    const Rect&      clip,
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const float*     z,
+    const Paint&     paint ) noexcept
+{
+    // Solve for the plane through the vertices in fixed point, then convert to steps per pixel
+    double dzdx, dzdy;
+    if ( !Gradient( v1, v2, v3, z[0], z[1], z[2], dzdx, dzdy ) )
+        return;
+
+    constexpr double half = subpixelScale / 2;
+    const float plane[3] = {
+        static_cast<float>( z[0] + dzdx * ( half - v1.x ) + dzdy * ( half - v1.y ) ),
+        static_cast<float>( dzdx * subpixelScale ),
+        static_cast<float>( dzdy * subpixelScale ) };
+
+    Draw( frame, &depth, clip, v1, v2, v3, plane, nullptr, paint );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills a triangle with attributes interpolated from its 
+//          vertices
+void HalfSpace::ShadeTriangle(
+    Framebuffer&     frame,
+    DepthBuffer*     depth,
+    const Rect&      clip,
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const float*     z,
+    const float*     attributes,
+    int              attributeCount,
+    SpanShader       shader,
+    const void*      user,
+    BlendMode        blend ) noexcept
+{
+    // Attributes are taken at the center of the pixel holding the first vertex and stepped from there
+    Gradients shade;
+    shade.count = std::clamp( attributeCount, 0, Shading::maxAttributes );
+    shade.x0 = v1.x >> subpixelBits;
+    shade.y0 = v1.y >> subpixelBits;
+    shade.shader = shader;
+    shade.user = user;
+    shade.blend = blend;
+
+    constexpr double half = subpixelScale / 2;
+    const double centerX = double( shade.x0 ) * subpixelScale + half - v1.x;
+    const double centerY = double( shade.y0 ) * subpixelScale + half - v1.y;
+    for ( int c = 0; c < shade.count; ++c )
+    {
+        const float* a = attributes + c;
+        double dx, dy;
+        if ( !Gradient( v1, v2, v3, a[0], a[shade.count], a[shade.count * 2], dx, dy ) )
+            return;
+
+        shade.value[c] = std::llround( ( a[0] + dx * centerX + dy * centerY ) * Shading::one );
+        shade.stepX[c] = std::llround( dx * subpixelScale * Shading::one );
+        shade.stepY[c] = std::llround( dy * subpixelScale * Shading::one );
+    }
+
+    float plane[3] = { 0.0f, 0.0f, 0.0f };
+    if ( depth && z )
+    {
+        double dzdx, dzdy;
+        if ( !Gradient( v1, v2, v3, z[0], z[1], z[2], dzdx, dzdy ) )
+            return;
+
+        plane[0] = static_cast<float>( z[0] + dzdx * ( half - v1.x ) + dzdy * ( half - v1.y ) );
+        plane[1] = static_cast<float>( dzdx * subpixelScale );
+        plane[2] = static_cast<float>( dzdy * subpixelScale );
+    }
+
+    // The paint is never used by shaded rows
+    Draw( frame, z ? depth : nullptr, clip, v1, v2, v3, plane, &shade, Paint( 0u, blend ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills a triangle from a texture with perspective correct
+//          coordinates
+void HalfSpace::TextureTriangle(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const float*     uvw,
+    const Texture&   texture,
+    TextureFilter    filter,
+    BlendMode        blend ) noexcept
+{
+    if ( !( uvw[2] > 0.0f && uvw[5] > 0.0f && uvw[8] > 0.0f ) )
+        return;
+
+    // Planes are taken at the center of the pixel holding the first vertex like shaded attributes
+    TextureMapping mapping;
+    mapping.texture = &texture;
+    mapping.filter = filter;
+    mapping.x0 = v1.x >> subpixelBits;
+    mapping.y0 = v1.y >> subpixelBits;
+
+    constexpr double half = subpixelScale / 2;
+    const double centerX = double( mapping.x0 ) * subpixelScale + half - v1.x;
+    const double centerY = double( mapping.y0 ) * subpixelScale + half - v1.y;
+    float* planes[3] = { mapping.u, mapping.v, mapping.q };
+    for ( int c = 0; c < 3; ++c )
+    {
+        // u / w, v / w and 1 / w at each vertex
+        double a[3];
+        for ( int i = 0; i < 3; ++i )
+            a[i] = ( c == 2 ? 1.0 : double( uvw[i * 3 + c] ) ) / uvw[i * 3 + 2];
+
+        double dx, dy;
+        if ( !Gradient( v1, v2, v3, a[0], a[1], a[2], dx, dy ) )
+            return;
+
+        planes[c][0] = static_cast<float>( a[0] + dx * centerX + dy * centerY );
+        planes[c][1] = static_cast<float>( dx * subpixelScale );
+        planes[c][2] = static_cast<float>( dy * subpixelScale );
+    }
+
+    Gradients shade;
+    shade.count = 0;
+    shade.x0 = mapping.x0;
+    shade.y0 = mapping.y0;
+    shade.shader = Texture::Shade;
+    shade.user = &mapping;
+    shade.blend = blend;
+    Draw( frame, nullptr, clip, v1, v2, v3, nullptr, &shade, Paint( 0u, blend ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Converts a pixel coordinate to 28.4 fixed point
+int HalfSpace::ToSubpixel( float value ) noexcept
+{
+    return static_cast<int>( std::lround( std::clamp<double>( double( value ) * subpixelScale, -maxSubpixel, maxSubpixel ) ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Converts a whole pixel position to 28.4 fixed point
+Vec2<int> HalfSpace::ToSubpixel( const Vec2<int>& pixel ) noexcept
+{
+    // Widened first so neither the scale nor a far away vertex can wrap
+    auto convert = []( int value )
+    {
+        return static_cast<int>( std::clamp<int64_t>( int64_t( value ) * subpixelScale, -maxSubpixel, maxSubpixel ) );
+    };
+    return { convert( pixel.x ), convert( pixel.y ) };
+}
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] HalfSpace                                                           */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Rejects triangles outside the clip region and clips the
+//           rest against the guard band before rasterizing them
+void HalfSpace::Draw(
+    Framebuffer&     frame,
+    DepthBuffer*     depth,
+    const Rect&      clip,
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const float*     plane,
+    const Gradients* shade,
+    const Paint&     paint ) noexcept
+{
+    // Scissor test, triangles whose bounding box misses the clip region do no setup at all
+    const int64_t x[3] = { v1.x, v2.x, v3.x };
+    const int64_t y[3] = { v1.y, v2.y, v3.y };
+    const int64_t loX = std::min( { x[0], x[1], x[2] } ), hiX = std::max( { x[0], x[1], x[2] } );
+    const int64_t loY = std::min( { y[0], y[1], y[2] } ), hiY = std::max( { y[0], y[1], y[2] } );
+    if ( clip.IsEmpty() ||
+        ( hiX >> subpixelBits ) < clip.left || ( loX >> subpixelBits ) >= clip.right ||
+        ( hiY >> subpixelBits ) < clip.bottom || ( loY >> subpixelBits ) >= clip.top )
+        return;
+
+    // Most triangles fit in the guard band and skip geometric clipping entirely
+    constexpr int64_t band = int64_t( guardBand ) * subpixelScale;
+    if ( loX >= -band && hiX <= band && loY >= -band && hiY <= band )
+        return Rasterize( frame, depth, clip, x, y, plane, shade, paint );
+
+    // Clip the triangle against each side of the guard band, a triangle gains at most one vertex per side
+    double px[7] = { double( x[0] ), double( x[1] ), double( x[2] ) };
+    double py[7] = { double( y[0] ), double( y[1] ), double( y[2] ) };
+    int count = 3;
+    for ( int side = 0; side < 4 && count >= 3; ++side )
+    {
+        // Sides are x >= -band, x <= band, y >= -band, y <= band as distance inside the side
+        auto inside = [side]( double sx, double sy )
+        {
+            switch ( side )
+            {
+            case 0: return sx + band;
+            case 1: return band - sx;
+            case 2: return sy + band;
+            default: return band - sy;
+            }
+        };
+
+        double cx[7], cy[7];
+        int clipped = 0;
+        for ( int i = 0; i < count; ++i )
+        {
+            const int j = ( i + 1 ) % count;
+            const double di = inside( px[i], py[i] ), dj = inside( px[j], py[j] );
+            if ( di >= 0.0 )
+            {
+                cx[clipped] = px[i];
+                cy[clipped++] = py[i];
+            }
+            if ( ( di >= 0.0 ) != ( dj >= 0.0 ) )
+            {
+                // Interpolate from the inside end so an edge shared with a neighbour lands on the same point
+                const int a = di >= 0.0 ? i : j, b = di >= 0.0 ? j : i;
+                const double t = inside( px[a], py[a] ) / ( inside( px[a], py[a] ) - inside( px[b], py[b] ) );
+                cx[clipped] = px[a] + ( px[b] - px[a] ) * t;
+                cy[clipped++] = py[a] + ( py[b] - py[a] ) * t;
+            }
+        }
+
+        count = clipped;
+        std::copy( cx, cx + count, px );
+        std::copy( cy, cy + count, py );
+    }
+
+    // Fan out the clipped polygon, the top-left rule keeps the fan's internal edges watertight and the
+    // pieces keep the depth and attribute planes of the whole triangle
+    for ( int i = 1; i + 1 < count; ++i )
+    {
+        const int64_t fx[3] = { std::llround( px[0] ), std::llround( px[i] ), std::llround( px[i + 1] ) };
+        const int64_t fy[3] = { std::llround( py[0] ), std::llround( py[i] ), std::llround( py[i + 1] ) };
+        Rasterize( frame, depth, clip, fx, fy, plane, shade, paint );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Rasterizes a triangle known to lie inside the guard 
+//           band
+void HalfSpace::Rasterize(
+    Framebuffer&     frame,
+    DepthBuffer*     depth,
+    const Rect&      clip,
+    const int64_t*   vx,
+    const int64_t*   vy,
+    const float*     plane,
+    const Gradients* shade,
+    const Paint&     paint ) noexcept
+{
+    int64_t x[3] = { vx[0], vx[1], vx[2] };
+    int64_t y[3] = { vy[0], vy[1], vy[2] };
+
+    // Zero area triangles cover nothing, clockwise ones are flipped to counter clockwise
+    const int64_t area = ( x[1] - x[0] ) * ( y[2] - y[0] ) - ( y[1] - y[0] ) * ( x[2] - x[0] );
+    if ( area == 0 )
+        return;
+    if ( area < 0 )
+    {
+        std::swap( x[1], x[2] );
+        std::swap( y[1], y[2] );
+    }
+
+    // Bounding box of pixels whose centers (half a pixel in) can be covered, clipped to the region
+    constexpr int64_t half = subpixelScale / 2;
+    const int64_t loX = std::min( { x[0], x[1], x[2] } ), hiX = std::max( { x[0], x[1], x[2] } );
+    const int64_t loY = std::min( { y[0], y[1], y[2] } ), hiY = std::max( { y[0], y[1], y[2] } );
+    const int minX = static_cast<int>( std::max<int64_t>( ( loX - half + subpixelScale - 1 ) >> subpixelBits, clip.left ) );
+    const int minY = static_cast<int>( std::max<int64_t>( ( loY - half + subpixelScale - 1 ) >> subpixelBits, clip.bottom ) );
+    const int maxX = static_cast<int>( std::min<int64_t>( ( ( hiX - half ) >> subpixelBits ) + 1, clip.right ) );
+    const int maxY = static_cast<int>( std::min<int64_t>( ( ( hiY - half ) >> subpixelBits ) + 1, clip.top ) );
+    if ( minX >= maxX || minY >= maxY )
+        return;
+
+    // Triangles behind the farthest depth of every tile they reach are occluded before any setup
+    constexpr int tileSize = DepthBuffer::tileSize;
+    const int tileLeft = minX / tileSize, tileRight = ( maxX - 1 ) / tileSize;
+    const int tileBottom = minY / tileSize, tileTop = ( maxY - 1 ) / tileSize;
+    if ( depth )
+    {
+        float nearest, farthest;
+        DepthRange( plane, minX, minY, maxX - 1, maxY - 1, nearest, farthest );
+
+        bool occluded = true;
+        for ( int ty = tileBottom; ty <= tileTop && occluded; ++ty )
+            for ( int tx = tileLeft; tx <= tileRight && occluded; ++tx )
+                occluded = nearest >= depth->GetTileMax( tx, ty );
+        if ( occluded )
+            return;
+    }
+
+    // Edge a->b is positive for points to its left, the inside of a counter clockwise triangle
+    Edge edges[3];
+    for ( int i = 0; i < 3; ++i )
+    {
+        const int a = i, b = ( i + 1 ) % 3;
+        const int64_t dx = x[b] - x[a], dy = y[b] - y[a];
+        edges[i].stepX = -dy * subpixelScale;
+        edges[i].stepY = dx * subpixelScale;
+        edges[i].origin = dx * ( half - y[a] ) - dy * ( half - x[a] );
+
+        // Centers exactly on an edge belong to it only if it is a left edge (going down) or a
+        // top edge (flat, going left), otherwise bias by one so a zero value is outside
+        const bool topLeft = dy < 0 || ( dy == 0 && dx < 0 );
+        if ( !topLeft )
+            edges[i].origin -= 1;
+    }
+
+    // Shaded triangles walk rows instead of blocks, refreshing every block and tile they may have written
+    if ( shade )
+    {
+        ShadeRows( frame, depth, edges, minX, minY, maxX, maxY, plane, *shade );
+        if ( depth )
+        {
+            for ( int by = minY / blockSize; by <= ( maxY - 1 ) / blockSize; ++by )
+                for ( int bx = minX / blockSize; bx <= ( maxX - 1 ) / blockSize; ++bx )
+                    depth->UpdateBlock( bx, by );
+            for ( int ty = tileBottom; ty <= tileTop; ++ty )
+                for ( int tx = tileLeft; tx <= tileRight; ++tx )
+                    depth->UpdateTile( tx, ty );
+        }
+        return;
+    }
+
+    // Block extents of each edge, used to classify a block from its first pixel
+    constexpr int last = blockSize - 1;
+    int64_t lowest[3], highest[3];
+    for ( int i = 0; i < 3; ++i )
+    {
+        lowest[i] = std::min<int64_t>( edges[i].stepX * last, 0 ) + std::min<int64_t>( edges[i].stepY * last, 0 );
+        highest[i] = std::max<int64_t>( edges[i].stepX * last, 0 ) + std::max<int64_t>( edges[i].stepY * last, 0 );
+    }
+
+    const Simd::Level level = Simd::GetLevel();
+    const int pitch = frame.GetPitch();
+
+    // Walk the blocks of the bounding box, aligned so they never straddle a cache line
+    for ( int by = minY & ~last; by < maxY; by += blockSize )
+    {
+        // Neighbouring fully covered blocks are blended together as longer spans
+        uint32_t* fullRow = nullptr;
+        int fullWidth = 0;
+        auto blendFull = [&]()
+        {
+            for ( int y = 0; y < blockSize && fullWidth != 0; ++y )
+                Blend::Span( fullRow + static_cast<ptrdiff_t>( y ) * pitch, static_cast<size_t>( fullWidth ), paint );
+            fullWidth = 0;
+        };
+
+        for ( int bx = minX & ~last; bx < maxX; bx += blockSize )
+        {
+            Block block;
+            block.row = frame.GetRow( std::max( by, minY ) ) + bx;
+            block.pitch = pitch;
+            block.left = std::max( minX - bx, 0 );
+            block.right = std::min( maxX - bx, blockSize );
+            block.rows = std::min( maxY, by + blockSize ) - std::max( by, minY );
+
+            // Classify the block against every edge
+            bool rejected = false;
+            int straddling = 0;
+            for ( int i = 0; i < 3 && !rejected; ++i )
+            {
+                const int64_t value = edges[i].origin + edges[i].stepX * bx + edges[i].stepY * by;
+                if ( value + highest[i] < 0 )
+                    rejected = true;
+                else if ( value + lowest[i] < 0 )
+                {
+                    // Only straddling edges are tested per pixel, their values are small enough for 32 bits
+                    const int64_t first = value + edges[i].stepY * ( std::max( by, minY ) - by );
+                    block.value[straddling] = static_cast<int32_t>( first );
+                    block.stepX[straddling] = static_cast<int32_t>( edges[i].stepX );
+                    block.stepY[straddling] = static_cast<int32_t>( edges[i].stepY );
+                    ++straddling;
+                }
+            }
+            if ( rejected )
+                continue;
+
+            // Unused edge slots always pass
+            for ( int i = straddling; i < 3; ++i )
+                block.value[i] = block.stepX[i] = block.stepY[i] = 0;
+
+            // Blocks entirely behind their farthest stored depth are skipped whole, blocks entirely in
+            // front of their nearest skip the comparison, the rest compare every covered pixel
+            if ( depth )
+            {
+                const int blockX = bx / blockSize, blockY = by / blockSize, firstRow = std::max( by, minY );
+                float nearest, farthest;
+                DepthRange( plane, bx + block.left, firstRow, bx + block.right - 1, firstRow + block.rows - 1, nearest, farthest );
+                if ( nearest >= depth->GetBlockMax( blockX, blockY ) )
+                    continue;
+
+                const DepthRows rows = { 
+                    depth->GetRow( firstRow ) + bx, depth->GetPitch(), bx, firstRow, plane, 
+                    !( farthest < depth->GetBlockMin( blockX, blockY ) ) };
+#ifdef GFX_X86
+                if ( level == Simd::Level::AVX2 )
+                    FillDepthAvx2( block, rows, paint );
+                else if ( level == Simd::Level::SSE2 )
+                    FillDepthSse2( block, rows, paint );
+                else
+#endif
+                    FillDepthScalar( block, rows, paint );
+
+                depth->UpdateBlock( blockX, blockY );
+                continue;
+            }
+
+            // Fully covered blocks that are not clipped skip all testing
+            const bool clipped = block.left != 0 || block.right != blockSize || block.rows != blockSize;
+            if ( straddling == 0 && !clipped )
+            {
+                if ( paint.replace )
+                    FillFull( block.row, pitch, paint );
+                else
+                {
+                    if ( fullWidth != 0 && fullRow + fullWidth != block.row )
+                        blendFull();
+                    if ( fullWidth == 0 )
+                        fullRow = block.row;
+                    fullWidth += blockSize;
+                }
+                continue;
+            }
+
+#ifdef GFX_X86
+            if ( level == Simd::Level::AVX2 )
+                FillPartialAvx2( block, paint );
+            else if ( level == Simd::Level::SSE2 )
+                FillPartialSse2( block, paint );
+            else
+#endif
+                FillPartialScalar( block, paint );
+        }
+        blendFull();
+    }
+
+    // Blocks were refreshed as they were drawn, the tiles above them only need it once
+    if ( depth )
+        for ( int ty = tileBottom; ty <= tileTop; ++ty )
+            for ( int tx = tileLeft; tx <= tileRight; ++tx )
+                depth->UpdateTile( tx, ty );
+}
@@ -0,0 +1,59 @@
+#include "Graphics/HeadlessPresenter.h"
+#include <cstring>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] HeadlessPresenter                                                    */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Constructs a headless presenter
+HeadlessPresenter::HeadlessPresenter( bool keepFrames ) noexcept : keepFrames( keepFrames ) {}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Copies the frame into memory if enabled and counts it
+void HeadlessPresenter::Present( const Framebuffer& frame )
+{
+    if ( keepFrames )
+        lastFrame.CopyFrom( frame );
+
+    ++frameCount;
+    pixelCount += static_cast<uint64_t>( frame.GetWidth() ) * frame.GetHeight();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Copies only the changed regions into memory if enabled
+//          and counts the frame
+void HeadlessPresenter::PresentRegion(
+    const Framebuffer&       frame,
+    const std::vector<Rect>& rects )
+{
+    // The stored frame has to be complete before it can be patched
+    if ( keepFrames && ( lastFrame.GetWidth() != frame.GetWidth() || lastFrame.GetHeight() != frame.GetHeight() ) )
+        return Present( frame );
+
+    for ( const Rect& rect : rects )
+    {
+        if ( keepFrames )
+            for ( int y = rect.bottom; y < rect.top; ++y )
+                std::memcpy( 
+                    lastFrame.GetRow( y ) + rect.left, 
+                    frame.GetRow( y ) + rect.left, 
+                    static_cast<size_t>( rect.right - rect.left ) * sizeof( uint32_t ) );
+
+        pixelCount += static_cast<uint64_t>( rect.right - rect.left ) * ( rect.top - rect.bottom );
+    }
+
+    ++frameCount;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the most recently presented frame
+const Framebuffer& HeadlessPresenter::GetLastFrame() const noexcept { return lastFrame; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of frames presented so far
+uint64_t HeadlessPresenter::GetFrameCount() const noexcept { return frameCount; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of pixels presented so far
+uint64_t HeadlessPresenter::GetPixelCount() const noexcept { return pixelCount; }
@@ -0,0 +1,510 @@
+#include "Graphics/Image.h"
+#include "Graphics/Qoi.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+// BMP compression values, bit fields give the position of each channel
+static constexpr uint32_t bmpRgb = 0u;
+static constexpr uint32_t bmpBitFields = 3u;
+static constexpr uint32_t bmpAlphaBitFields = 6u;
+static constexpr size_t bmpFileHeaderSize = 14u;
+static constexpr size_t bmpInfoHeaderSize = 40u;
+static constexpr size_t bmpV5HeaderSize = 124u;
+
+// Largest image loaded, keeps a corrupt header from asking for gigabytes
+static constexpr size_t maxPixels = Qoi::maxPixels;
+
+//////////////////////////////////////////////////////////////////
+// Reads a little endian 16 bit number
+static inline uint32_t ReadLittle16( const uint8_t* bytes ) noexcept
+{
+    return static_cast<uint32_t>( bytes[0] ) | ( static_cast<uint32_t>( bytes[1] ) << 8 );
+}
+
+//////////////////////////////////////////////////////////////////
+// Reads a little endian 32 bit number
+static inline uint32_t ReadLittle32( const uint8_t* bytes ) noexcept
+{
+    return ReadLittle16( bytes ) | ( ReadLittle16( bytes + 2 ) << 16 );
+}
+
+//////////////////////////////////////////////////////////////////
+// Writes a little endian 32 bit number
+static inline uint8_t* WriteLittle32(
+    uint8_t* bytes,
+    uint32_t value ) noexcept
+{
+    bytes[0] = static_cast<uint8_t>( value );
+    bytes[1] = static_cast<uint8_t>( value >> 8 );
+    bytes[2] = static_cast<uint8_t>( value >> 16 );
+    bytes[3] = static_cast<uint8_t>( value >> 24 );
+    return bytes + 4;
+}
+
+//////////////////////////////////////////////////////////////////
+// Encodes an image as a top down BMP, either 32 bit with a version 5
+//      header and its pixels 4 byte aligned, or 24 bit with the plain
+//      info header and each row padded to 4 bytes
+static void EncodeBmp(
+    const ImageView&      image,
+    bool                  alpha,
+    std::vector<uint8_t>& out )
+{
+    const size_t headerSize = alpha ? bmpV5HeaderSize : bmpInfoHeaderSize;
+    const size_t offset = ( bmpFileHeaderSize + headerSize + 3u ) & ~size_t( 3u );
+    const size_t pixelBytes = alpha ? 4u : 3u;
+    const size_t rowBytes = ( static_cast<size_t>( image.width ) * pixelBytes + 3u ) & ~size_t( 3u );
+    out.assign( offset + rowBytes * image.height, 0u );
+
+    uint8_t* bytes = out.data();
+    bytes[0] = 'B';
+    bytes[1] = 'M';
+    WriteLittle32( bytes + 2, static_cast<uint32_t>( out.size() ) );
+    WriteLittle32( bytes + 10, static_cast<uint32_t>( offset ) );
+
+    // Negative height stores rows top down
+    bytes = WriteLittle32( bytes + bmpFileHeaderSize, static_cast<uint32_t>( headerSize ) );
+    bytes = WriteLittle32( bytes, static_cast<uint32_t>( image.width ) );
+    bytes = WriteLittle32( bytes, static_cast<uint32_t>( -image.height ) );
+    bytes = WriteLittle32( bytes, 1u | ( static_cast<uint32_t>( pixelBytes * 8u ) << 16 ) );
+    bytes = WriteLittle32( bytes, alpha ? bmpBitFields : bmpRgb );
+    bytes = WriteLittle32( bytes, static_cast<uint32_t>( rowBytes * image.height ) );
+    if ( alpha )
+    {
+        // The masks say each pixel is BGRA and the colors are sRGB
+        bytes = WriteLittle32( bytes + 16, 0x00FF0000u );
+        bytes = WriteLittle32( bytes, 0x0000FF00u );
+        bytes = WriteLittle32( bytes, 0x000000FFu );
+        bytes = WriteLittle32( bytes, 0xFF000000u );
+        bytes = WriteLittle32( bytes, 0x73524742u );
+        WriteLittle32( bytes + 48, 4u );
+    }
+
+    for ( int y = 0; y < image.height; ++y )
+    {
+        uint8_t* row = out.data() + offset + rowBytes * y;
+        for ( int x = 0; x < image.width; ++x )
+        {
+            const uint32_t color = image.GetRow( y )[x];
+            if ( alpha )
+                row = WriteLittle32( row, color );
+            else
+            {
+                *row++ = static_cast<uint8_t>( color );
+                *row++ = static_cast<uint8_t>( color >> 8 );
+                *row++ = static_cast<uint8_t>( color >> 16 );
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Encodes an image as a binary PPM, alpha is dropped
+static void EncodePpm(
+    const ImageView&      image,
+    std::vector<uint8_t>& out )
+{
+    const std::string header = "P6\n" + std::to_string( image.width ) + " " + std::to_string( image.height ) + "\n255\n";
+    out.assign( header.begin(), header.end() );
+    out.reserve( out.size() + static_cast<size_t>( image.width ) * image.height * 3u );
+    for ( int y = 0; y < image.height; ++y )
+    {
+        for ( int x = 0; x < image.width; ++x )
+        {
+            const uint32_t color = image.GetRow( y )[x];
+            out.push_back( static_cast<uint8_t>( color >> 16 ) );
+            out.push_back( static_cast<uint8_t>( color >> 8 ) );
+            out.push_back( static_cast<uint8_t>( color ) );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Reads a whole number from a PPM header, skipping whitespace and
+//      comments before it, -1 if there isn't one
+static int ReadPpmNumber(
+    const uint8_t* data,
+    size_t         size,
+    size_t&        i ) noexcept
+{
+    while ( i < size )
+    {
+        if ( data[i] == '#' )
+        {
+            while ( i < size && data[i] != '\n' && data[i] != '\r' )
+                ++i;
+        }
+        else if ( data[i] == ' ' || data[i] == '\t' || data[i] == '\n' || data[i] == '\r' || data[i] == '\v' || data[i] == '\f' )
+        {
+            ++i;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    int value = -1;
+    for ( ; i < size && data[i] >= '0' && data[i] <= '9'; ++i )
+    {
+        value = std::max( value, 0 ) * 10 + ( data[i] - '0' );
+        if ( value > 0xFFFFFF )
+            return -1;
+    }
+    return value;
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Image::Exception                                                     */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Constructs a custom Image::Exception
+Image::Exception::Exception(
+    int                line,
+    const char*        file,
+    const std::string& path,
+    const std::string& reason )
+    :
+    GraphicsException( line, file ),
+    path( path ),
+    reason( reason )
+{}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Human readable error string recovered from exception
+const char* Image::Exception::what() const noexcept
+{
+    // Format the error string and store in buffer
+    std::ostringstream oss;
+    oss << GetType() << std::endl
+        << "[Image] " << GetPath() << std::endl
+        << "[Description] " << GetReason() << std::endl
+        << GetOriginString();
+    whatBuffer = oss.str();
+
+    // Return pointer to persistent buffer string
+    return whatBuffer.c_str();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns Image Error type of exception
+const char* Image::Exception::GetType() const noexcept { return "Image Exception"; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the image that failed to load
+const std::string& Image::Exception::GetPath() const noexcept { return path; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns what is wrong with the image
+const std::string& Image::Exception::GetReason() const noexcept { return reason; }
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Image                                                                */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Takes the pixels of another image
+Image::Image( Image&& other ) noexcept
+    :
+    file( std::move( other.file ) ),
+    pixels( std::move( other.pixels ) ),
+    view( std::exchange( other.view, ImageView() ) )
+{}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Takes the pixels of another image
+Image& Image::operator=( Image&& other ) noexcept
+{
+    file = std::move( other.file );
+    pixels = std::move( other.pixels );
+    view = std::exchange( other.view, ImageView() );
+    return *this;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Loads an image
+Image Image::Load( const std::filesystem::path& path )
+{
+    const std::u8string name = path.u8string();
+    const std::string pathString( name.begin(), name.end() );
+
+    auto mapping = std::make_unique<MappedFile>( path );
+    if ( !mapping->IsOpen() )
+        throw IMG_EXCEPT( pathString, "The file could not be opened or is empty" );
+
+    Image image;
+    if ( const char* reason = image.Read( mapping->GetData(), mapping->GetSize(), true ) )
+        throw IMG_EXCEPT( pathString, reason );
+
+    // Converted pixels no longer need the file, those left in place keep it mapped
+    if ( image.pixels.empty() )
+        image.file = std::move( mapping );
+    return image;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Decodes an image already in memory
+Image Image::Decode(
+    const uint8_t* data,
+    size_t         size )
+{
+    Image image;
+    if ( const char* reason = image.Read( data, size, false ) )
+        throw IMG_EXCEPT( "<memory>", reason );
+    return image;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Writes an image to a file in the format of its extension
+void Image::Save(
+    const ImageView&             image,
+    const std::filesystem::path& path,
+    bool                         alpha )
+{
+    const std::u8string name = path.u8string();
+    const std::string pathString( name.begin(), name.end() );
+    if ( image.IsEmpty() )
+        throw IMG_EXCEPT( pathString, "The image has no pixels" );
+
+    std::string extension = path.extension().string();
+    std::transform( extension.begin(), extension.end(), extension.begin(), []( char c ) { return static_cast<char>( std::tolower( static_cast<unsigned char>( c ) ) ); } );
+    std::vector<uint8_t> encoded;
+    if ( extension == ".bmp" )
+        EncodeBmp( image, alpha, encoded );
+    else if ( extension == ".ppm" )
+        EncodePpm( image, encoded );
+    else if ( extension == ".qoi" )
+        Qoi::Encode( image, alpha, encoded );
+    else
+        throw IMG_EXCEPT( pathString, "Only .bmp, .ppm and .qoi files can be written" );
+
+    std::ofstream file( path, std::ios::binary | std::ios::trunc );
+    if ( !file.write( reinterpret_cast<const char*>( encoded.data() ), static_cast<std::streamsize>( encoded.size() ) ) )
+        throw IMG_EXCEPT( pathString, "The file could not be written" );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the pixels
+const ImageView& Image::GetView() const noexcept { return view; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of the image in pixels
+int Image::GetWidth() const noexcept { return view.width; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the height of the image in pixels
+int Image::GetHeight() const noexcept { return view.height; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if the pixels are read in place
+bool Image::IsMapped() const noexcept { return file != nullptr; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] Image                                                               */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Reads an image in any supported format
+const char* Image::Read(
+    const uint8_t* data,
+    size_t         size,
+    bool           inPlace )
+{
+    if ( !data || size < 4u )
+        return "The file is too short to be an image";
+    if ( data[0] == 'B' && data[1] == 'M' )
+        return ReadBmp( data, size, inPlace );
+    if ( data[0] == 'P' && ( data[1] == '5' || data[1] == '6' ) )
+        return ReadPpm( data, size );
+    if ( data[0] == 'q' && data[1] == 'o' && data[2] == 'i' && data[3] == 'f' )
+        return ReadQoi( data, size );
+    return "The file is not a BMP, PPM or QOI image";
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Reads an uncompressed 24 or 32 bit BMP
+const char* Image::ReadBmp(
+    const uint8_t* data,
+    size_t         size,
+    bool           inPlace )
+{
+    if ( size < bmpFileHeaderSize + bmpInfoHeaderSize )
+        return "The BMP header is truncated";
+
+    const uint32_t offset = ReadLittle32( data + 10 );
+    const uint32_t infoSize = ReadLittle32( data + 14 );
+    const int32_t width = static_cast<int32_t>( ReadLittle32( data + 18 ) );
+    const int32_t signedHeight = static_cast<int32_t>( ReadLittle32( data + 22 ) );
+    const uint32_t bitCount = ReadLittle16( data + 28 );
+    const uint32_t compression = ReadLittle32( data + 30 );
+    if ( infoSize < bmpInfoHeaderSize )
+        return "BMP files older than Windows 3 are not supported";
+    if ( width <= 0 || signedHeight == 0 || signedHeight == INT32_MIN )
+        return "The BMP has no pixels";
+
+    // Rows are stored bottom up unless the height is negative
+    const bool topDown = signedHeight < 0;
+    const int32_t height = topDown ? -signedHeight : signedHeight;
+    if ( static_cast<size_t>( width ) > maxPixels / static_cast<size_t>( height ) )
+        return "The BMP is too large";
+
+    // Masks follow the 40 byte header either inside a larger header or straight after it
+    uint32_t red = 0x00FF0000u, green = 0x0000FF00u, blue = 0x000000FFu, alpha = 0u;
+    if ( compression == bmpBitFields || compression == bmpAlphaBitFields )
+    {
+        const bool hasAlpha = infoSize >= 56u || compression == bmpAlphaBitFields;
+        const size_t maskEnd = bmpFileHeaderSize + bmpInfoHeaderSize + ( hasAlpha ? 16u : 12u );
+        if ( size < maskEnd )
+            return "The BMP header is truncated";
+        red = ReadLittle32( data + 54 );
+        green = ReadLittle32( data + 58 );
+        blue = ReadLittle32( data + 62 );
+        alpha = hasAlpha ? ReadLittle32( data + 66 ) : 0u;
+    }
+    else if ( compression != bmpRgb )
+    {
+        return "Compressed BMPs are not supported";
+    }
+
+    if ( bitCount != 32u && !( bitCount == 24u && compression == bmpRgb ) )
+        return "Only 24 and 32 bit BMPs are supported";
+    if ( red != 0x00FF0000u || green != 0x0000FF00u || blue != 0x000000FFu || ( alpha != 0u && alpha != 0xFF000000u ) )
+        return "Only BMPs with 8 bits a channel in BGRA order are supported";
+
+    const size_t stride = ( static_cast<size_t>( width ) * ( bitCount / 8u ) + 3u ) & ~size_t( 3u );
+    if ( offset > size || ( size - offset ) / stride < static_cast<size_t>( height ) )
+        return "The BMP pixels are truncated";
+
+    // Row y of the image, counted from the top
+    const uint8_t* const first = data + offset;
+    const auto row = [&]( int y ) { return first + stride * static_cast<size_t>( topDown ? y : height - 1 - y ); };
+
+    if ( bitCount == 32u )
+    {
+        // Without an alpha mask the fourth byte means nothing and every pixel is opaque, which
+        // only needs a copy where it isn't already stored as full alpha
+        bool opaque = alpha != 0u;
+        if ( !opaque )
+        {
+            uint8_t lowest = 0xFFu;
+            for ( int y = 0; y < height && lowest == 0xFFu; ++y )
+            {
+                const uint8_t* bytes = row( y );
+                for ( int x = 0; x < width; ++x )
+                    lowest &= bytes[x * 4 + 3];
+            }
+            opaque = lowest == 0xFFu;
+        }
+
+        if ( inPlace && opaque && offset % alignof( uint32_t ) == 0u )
+        {
+            const ptrdiff_t pitch = topDown ? width : -static_cast<ptrdiff_t>( width );
+            view = ImageView( reinterpret_cast<const uint32_t*>( row( 0 ) ), width, height, pitch );
+            return nullptr;
+        }
+
+        const uint32_t forced = opaque || alpha != 0u ? 0u : 0xFF000000u;
+        pixels.resize( static_cast<size_t>( width ) * height );
+        for ( int y = 0; y < height; ++y )
+        {
+            const uint8_t* bytes = row( y );
+            uint32_t* out = pixels.data() + static_cast<size_t>( y ) * width;
+            for ( int x = 0; x < width; ++x )
+                out[x] = ReadLittle32( bytes + x * 4 ) | forced;
+        }
+    }
+    else
+    {
+        pixels.resize( static_cast<size_t>( width ) * height );
+        for ( int y = 0; y < height; ++y )
+        {
+            const uint8_t* bytes = row( y );
+            uint32_t* out = pixels.data() + static_cast<size_t>( y ) * width;
+            for ( int x = 0; x < width; ++x, bytes += 3 )
+                out[x] = 0xFF000000u | ( static_cast<uint32_t>( bytes[2] ) << 16 ) | ( static_cast<uint32_t>( bytes[1] ) << 8 ) | bytes[0];
+        }
+    }
+
+    view = ImageView( pixels.data(), width, height, width );
+    return nullptr;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Reads a binary PPM or PGM
+const char* Image::ReadPpm(
+    const uint8_t* data,
+    size_t         size )
+{
+    // The header is the magic, width, height and largest sample, then one whitespace byte
+    const bool gray = data[1] == '5';
+    size_t i = 2u;
+    const int width = ReadPpmNumber( data, size, i );
+    const int height = ReadPpmNumber( data, size, i );
+    const int maxValue = ReadPpmNumber( data, size, i );
+    if ( width <= 0 || height <= 0 || maxValue <= 0 || maxValue > 0xFFFF || i >= size )
+        return "The PPM header is malformed";
+    if ( static_cast<size_t>( width ) > maxPixels / static_cast<size_t>( height ) )
+        return "The PPM is too large";
+    ++i;
+
+    // Samples above 255 take two bytes, most significant first
+    const size_t count = static_cast<size_t>( width ) * height;
+    const size_t sampleSize = maxValue > 255 ? 2u : 1u;
+    const size_t channels = gray ? 1u : 3u;
+    if ( ( size - i ) / ( sampleSize * channels ) < count )
+        return "The PPM pixels are truncated";
+
+    pixels.resize( count );
+    const uint8_t* bytes = data + i;
+    if ( maxValue == 255 && !gray )
+    {
+        for ( size_t p = 0u; p < count; ++p, bytes += 3 )
+            pixels[p] = 0xFF000000u | ( static_cast<uint32_t>( bytes[0] ) << 16 ) | ( static_cast<uint32_t>( bytes[1] ) << 8 ) | bytes[2];
+    }
+    else
+    {
+        // Other ranges are rescaled to 0 to 255 with rounding
+        const uint32_t max = static_cast<uint32_t>( maxValue );
+        const auto sample = [&]() {
+            uint32_t value = *bytes++;
+            if ( sampleSize == 2u )
+                value = ( value << 8 ) | *bytes++;
+            return ( std::min( value, max ) * 255u + max / 2u ) / max;
+        };
+        for ( size_t p = 0u; p < count; ++p )
+        {
+            const uint32_t r = sample();
+            const uint32_t g = gray ? r : sample();
+            const uint32_t b = gray ? r : sample();
+            pixels[p] = 0xFF000000u | ( r << 16 ) | ( g << 8 ) | b;
+        }
+    }
+
+    view = ImageView( pixels.data(), width, height, width );
+    return nullptr;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Reads a QOI image
+const char* Image::ReadQoi(
+    const uint8_t* data,
+    size_t         size )
+{
+    int width, height;
+    if ( !Qoi::ReadHeader( data, size, width, height ) )
+        return "The QOI header is malformed";
+
+    pixels.resize( static_cast<size_t>( width ) * height );
+    if ( !Qoi::Decode( data, size, pixels.data(), pixels.size() ) )
+    {
+        pixels.clear();
+        return "The QOI pixels are truncated";
+    }
+
+    view = ImageView( pixels.data(), width, height, width );
+    return nullptr;
+}
@@ -0,0 +1,270 @@
+#include "Graphics/Path.h"
+#include "Graphics/HalfSpace.h"
+#include <algorithm>
+#include <cmath>
+
+//////////////////////////////////////////////////////////////////
+// A point in pixels while it is flattened
+struct PathPoint
+{
+    double x;
+    double y;
+};
+
+// Curves are split at most this many times, 65536 lines is far past any tolerance worth asking for
+static constexpr int maxDepth = 16;
+
+//////////////////////////////////////////////////////////////////
+// Returns the point halfway between two others
+static inline PathPoint Midpoint(
+    const PathPoint& a,
+    const PathPoint& b ) noexcept
+{
+    return { ( a.x + b.x ) * 0.5, ( a.y + b.y ) * 0.5 };
+}
+
+//////////////////////////////////////////////////////////////////
+// Moves a point of the path into pixels
+static inline PathPoint Transform(
+    const Affine2<float>& transform,
+    const Vec2<float>&    point ) noexcept
+{
+    return {
+        double( transform.xx ) * point.x + double( transform.xy ) * point.y + transform.tx,
+        double( transform.yx ) * point.x + double( transform.yy ) * point.y + transform.ty };
+}
+
+//////////////////////////////////////////////////////////////////
+// Appends a point in 28.4 fixed point to the current contour unless
+//      it rounds to the point before it
+static void Emit(
+    Path::Flattened& out,
+    const PathPoint& point ) noexcept
+{
+    auto fixed = []( double value )
+    {
+        const double clamped = std::clamp( value * HalfSpace::subpixelScale, double( -Polygon::maxCoordinate ), double( Polygon::maxCoordinate ) );
+        return static_cast<int>( std::lround( clamped ) );
+    };
+
+    const Vec2<int> converted( fixed( point.x ), fixed( point.y ) );
+    if ( out.contourSizes.back() > 0 && out.points.back() == converted )
+        return;
+    out.points.push_back( converted );
+    ++out.contourSizes.back();
+}
+
+//////////////////////////////////////////////////////////////////
+// Flattens a quadratic, a piece is flat enough when the control
+//      point's pull, a quarter of p0 - 2c + p1, is within tolerance
+static void FlattenQuad(
+    Path::Flattened& out,
+    const PathPoint& p0,
+    const PathPoint& c,
+    const PathPoint& p1,
+    double           limit,
+    int              depth )
+{
+    const double dx = p0.x - 2.0 * c.x + p1.x, dy = p0.y - 2.0 * c.y + p1.y;
+    if ( depth >= maxDepth || dx * dx + dy * dy <= limit )
+        return Emit( out, p1 );
+
+    // Split in half with de Casteljau's
+    const PathPoint a = Midpoint( p0, c ), b = Midpoint( c, p1 ), middle = Midpoint( a, b );
+    FlattenQuad( out, p0, a, middle, limit, depth + 1 );
+    FlattenQuad( out, middle, b, p1, limit, depth + 1 );
+}
+
+//////////////////////////////////////////////////////////////////
+// Flattens a cubic, a piece is flat enough when the bound on its
+//      distance from the chord through its ends is within tolerance
+static void FlattenCubic(
+    Path::Flattened& out,
+    const PathPoint& p0,
+    const PathPoint& c0,
+    const PathPoint& c1,
+    const PathPoint& p1,
+    double           limit,
+    int              depth )
+{
+    auto square = []( double value ) { return value * value; };
+    const double ux = std::max( square( 3.0 * c0.x - 2.0 * p0.x - p1.x ), square( 3.0 * c1.x - p0.x - 2.0 * p1.x ) );
+    const double uy = std::max( square( 3.0 * c0.y - 2.0 * p0.y - p1.y ), square( 3.0 * c1.y - p0.y - 2.0 * p1.y ) );
+    if ( depth >= maxDepth || ux + uy <= limit )
+        return Emit( out, p1 );
+
+    const PathPoint a = Midpoint( p0, c0 ), b = Midpoint( c0, c1 ), c = Midpoint( c1, p1 );
+    const PathPoint ab = Midpoint( a, b ), bc = Midpoint( b, c ), middle = Midpoint( ab, bc );
+    FlattenCubic( out, p0, a, ab, middle, limit, depth + 1 );
+    FlattenCubic( out, middle, bc, c, p1, limit, depth + 1 );
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Path                                                                 */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Starts a new contour
+void Path::MoveTo( const Vec2<float>& point ) { Add( Verb::MOVE, &point, 1u ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Adds a straight line from the current point
+void Path::LineTo( const Vec2<float>& point ) { Add( Verb::LINE, &point, 1u ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Adds a quadratic Bezier curve from the current point
+void Path::QuadTo(
+    const Vec2<float>& control,
+    const Vec2<float>& point )
+{
+    const Vec2<float> added[2] = { control, point };
+    Add( Verb::QUAD, added, 2u );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Adds a cubic Bezier curve from the current point
+void Path::CubicTo(
+    const Vec2<float>& control1,
+    const Vec2<float>& control2,
+    const Vec2<float>& point )
+{
+    const Vec2<float> added[3] = { control1, control2, point };
+    Add( Verb::CUBIC, added, 3u );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Closes the current contour
+void Path::Close() { Add( Verb::CLOSE, nullptr, 0u ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Removes every contour
+void Path::Clear() noexcept
+{
+    verbs.clear();
+    points.clear();
+    ++version;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the path flattened to lines
+const Path::Flattened& Path::Flatten(
+    const Affine2<float>& transform,
+    float                 tolerance ) const
+{
+    if ( flattenedVersion == version && flattenedTransform == transform && flattenedTolerance == tolerance )
+        return flattened;
+
+    flattenedVersion = version;
+    flattenedTransform = transform;
+    flattenedTolerance = tolerance;
+    flattened.points.clear();
+    flattened.contourSizes.clear();
+    flattened.closed.clear();
+
+    // Both flatness tests compare against sixteen times the squared tolerance
+    const double pixels = std::max( double( tolerance ), 1.0 / HalfSpace::subpixelScale );
+    const double limit = 16.0 * pixels * pixels;
+
+    // A line or curve straight after a close starts a new contour where the closed one started
+    PathPoint current = { transform.tx, transform.ty }, start = current;
+    bool open = false;
+    auto begin = [&]( const PathPoint& point )
+    {
+        flattened.contourSizes.push_back( 0u );
+        flattened.closed.push_back( false );
+        Emit( flattened, point );
+        start = point;
+        open = true;
+    };
+
+    const Vec2<float>* next = points.data();
+    for ( Verb verb : verbs )
+    {
+        if ( verb != Verb::MOVE && verb != Verb::CLOSE && !open )
+            begin( current );
+
+        switch ( verb )
+        {
+        case Verb::MOVE:
+            current = Transform( transform, next[0] );
+            begin( current );
+            ++next;
+            break;
+        case Verb::LINE:
+            current = Transform( transform, next[0] );
+            Emit( flattened, current );
+            ++next;
+            break;
+        case Verb::QUAD:
+        {
+            const PathPoint end = Transform( transform, next[1] );
+            FlattenQuad( flattened, current, Transform( transform, next[0] ), end, limit, 0 );
+            current = end;
+            next += 2;
+            break;
+        }
+        case Verb::CUBIC:
+        {
+            const PathPoint end = Transform( transform, next[2] );
+            FlattenCubic( flattened, current, Transform( transform, next[0] ), Transform( transform, next[1] ), end, limit, 0 );
+            current = end;
+            next += 3;
+            break;
+        }
+        case Verb::CLOSE:
+            if ( open )
+                flattened.closed.back() = true;
+            current = start;
+            open = false;
+            break;
+        }
+    }
+    return flattened;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the flattened path prepared for filling
+std::shared_ptr<const Polygon> Path::GetPolygon(
+    const Affine2<float>& transform,
+    float                 tolerance,
+    FillRule              rule ) const
+{
+    if ( polygon && polygonVersion == version && polygonTransform == transform && polygonTolerance == tolerance && polygonRule == rule )
+        return polygon;
+
+    const Flattened& lines = Flatten( transform, tolerance );
+    polygon = std::make_shared<const Polygon>( lines.points.data(), lines.contourSizes.data(), lines.contourSizes.size(), rule );
+    polygonVersion = version;
+    polygonTransform = transform;
+    polygonTolerance = tolerance;
+    polygonRule = rule;
+    return polygon;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if the path has nothing to draw
+bool Path::IsEmpty() const noexcept
+{
+    return std::all_of( verbs.begin(), verbs.end(), []( Verb verb ) { return verb == Verb::MOVE || verb == Verb::CLOSE; } );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a counter that changes whenever the path is
+//          edited
+uint64_t Path::GetVersion() const noexcept { return version; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] Path                                                                */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Records a verb and its points
+void Path::Add(
+    Verb               verb,
+    const Vec2<float>* added,
+    size_t             count )
+{
+    verbs.push_back( verb );
+    points.insert( points.end(), added, added + count );
+    ++version;
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "Graphics/Polygon.h"
+#include "Graphics/HalfSpace.h"
+#include "Graphics/Rasterizer.h"
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////
+// Divides rounding towards negative infinity
+static inline int64_t FloorDiv(
+    int64_t numerator,
+    int64_t denominator ) noexcept
+{
+    const int64_t quotient = numerator / denominator;
+    return quotient - ( ( numerator % denominator != 0 ) && ( ( numerator < 0 ) != ( denominator < 0 ) ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// Divides rounding towards positive infinity
+static inline int64_t CeilDiv(
+    int64_t numerator,
+    int64_t denominator ) noexcept
+{
+    return -FloorDiv( -numerator, denominator );
+}
+
+//////////////////////////////////////////////////////////////////
+// Returns the first pixel or row whose center is at or past a 28.4
+//      position
+static inline int FirstCenter( int64_t position ) noexcept
+{
+    constexpr int half = HalfSpace::subpixelScale / 2;
+    return static_cast<int>( CeilDiv( position - half, HalfSpace::subpixelScale ) );
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Polygon                                                              */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Builds the edge table
+Polygon::Polygon(
+    const Vec2<int>* points,
+    const size_t*    contourSizes,
+    size_t           contourCount,
+    FillRule         rule )
+    :
+    rule( rule )
+{
+    constexpr int half = HalfSpace::subpixelScale / 2;
+    int64_t loX = INT64_MAX, hiX = INT64_MIN;
+    const Vec2<int>* contour = points;
+    for ( size_t c = 0; c < contourCount; ++c )
+    {
+        const size_t count = contourSizes[c];
+        for ( size_t i = 0; i < count; ++i )
+        {
+            const Vec2<int>& from = contour[i];
+            const Vec2<int>& to = contour[i + 1 < count ? i + 1 : 0];
+            int64_t x0 = std::clamp( from.x, -maxCoordinate, maxCoordinate ), y0 = std::clamp( from.y, -maxCoordinate, maxCoordinate );
+            int64_t x1 = std::clamp( to.x, -maxCoordinate, maxCoordinate ), y1 = std::clamp( to.y, -maxCoordinate, maxCoordinate );
+            loX = std::min( loX, x0 );
+            hiX = std::max( hiX, x0 );
+
+            // Every edge points up the surface so the same test finds the rows it crosses, the winding remembers which way it went
+            Edge edge;
+            edge.winding = 1;
+            if ( y0 > y1 )
+            {
+                std::swap( x0, x1 );
+                std::swap( y0, y1 );
+                edge.winding = -1;
+            }
+
+            // Rows whose centers are in [y0, y1), horizontal edges and edges between two centers cross none
+            edge.firstRow = FirstCenter( y0 );
+            edge.endRow = FirstCenter( y1 );
+            if ( edge.firstRow >= edge.endRow )
+                continue;
+
+            // The crossing of row r is x0 + ( 16r + 8 - y0 ) * dx / dy, the first center right of it is one
+            // more division by the size of a pixel
+            const int64_t dx = x1 - x0, dy = y1 - y0;
+            edge.numerator = ( x0 - half ) * dy + ( half - y0 ) * dx;
+            edge.denominator = dy * HalfSpace::subpixelScale;
+            edge.step = dx * HalfSpace::subpixelScale;
+            edges.push_back( edge );
+        }
+        contour += count;
+    }
+
+    // Rows are stepped bottom to top and edges join as the rows reach them
+    std::stable_sort( edges.begin(), edges.end(), []( const Edge& a, const Edge& b ) { return a.firstRow < b.firstRow; } );
+    if ( edges.empty() )
+        return;
+
+    int firstRow = INT32_MAX, endRow = INT32_MIN;
+    for ( const Edge& edge : edges )
+    {
+        firstRow = std::min( firstRow, edge.firstRow );
+        endRow = std::max( endRow, edge.endRow );
+    }
+    bounds = Rect( FirstCenter( loX ), firstRow, FirstCenter( hiX ), endRow );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills the polygon one row at a time
+void Polygon::Fill(
+    Framebuffer& frame,
+    const Rect&  clip,
+    const Paint& paint ) const
+{
+    const Rect area = bounds.Intersect( clip );
+    if ( area.IsEmpty() )
+        return;
+
+    // Edges left of the clip region still count towards the winding of what is right of them, only
+    // rows are skipped. Edges that started below the first row join where it is
+    std::vector<ActiveEdge> active;
+    size_t next = 0;
+    for ( int y = area.bottom; y < area.top; ++y )
+    {
+        active.erase( std::remove_if( active.begin(), active.end(), [y]( const ActiveEdge& edge ) { return edge.endRow <= y; } ), active.end() );
+        for ( ; next < edges.size() && edges[next].firstRow <= y; ++next )
+        {
+            const Edge& edge = edges[next];
+            if ( edge.endRow <= y )
+                continue;
+
+            ActiveEdge joined;
+            const int64_t numerator = edge.numerator + y * edge.step;
+            const int64_t x = CeilDiv( numerator, edge.denominator );
+            joined.x = static_cast<int>( x );
+            joined.endRow = edge.endRow;
+            joined.winding = edge.winding;
+            joined.error = x * edge.denominator - numerator;
+            joined.denominator = edge.denominator;
+            joined.whole = FloorDiv( edge.step, edge.denominator );
+            joined.fraction = edge.step - joined.whole * edge.denominator;
+            active.push_back( joined );
+        }
+
+        // Edges only swap places where they cross, the list is nearly sorted from the row before
+        for ( size_t i = 1; i < active.size(); ++i )
+        {
+            const ActiveEdge edge = active[i];
+            size_t j = i;
+            for ( ; j > 0 && active[j - 1].x > edge.x; --j )
+                active[j] = active[j - 1];
+            active[j] = edge;
+        }
+
+        // A span starts where the running count turns inside and ends where it turns back out
+        int winding = 0, start = 0;
+        for ( const ActiveEdge& edge : active )
+        {
+            const bool wasInside = rule == FillRule::EVEN_ODD ? ( winding & 1 ) != 0 : winding != 0;
+            winding += rule == FillRule::EVEN_ODD ? 1 : edge.winding;
+            const bool isInside = rule == FillRule::EVEN_ODD ? ( winding & 1 ) != 0 : winding != 0;
+            if ( !wasInside && isInside )
+                start = edge.x;
+            else if ( wasInside && !isInside )
+                Rasterizer::FillSpan( frame, clip, y, start, edge.x, paint );
+        }
+
+        // Step every crossing up a row, carrying the remainder like Bresenham's
+        for ( ActiveEdge& edge : active )
+        {
+            const int64_t carry = edge.fraction > edge.error ? 1 : 0;
+            edge.x += static_cast<int>( edge.whole + carry );
+            edge.error += carry * edge.denominator - edge.fraction;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the pixels the polygon may touch
+const Rect& Polygon::GetBounds() const noexcept { return bounds; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns which parts of the polygon are filled
+FillRule Polygon::GetFillRule() const noexcept { return rule; }
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "Graphics/Qoi.h"
+#include <algorithm>
+
+// Chunk tags, the two 8 bit ones take precedence over the 2 bit ones they overlap
+static constexpr uint8_t opIndex = 0x00u;
+static constexpr uint8_t opDiff = 0x40u;
+static constexpr uint8_t opLuma = 0x80u;
+static constexpr uint8_t opRun = 0xC0u;
+static constexpr uint8_t opRgb = 0xFEu;
+static constexpr uint8_t opRgba = 0xFFu;
+static constexpr int maxRun = 62;
+
+//////////////////////////////////////////////////////////////////
+// Returns the slot of a color in the table of recently seen colors
+static inline uint32_t Hash( uint32_t color ) noexcept
+{
+    const uint32_t a = color >> 24, r = ( color >> 16 ) & 0xFFu, g = ( color >> 8 ) & 0xFFu, b = color & 0xFFu;
+    return ( r * 3u + g * 5u + b * 7u + a * 11u ) & 63u;
+}
+
+//////////////////////////////////////////////////////////////////
+// Reads a big endian 32 bit number
+static inline uint32_t ReadBig32( const uint8_t* bytes ) noexcept
+{
+    return ( static_cast<uint32_t>( bytes[0] ) << 24 ) | ( static_cast<uint32_t>( bytes[1] ) << 16 ) | ( static_cast<uint32_t>( bytes[2] ) << 8 ) | bytes[3];
+}
+
+//////////////////////////////////////////////////////////////////
+// Writes a big endian 32 bit number
+static inline uint8_t* WriteBig32(
+    uint8_t* bytes,
+    uint32_t value ) noexcept
+{
+    bytes[0] = static_cast<uint8_t>( value >> 24 );
+    bytes[1] = static_cast<uint8_t>( value >> 16 );
+    bytes[2] = static_cast<uint8_t>( value >> 8 );
+    bytes[3] = static_cast<uint8_t>( value );
+    return bytes + 4;
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Qoi                                                                  */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Reads the size of an image from its header
+bool Qoi::ReadHeader(
+    const uint8_t* data,
+    size_t         size,
+    int&           width,
+    int&           height ) noexcept
+{
+    if ( size < headerSize + paddingSize || data[0] != 'q' || data[1] != 'o' || data[2] != 'i' || data[3] != 'f' )
+        return false;
+
+    const uint32_t w = ReadBig32( data + 4 ), h = ReadBig32( data + 8 );
+    const uint8_t channels = data[12];
+    if ( w == 0u || h == 0u || w > maxPixels / h || ( channels != 3u && channels != 4u ) )
+        return false;
+
+    width = static_cast<int>( w );
+    height = static_cast<int>( h );
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Decodes an image whose header has been read
+bool Qoi::Decode(
+    const uint8_t* data,
+    size_t         size,
+    uint32_t*      pixels,
+    size_t         count ) noexcept
+{
+    // Every chunk is at most 5 bytes and the padding is 8, so starting each chunk before the padding
+    // is all the bounds checking reads need
+    const uint8_t* in = data + headerSize;
+    const uint8_t* const end = data + size - paddingSize;
+    uint32_t index[64] = {};
+    uint32_t color = 0xFF000000u;
+    for ( size_t i = 0u; i < count; )
+    {
+        if ( in >= end )
+            return false;
+
+        const uint8_t op = *in++;
+        switch ( op >> 6 )
+        {
+        case opIndex >> 6:
+            // Colors come out of the table where they already are, so it needs no update
+            color = index[op];
+            pixels[i++] = color;
+            continue;
+
+        case opDiff >> 6:
+        {
+            // Each channel changes by a small amount that wraps around
+            const uint32_t r = ( ( color >> 16 ) + ( ( op >> 4 ) & 3u ) - 2u ) & 0xFFu;
+            const uint32_t g = ( ( color >> 8 ) + ( ( op >> 2 ) & 3u ) - 2u ) & 0xFFu;
+            const uint32_t b = ( color + ( op & 3u ) - 2u ) & 0xFFu;
+            color = ( color & 0xFF000000u ) | ( r << 16 ) | ( g << 8 ) | b;
+            break;
+        }
+
+        case opLuma >> 6:
+        {
+            // Green changes by more and the others by about as much as green
+            const uint8_t next = *in++;
+            const uint32_t dg = ( op & 0x3Fu ) - 32u;
+            const uint32_t r = ( ( color >> 16 ) + dg + ( next >> 4 ) - 8u ) & 0xFFu;
+            const uint32_t g = ( ( color >> 8 ) + dg ) & 0xFFu;
+            const uint32_t b = ( color + dg + ( next & 0x0Fu ) - 8u ) & 0xFFu;
+            color = ( color & 0xFF000000u ) | ( r << 16 ) | ( g << 8 ) | b;
+            break;
+        }
+
+        default:
+            if ( op == opRgb )
+            {
+                color = ( color & 0xFF000000u ) | ( static_cast<uint32_t>( in[0] ) << 16 ) | ( static_cast<uint32_t>( in[1] ) << 8 ) | in[2];
+                in += 3;
+            }
+            else if ( op == opRgba )
+            {
+                color = ( static_cast<uint32_t>( in[3] ) << 24 ) | ( static_cast<uint32_t>( in[0] ) << 16 ) | ( static_cast<uint32_t>( in[1] ) << 8 ) | in[2];
+                in += 4;
+            }
+            else
+            {
+                // Runs repeat the previous color, only the starting color can be missing from the table
+                index[Hash( color )] = color;
+                const size_t run = std::min<size_t>( ( op & 0x3Fu ) + 1u, count - i );
+                std::fill_n( pixels + i, run, color );
+                i += run;
+                continue;
+            }
+            break;
+        }
+
+        index[Hash( color )] = color;
+        pixels[i++] = color;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Encodes an image and appends it to a buffer
+void Qoi::Encode(
+    const ImageView&      image,
+    bool                  alpha,
+    std::vector<uint8_t>& out )
+{
+    // Writes go through a pointer into room for the worst case, 5 bytes a pixel, trimmed after
+    const size_t start = out.size();
+    const size_t count = image.IsEmpty() ? 0u : static_cast<size_t>( image.width ) * image.height;
+    out.resize( start + headerSize + count * 5u + paddingSize );
+    uint8_t* bytes = out.data() + start;
+
+    *bytes++ = 'q';
+    *bytes++ = 'o';
+    *bytes++ = 'i';
+    *bytes++ = 'f';
+    bytes = WriteBig32( bytes, static_cast<uint32_t>( image.width ) );
+    bytes = WriteBig32( bytes, static_cast<uint32_t>( image.height ) );
+    *bytes++ = alpha ? 4u : 3u;
+    *bytes++ = 0u;
+
+    uint32_t index[64] = {};
+    uint32_t previous = 0xFF000000u;
+    const uint32_t forced = alpha ? 0u : 0xFF000000u;
+    int run = 0;
+    for ( int y = 0; y < image.height && count > 0u; ++y )
+    {
+        const uint32_t* row = image.GetRow( y );
+        for ( int x = 0; x < image.width; ++x )
+        {
+            const uint32_t color = row[x] | forced;
+            if ( color == previous )
+            {
+                if ( ++run == maxRun )
+                {
+                    *bytes++ = static_cast<uint8_t>( opRun | ( run - 1 ) );
+                    run = 0;
+                }
+                continue;
+            }
+
+            if ( run > 0 )
+            {
+                *bytes++ = static_cast<uint8_t>( opRun | ( run - 1 ) );
+                run = 0;
+            }
+
+            const uint32_t slot = Hash( color );
+            if ( index[slot] == color )
+            {
+                *bytes++ = static_cast<uint8_t>( opIndex | slot );
+            }
+            else
+            {
+                index[slot] = color;
+                const uint8_t r = static_cast<uint8_t>( color >> 16 ), g = static_cast<uint8_t>( color >> 8 ), b = static_cast<uint8_t>( color );
+                if ( ( color >> 24 ) != ( previous >> 24 ) )
+                {
+                    *bytes++ = opRgba;
+                    *bytes++ = r;
+                    *bytes++ = g;
+                    *bytes++ = b;
+                    *bytes++ = static_cast<uint8_t>( color >> 24 );
+                }
+                else
+                {
+                    // Differences wrap around like the decoder's sums do
+                    const int dr = static_cast<int8_t>( r - static_cast<uint8_t>( previous >> 16 ) );
+                    const int dg = static_cast<int8_t>( g - static_cast<uint8_t>( previous >> 8 ) );
+                    const int db = static_cast<int8_t>( b - static_cast<uint8_t>( previous ) );
+                    const int drg = dr - dg, dbg = db - dg;
+                    if ( dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1 )
+                    {
+                        *bytes++ = static_cast<uint8_t>( opDiff | ( ( dr + 2 ) << 4 ) | ( ( dg + 2 ) << 2 ) | ( db + 2 ) );
+                    }
+                    else if ( dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7 )
+                    {
+                        *bytes++ = static_cast<uint8_t>( opLuma | ( dg + 32 ) );
+                        *bytes++ = static_cast<uint8_t>( ( ( drg + 8 ) << 4 ) | ( dbg + 8 ) );
+                    }
+                    else
+                    {
+                        *bytes++ = opRgb;
+                        *bytes++ = r;
+                        *bytes++ = g;
+                        *bytes++ = b;
+                    }
+                }
+            }
+            previous = color;
+        }
+    }
+    if ( run > 0 )
+        *bytes++ = static_cast<uint8_t>( opRun | ( run - 1 ) );
+
+    // The stream ends with seven zeros and a one
+    bytes = std::fill_n( bytes, paddingSize - 1u, uint8_t( 0u ) );
+    *bytes++ = 1u;
+    out.resize( static_cast<size_t>( bytes - out.data() ) );
+}
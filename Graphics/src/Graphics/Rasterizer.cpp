@@ -0,0 +1,568 @@
+#include "Graphics/Rasterizer.h"
+#include "Graphics/Blend.h"
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////
+// Finds where each row of an axis aligned ellipse ends as the 
+//      midpoint algorithm would, without walking the rows between.
+//      Above the turn, where the outline's slope passes -1, a row of
+//      the walk ends at the first x whose midpoint below is outside.
+//      Below it the walk steps once per row and follows the last x 
+//      whose midpoint on the row is inside, one pixel per row at most
+class EllipseRows
+{
+public:
+    EllipseRows(
+        int64_t radiusX,
+        int64_t radiusY ) noexcept
+        :
+        rx( radiusX ),
+        ry( radiusY ),
+        exact( radiusX <= Rasterizer::exactRadius && radiusY <= Rasterizer::exactRadius )
+    {
+        // The turn is the first row whose walk reaches ry^2 x >= rx^2 y, rows only get closer to it
+        int64_t lo = 0, hi = ry;
+        while ( lo < hi )
+        {
+            const int64_t y = ( lo + hi + 1 ) / 2;
+            const int64_t x = std::max( Above( y ), Above( y + 1 ) + 1 );
+            const bool turned = exact ? ry * ry * x >= rx * rx * y : double( ry ) * ry * x >= double( rx ) * rx * y;
+            if ( turned )
+                lo = y;
+            else
+                hi = y - 1;
+        }
+
+        // The walk turns partway through that row, the rows below start from where it did
+        turn = lo;
+        if ( turn > 0 )
+        {
+            const int64_t slope = exact ? ( rx * rx * turn + ry * ry - 1 ) / ( ry * ry ) : 
+                static_cast<int64_t>( std::ceil( double( rx ) * rx * turn / ( double( ry ) * ry ) ) );
+            turnX = std::max( Above( turn + 1 ) + 1, slope );
+        }
+    }
+
+    // Returns how far row dy from the middle reaches either side of the center, -1 past the top
+    int64_t GetHalf( int64_t dy ) const noexcept
+    {
+        if ( dy > ry )
+            return -1;
+        if ( dy == 0 )
+            return rx;
+        if ( dy > turn )
+            return Above( dy );
+        return std::max( turnX, std::min( turnX + turn - dy, Below( dy ) ) );
+    }
+
+private:
+    // Smallest x whose midpoint ( x + 1, dy - 1/2 ) is on or outside the ellipse
+    int64_t Above( int64_t dy ) const noexcept
+    {
+        if ( dy > ry )
+            return -1;
+
+        // Smallest m with 4 ry^2 m^2 >= rx^2 ( 2ry - 2dy + 1 )( 2ry + 2dy - 1 ), estimated then settled
+        const int64_t p1 = 2 * ry - 2 * dy + 1, p2 = 2 * ry + 2 * dy - 1;
+        int64_t m = static_cast<int64_t>( std::ceil( double( rx ) * std::sqrt( double( p1 ) * double( p2 ) ) / ( 2.0 * double( ry ) ) ) );
+        m = std::clamp<int64_t>( m, 0, rx + 1 );
+        if ( exact )
+        {
+            const int64_t target = rx * rx * p1 * p2;
+            while ( m > 0 && 4 * ry * ry * ( m - 1 ) * ( m - 1 ) >= target )
+                --m;
+            while ( 4 * ry * ry * m * m < target )
+                ++m;
+        }
+        return std::max<int64_t>( m - 1, 0 );
+    }
+
+    // Largest x whose midpoint ( x - 1/2, dy ) is inside the ellipse
+    int64_t Below( int64_t dy ) const noexcept
+    {
+        // Largest x with ry^2 ( 2x - 1 )^2 <= 4 rx^2 ( ry - dy )( ry + dy ), estimated then settled
+        const double reach = double( rx ) * std::sqrt( 4.0 * double( ry - dy ) * double( ry + dy ) ) / double( ry );
+        int64_t x = std::clamp<int64_t>( static_cast<int64_t>( std::floor( ( reach + 1.0 ) / 2.0 ) ), 0, rx );
+        if ( exact )
+        {
+            const int64_t target = 4 * rx * rx * ( ry - dy ) * ( ry + dy );
+            while ( x > 0 && ry * ry * ( 2 * x - 1 ) * ( 2 * x - 1 ) > target )
+                --x;
+            while ( ry * ry * ( 2 * x + 1 ) * ( 2 * x + 1 ) <= target )
+                ++x;
+        }
+        return x;
+    }
+
+private:
+    int64_t rx;
+    int64_t ry;
+    bool    exact;
+    int64_t turn = 0;
+    int64_t turnX = 0;
+};
+
+//////////////////////////////////////////////////////////////////
+// Returns false if an ellipse can't draw anything inside the clip
+//      region, otherwise finds the rows of the clip region it covers
+static bool ClipEllipse(
+    const Rect&      clip,
+    const Vec2<int>& center,
+    int              radiusX,
+    int              radiusY,
+    int&             firstRow,
+    int&             endRow ) noexcept
+{
+    if ( clip.IsEmpty() || radiusX < 0 || radiusY < 0 )
+        return false;
+
+    if ( int64_t( center.x ) + radiusX < clip.left || int64_t( center.x ) - radiusX >= clip.right ||
+         int64_t( center.y ) + radiusY < clip.bottom || int64_t( center.y ) - radiusY >= clip.top )
+        return false;
+
+    firstRow = static_cast<int>( std::max<int64_t>( int64_t( center.y ) - radiusY, clip.bottom ) );
+    endRow = static_cast<int>( std::min<int64_t>( int64_t( center.y ) + radiusY + 1, clip.top ) );
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// Fills the pixels from dx = from to dx = to either side of a 
+//      center on one row, the ends are trimmed to the clip region in 
+//      64 bits so wide rows can't overflow
+static void FillMirrored(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& center,
+    int              y,
+    int64_t          from,
+    int64_t          to,
+    const Paint&     paint ) noexcept
+{
+    auto fill = [&]( int64_t left, int64_t right )
+    {
+        left = std::max<int64_t>( left, clip.left );
+        right = std::min<int64_t>( right, clip.right );
+        if ( left < right )
+            Blend::Span( frame.GetRow( y ) + left, static_cast<size_t>( right - left ), paint );
+    };
+
+    // Rows reaching the middle are a single span
+    if ( from <= 0 )
+        return fill( center.x - to, center.x + to + 1 );
+
+    fill( center.x - to, center.x - from + 1 );
+    fill( center.x + from, center.x + to + 1 );
+}
+
+//////////////////////////////////////////////////////////////////
+// Divides a * b by a divisor when the product may not fit in 64
+//      bits, a and the divisor must be below 2^47. The product is
+//      built sixteen bits of b at a time keeping only the remainder
+static void MulDivMod(
+    uint64_t  a,
+    uint64_t  b,
+    uint64_t  divisor,
+    uint64_t& quotient,
+    uint64_t& remainder ) noexcept
+{
+    quotient = 0;
+    remainder = 0;
+    for ( int shift = 48; shift >= 0; shift -= 16 )
+    {
+        const uint64_t partial = ( remainder << 16 ) + a * ( ( b >> shift ) & 0xFFFFu );
+        quotient = ( quotient << 16 ) + partial / divisor;
+        remainder = partial % divisor;
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Follows Bresenham's walk along a triangle edge a row at a time.
+//      With a run of a and a rise of b the walk first reaches row k 
+//      after j = max( ceil( a( 2k - 1 ) / 2b ) - 1, 0 ) steps in x,
+//      plus one when 2ak >= b( 2j + 1 ), so it can start at any row
+//      without walking the rows before it
+class EdgeWalk
+{
+public:
+    EdgeWalk(
+        const Vec2<int>& from,
+        const Vec2<int>& to,
+        int64_t          row ) noexcept
+        :
+        x( from.x ),
+        xStep( from.x < to.x ? 1 : -1 ),
+        run( std::abs( int64_t( to.x ) - from.x ) ),
+        rise( std::abs( int64_t( to.y ) - from.y ) )
+    {
+        // Track a( 2k - 1 ) as a multiple of 2b and a remainder, rows add 2a to it
+        uint64_t quotient, remainder;
+        MulDivMod( uint64_t( run ), uint64_t( 2 * row - 1 ), uint64_t( 2 * rise ), quotient, remainder );
+        whole = static_cast<int64_t>( quotient );
+        part = static_cast<int64_t>( remainder );
+        wholeStep = ( 2 * run ) / ( 2 * rise );
+        partStep = ( 2 * run ) % ( 2 * rise );
+    }
+
+    // Returns the x where the walk first reaches the current row
+    int64_t GetX() const noexcept
+    {
+        const int64_t j = std::max<int64_t>( whole + ( part > 0 ) - 1, 0 );
+        const bool extra = 2 * rise * ( whole - j ) + part + run - rise >= 0;
+        return x + ( j + extra ) * xStep;
+    }
+
+    // Moves on to the next row
+    void Step() noexcept
+    {
+        whole += wholeStep;
+        part += partStep;
+        if ( part >= 2 * rise )
+        {
+            part -= 2 * rise;
+            ++whole;
+        }
+    }
+
+private:
+    int64_t x;
+    int64_t xStep;
+    int64_t run;
+    int64_t rise;
+    int64_t whole;
+    int64_t part;
+    int64_t wholeStep;
+    int64_t partStep;
+};
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Rasterizer                                                           */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills a rectangle, the corners may be in any order
+void Rasterizer::FillRectangle(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& corner1, 
+    const Vec2<int>& corner2, 
+    const Paint&     paint ) noexcept
+{
+    // Initialize variables
+    int top, bottom, left, right;
+    if ( corner1.y > corner2.y )
+    {
+        top = corner1.y;
+        bottom = corner2.y;
+    }
+    else
+    {
+        top = corner2.y;
+        bottom = corner1.y;
+    }
+    if ( corner1.x < corner2.x )
+    {
+        left = corner1.x;
+        right = corner2.x;
+    }
+    else
+    {
+        left = corner2.x;
+        right = corner1.x;
+    }
+
+    // Clip once up front so the rows need no further checks
+    const Rect visible = Rect( left, bottom, right, top ).Intersect( clip );
+    if ( visible.IsEmpty() )
+        return;
+
+    // Draw every line in the rectangle, skip Bresenham's because horizontal
+    const size_t width = static_cast<size_t>( visible.right - visible.left );
+    for ( int y = visible.bottom; y < visible.top; ++y )
+        Blend::Span( frame.GetRow( y ) + visible.left, width, paint );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills a triangle by walking its edges with Bresenham's
+//          and filling the scanlines between them
+void Rasterizer::FillTriangle(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& v1,
+    const Vec2<int>& v2,
+    const Vec2<int>& v3,
+    const Paint&     paint ) noexcept
+{
+    // Reject triangles whose bounding box misses the clip region before walking any edges
+    if ( clip.IsEmpty() ||
+        std::max( { v1.x, v2.x, v3.x } ) < clip.left || std::min( { v1.x, v2.x, v3.x } ) >= clip.right ||
+        std::max( { v1.y, v2.y, v3.y } ) < clip.bottom || std::min( { v1.y, v2.y, v3.y } ) >= clip.top )
+        return;
+
+    // Initialize variables
+    Vec2<int> top = v1, middle = v2, bottom = v3;
+
+    // Order all of the verticies in descending order
+    if ( top.y < middle.y )
+        top.Swap( middle );
+
+    if ( middle.y < bottom.y )
+    {
+        middle.Swap( bottom );
+
+        if ( top.y < middle.y )
+            top.Swap( middle );
+    }
+
+    // Handle coincident points edge case
+    const int64_t dx = int64_t( top.x ) - bottom.x;
+    const int64_t dy = int64_t( top.y ) - bottom.y;
+
+    if ( dy == 0 )
+    {
+        int left = std::min( std::min( top.x, middle.x ), bottom.x );
+        int right = std::max( std::max( top.x, middle.x ), bottom.x );
+
+        DrawLine( frame, clip, { left, middle.y }, { right, middle.y }, paint );
+        return;
+    }
+
+    // Find new middle vertex, rounded to the nearest pixel with exact integer math. It lies between
+    // the top and bottom so it still fits in an int
+    const int64_t numerator = dx * ( int64_t( middle.y ) - top.y );
+    const int64_t rounded = ( 2 * numerator + ( numerator < 0 ? -dy : dy ) ) / ( 2 * dy );
+    const int newX = static_cast<int>( rounded + top.x );
+
+    // Order middle vertices
+    Vec2<int> middleLeft = { newX, middle.y }, middleRight = middle;
+    if ( middleLeft.x > middleRight.x ) 
+        middleLeft.Swap( middleRight );
+
+    // Fills the rows of one half that lie inside the clip region. The half walks from the middle
+    // row towards the tip a row at a time and each row spans to where both edges first reach the
+    // next row, rows before the clip region are skipped in constant time rather than walked
+    auto fillHalf = [&]( const Vec2<int>& tip, int64_t firstRow )
+    {
+        const int64_t yStep = tip.y > middle.y ? 1 : -1;
+        const int64_t rows = std::abs( int64_t( tip.y ) - middle.y );
+        const int64_t lo = yStep > 0 ? clip.bottom - int64_t( middle.y ) : int64_t( middle.y ) - ( clip.top - 1 );
+        const int64_t hi = yStep > 0 ? clip.top - 1 - int64_t( middle.y ) : int64_t( middle.y ) - clip.bottom;
+        const int64_t kLo = std::max( firstRow, lo ), kHi = std::min( rows, hi + 1 );
+        if ( kLo >= kHi )
+            return;
+
+        EdgeWalk left( middleLeft, tip, kLo + 1 ), right( middleRight, tip, kLo + 1 );
+        for ( int64_t k = kLo; k < kHi; ++k )
+        {
+            const int64_t from = std::max<int64_t>( left.GetX(), clip.left );
+            const int64_t to = std::min<int64_t>( right.GetX() + 1, clip.right );
+            const int y = static_cast<int>( middle.y + k * yStep );
+            if ( from < to )
+                Blend::Span( frame.GetRow( y ) + from, static_cast<size_t>( to - from ), paint );
+
+            left.Step();
+            right.Step();
+        }
+    };
+
+    // The flat bottom half draws the middle row, the flat top half starts a row past it. Neither 
+    // draws the row of its tip
+    fillHalf( top, 0 );
+    fillHalf( bottom, 1 );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws a line between two points with Bresenham's
+void Rasterizer::DrawLine(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& pos1,
+    const Vec2<int>& pos2,
+    const Paint&     paint,
+    bool             first ) noexcept
+{
+    // Reject lines whose bounding box misses the clip region entirely
+    if ( clip.IsEmpty() ||
+        std::max( pos1.x, pos2.x ) < clip.left || std::min( pos1.x, pos2.x ) >= clip.right ||
+        std::max( pos1.y, pos2.y ) < clip.bottom || std::min( pos1.y, pos2.y ) >= clip.top )
+        return;
+
+    // Horizontal lines are a single span, less the starting point when it belongs to the line before. The
+    // ends reach past the range of int and are clipped before narrowing
+    if ( pos1.y == pos2.y )
+    {
+        int64_t left = std::min( pos1.x, pos2.x ), right = int64_t( std::max( pos1.x, pos2.x ) ) + 1;
+        if ( !first && pos1.x <= pos2.x )
+            ++left;
+        else if ( !first )
+            --right;
+        left = std::clamp<int64_t>( left, clip.left, clip.right );
+        right = std::clamp<int64_t>( right, clip.left, clip.right );
+        return FillSpan( frame, clip, pos1.y, static_cast<int>( left ), static_cast<int>( right ), paint );
+    }
+
+    // Walk along the major axis one pixel per step, the minor axis advances by the rounded slope
+    const bool xMajor = std::abs( int64_t( pos2.x ) - pos1.x ) >= std::abs( int64_t( pos2.y ) - pos1.y );
+    const int64_t majorStart = xMajor ? pos1.x : pos1.y, majorEnd = xMajor ? pos2.x : pos2.y;
+    const int64_t minorStart = xMajor ? pos1.y : pos1.x, minorEnd = xMajor ? pos2.y : pos2.x;
+    const int64_t majorStep = majorStart < majorEnd ? 1 : -1, minorStep = minorStart < minorEnd ? 1 : -1;
+    const int64_t a = std::abs( majorEnd - majorStart ), b = std::abs( minorEnd - minorStart );
+
+    // Step k is drawn at majorStart + k * majorStep and minorStart + m * minorStep where
+    // m = floor( ( 2kb + a ) / 2a ), the same pixels the error accumulating form produces
+    int64_t majorLo = xMajor ? clip.left : clip.bottom, majorHi = ( xMajor ? clip.right : clip.top ) - 1;
+    int64_t minorLo = xMajor ? clip.bottom : clip.left, minorHi = ( xMajor ? clip.top : clip.right ) - 1;
+
+    // Convert the clip region into ranges of steps along each axis (Liang-Barsky on whole steps)
+    int64_t kLo = majorStep > 0 ? majorLo - majorStart : majorStart - majorHi;
+    int64_t kHi = majorStep > 0 ? majorHi - majorStart : majorStart - majorLo;
+    const int64_t mLo = std::max<int64_t>( minorStep > 0 ? minorLo - minorStart : minorStart - minorHi, 0 );
+    const int64_t mHi = std::min<int64_t>( minorStep > 0 ? minorHi - minorStart : minorStart - minorLo, b );
+    if ( mLo > mHi )
+        return;
+
+    // Smallest step reaching mLo, ceil( a( 2mLo - 1 ) / 2b ), and largest step still at mHi. Axis aligned
+    // lines never leave m = 0 and lines continuing a polyline start one step in. Runs span up to 2^32
+    // pixels so the products take up to 67 bits, they are divided without ever being formed
+    kLo = std::max<int64_t>( kLo, first ? 0 : 1 );
+    kHi = std::min( kHi, a );
+    if ( b > 0 )
+    {
+        auto ceilMulDiv = [&]( int64_t m )
+        {
+            uint64_t quotient, remainder;
+            MulDivMod( uint64_t( a ), uint64_t( 2 * m - 1 ), uint64_t( 2 * b ), quotient, remainder );
+            return static_cast<int64_t>( quotient ) + ( remainder > 0 );
+        };
+        if ( mLo > 0 )
+            kLo = std::max( kLo, ceilMulDiv( mLo ) );
+        kHi = std::min( kHi, ceilMulDiv( mHi + 1 ) - 1 );
+    }
+    if ( kLo > kHi )
+        return;
+
+    // Resume the error term at the first visible step, 2kb + a split into a multiple of 2a and the rest
+    uint64_t quotient, part;
+    MulDivMod( uint64_t( b ), uint64_t( 2 * kLo ), uint64_t( 2 * a ), quotient, part );
+    int64_t minor = static_cast<int64_t>( quotient ), remainder = static_cast<int64_t>( part ) + a;
+    if ( remainder >= 2 * a )
+    {
+        remainder -= 2 * a;
+        ++minor;
+    }
+
+    const int64_t x = xMajor ? majorStart + kLo * majorStep : minorStart + minor * minorStep;
+    const int64_t y = xMajor ? minorStart + minor * minorStep : majorStart + kLo * majorStep;
+    uint32_t* pixel = frame.GetRow( static_cast<int>( y ) ) + x;
+
+    // Pointer increments for each axis, no bounds checks are needed inside the clipped range
+    const ptrdiff_t pitch = frame.GetPitch();
+    const ptrdiff_t majorAdvance = xMajor ? majorStep : majorStep * pitch;
+    const ptrdiff_t minorAdvance = xMajor ? minorStep * pitch : minorStep;
+
+    for ( int64_t k = kLo; ; )
+    {
+        *pixel = Blend::Pixel( *pixel, paint );
+        if ( ++k > kHi )
+            break;
+
+        pixel += majorAdvance;
+        remainder += 2 * b;
+        if ( remainder >= 2 * a )
+        {
+            remainder -= 2 * a;
+            pixel += minorAdvance;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws the outline of an axis aligned ellipse with the
+//          midpoint algorithm
+void Rasterizer::DrawEllipse(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& center,
+    int              radiusX,
+    int              radiusY,
+    const Paint&     paint ) noexcept
+{
+    int firstRow, endRow;
+    if ( !ClipEllipse( clip, center, radiusX, radiusY, firstRow, endRow ) )
+        return;
+
+    // The outline of a row runs from just past the end of the row above it out to its own end, only
+    // rows inside the clip region are visited
+    const EllipseRows rows( radiusX, radiusY );
+    for ( int y = firstRow; y < endRow; ++y )
+    {
+        const int64_t dy = std::abs( int64_t( y ) - center.y );
+        const int64_t half = rows.GetHalf( dy );
+        FillMirrored( frame, clip, center, y, std::min( half, rows.GetHalf( dy + 1 ) + 1 ), half, paint );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills an axis aligned ellipse with one span per row
+void Rasterizer::FillEllipse(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& center,
+    int              radiusX,
+    int              radiusY,
+    const Paint&     paint ) noexcept
+{
+    int firstRow, endRow;
+    if ( !ClipEllipse( clip, center, radiusX, radiusY, firstRow, endRow ) )
+        return;
+
+    const EllipseRows rows( radiusX, radiusY );
+    for ( int y = firstRow; y < endRow; ++y )
+        FillMirrored( frame, clip, center, y, 0, rows.GetHalf( std::abs( int64_t( y ) - center.y ) ), paint );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Copies an image onto the surface a row at a time
+void Rasterizer::CopyImage(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const ImageView& image,
+    const Vec2<int>& position ) noexcept
+{
+    if ( image.IsEmpty() )
+        return;
+
+    const Rect area = ImageView::GetArea( position, image.width, image.height ).Intersect( clip );
+    if ( area.IsEmpty() )
+        return;
+
+    // The top row of the image is the highest row of the surface. Rows of both are contiguous, so each
+    // one is a single copy whichever way the image is stored
+    const size_t bytes = static_cast<size_t>( area.right - area.left ) * sizeof( uint32_t );
+    for ( int y = area.bottom; y < area.top; ++y )
+        std::memcpy( frame.GetRow( y ) + area.left, image.GetRow( position.y - y ) + ( area.left - position.x ), bytes );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Fills a horizontal run of pixels
+void Rasterizer::FillSpan(
+    Framebuffer& frame,
+    const Rect&  clip,
+    int          y,
+    int          left,
+    int          right,
+    const Paint& paint ) noexcept
+{
+    // Trim the run to the clip region
+    left = std::max( left, clip.left );
+    right = std::min( right, clip.right );
+
+    // Empty runs happen when the edges of a triangle cross or the run is clipped away
+    if ( right <= left || y < clip.bottom || y >= clip.top )
+        return;
+
+    Blend::Span( frame.GetRow( y ) + left, static_cast<size_t>( right - left ), paint );
+}
@@ -0,0 +1,244 @@
+#include "Graphics/Shading.h"
+#include "Utility/Simd.h"
+#include <algorithm>
+#ifdef GFX_X86
+#include <immintrin.h>
+#endif
+
+/* ======================================================================================================= */
+/*                           Kernels                                                                       */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// Returns an attribute a number of pixels along a span, wrapping the
+//      same way as the vector adds do
+static inline int32_t StepTo(
+    int32_t value,
+    int32_t step,
+    size_t  count ) noexcept
+{
+    return static_cast<int32_t>( static_cast<uint32_t>( value ) + static_cast<uint32_t>( step ) * static_cast<uint32_t>( count ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// Steps one value at a time, also finishes the vector tails
+static inline void ExpandScalar(
+    int32_t* values,
+    size_t   count,
+    int32_t  value,
+    int32_t  step ) noexcept
+{
+    for ( size_t i = 0; i < count; ++i )
+        values[i] = StepTo( value, step, i );
+}
+
+//////////////////////////////////////////////////////////////////
+// Packs colors one pixel at a time, the values are already biased
+//      by half so truncating rounds, also finishes the vector tails
+static inline void GouraudScalar(
+    uint32_t*      out,
+    size_t         count,
+    const int32_t* value,
+    const int32_t* step ) noexcept
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        uint32_t color = 0u;
+        for ( int c = 0; c < 4; ++c )
+        {
+            const int32_t channel = StepTo( value[c], step[c], i ) >> Shading::fractionBits;
+            color |= static_cast<uint32_t>( std::clamp( channel, 0, 255 ) ) << ( c * 8 );
+        }
+        out[i] = color;
+    }
+}
+
+#ifdef GFX_X86
+//////////////////////////////////////////////////////////////////
+// Steps 4 values per iteration
+static void ExpandSse2(
+    int32_t* values,
+    size_t   count,
+    int32_t  value,
+    int32_t  step ) noexcept
+{
+    __m128i current = _mm_setr_epi32( value, StepTo( value, step, 1 ), StepTo( value, step, 2 ), StepTo( value, step, 3 ) );
+    const __m128i stride = _mm_set1_epi32( StepTo( 0, step, 4 ) );
+
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( values + i ), current );
+        current = _mm_add_epi32( current, stride );
+    }
+    ExpandScalar( values + i, count - i, StepTo( value, step, i ), step );
+}
+
+//////////////////////////////////////////////////////////////////
+// Packs 4 colors per iteration, saturating packs clamp each channel
+//      and two byte unpacks interleave the planes into pixels
+static void GouraudSse2(
+    uint32_t*      out,
+    size_t         count,
+    const int32_t* value,
+    const int32_t* step ) noexcept
+{
+    __m128i current[4], stride[4];
+    for ( int c = 0; c < 4; ++c )
+    {
+        current[c] = _mm_setr_epi32( value[c], StepTo( value[c], step[c], 1 ), StepTo( value[c], step[c], 2 ), StepTo( value[c], step[c], 3 ) );
+        stride[c] = _mm_set1_epi32( StepTo( 0, step[c], 4 ) );
+    }
+
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        const __m128i bg = _mm_packs_epi32( _mm_srai_epi32( current[0], Shading::fractionBits ), _mm_srai_epi32( current[1], Shading::fractionBits ) );
+        const __m128i ra = _mm_packs_epi32( _mm_srai_epi32( current[2], Shading::fractionBits ), _mm_srai_epi32( current[3], Shading::fractionBits ) );
+
+        // Planes are bbbb gggg rrrr aaaa, first to brbr gaga then to bgra
+        const __m128i planes = _mm_packus_epi16( bg, ra );
+        const __m128i pairs = _mm_unpacklo_epi8( planes, _mm_srli_si128( planes, 8 ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( out + i ), _mm_unpacklo_epi8( pairs, _mm_srli_si128( pairs, 8 ) ) );
+
+        for ( int c = 0; c < 4; ++c )
+            current[c] = _mm_add_epi32( current[c], stride[c] );
+    }
+
+    int32_t rest[4];
+    for ( int c = 0; c < 4; ++c )
+        rest[c] = StepTo( value[c], step[c], i );
+    GouraudScalar( out + i, count - i, rest, step );
+}
+
+//////////////////////////////////////////////////////////////////
+// Steps 8 values per iteration
+GFX_TARGET_AVX2 static void ExpandAvx2(
+    int32_t* values,
+    size_t   count,
+    int32_t  value,
+    int32_t  step ) noexcept
+{
+    const __m256i lanes = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+    __m256i current = _mm256_add_epi32( _mm256_set1_epi32( value ), _mm256_mullo_epi32( lanes, _mm256_set1_epi32( step ) ) );
+    const __m256i stride = _mm256_set1_epi32( StepTo( 0, step, 8 ) );
+
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( values + i ), current );
+        current = _mm256_add_epi32( current, stride );
+    }
+    ExpandScalar( values + i, count - i, StepTo( value, step, i ), step );
+}
+
+//////////////////////////////////////////////////////////////////
+// Packs 8 colors per iteration, the packs and unpacks work within
+//      each 128 bit lane so pixels 0-3 and 4-7 come out in order
+GFX_TARGET_AVX2 static void GouraudAvx2(
+    uint32_t*      out,
+    size_t         count,
+    const int32_t* value,
+    const int32_t* step ) noexcept
+{
+    const __m256i lanes = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+    __m256i current[4], stride[4];
+    for ( int c = 0; c < 4; ++c )
+    {
+        current[c] = _mm256_add_epi32( _mm256_set1_epi32( value[c] ), _mm256_mullo_epi32( lanes, _mm256_set1_epi32( step[c] ) ) );
+        stride[c] = _mm256_set1_epi32( StepTo( 0, step[c], 8 ) );
+    }
+
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        const __m256i bg = _mm256_packs_epi32( _mm256_srai_epi32( current[0], Shading::fractionBits ), _mm256_srai_epi32( current[1], Shading::fractionBits ) );
+        const __m256i ra = _mm256_packs_epi32( _mm256_srai_epi32( current[2], Shading::fractionBits ), _mm256_srai_epi32( current[3], Shading::fractionBits ) );
+
+        const __m256i planes = _mm256_packus_epi16( bg, ra );
+        const __m256i pairs = _mm256_unpacklo_epi8( planes, _mm256_srli_si256( planes, 8 ) );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_unpacklo_epi8( pairs, _mm256_srli_si256( pairs, 8 ) ) );
+
+        for ( int c = 0; c < 4; ++c )
+            current[c] = _mm256_add_epi32( current[c], stride[c] );
+    }
+
+    int32_t rest[4];
+    for ( int c = 0; c < 4; ++c )
+        rest[c] = StepTo( value[c], step[c], i );
+    GouraudScalar( out + i, count - i, rest, step );
+}
+#endif
+
+//////////////////////////////////////////////////////////////////
+// Packs a run of colors with the best available kernel
+static void PackColors(
+    uint32_t*      out,
+    size_t         count,
+    const int32_t* value,
+    const int32_t* step ) noexcept
+{
+#ifdef GFX_X86
+    switch ( Simd::GetLevel() )
+    {
+    case Simd::Level::AVX2: return GouraudAvx2( out, count, value, step );
+    case Simd::Level::SSE2: return GouraudSse2( out, count, value, step );
+    default: break;
+    }
+#endif
+    GouraudScalar( out, count, value, step );
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Shading                                                              */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Writes every value of one attribute across a span
+void Shading::Expand(
+    int32_t* values,
+    size_t   count,
+    int32_t  value,
+    int32_t  step ) noexcept
+{
+#ifdef GFX_X86
+    switch ( Simd::GetLevel() )
+    {
+    case Simd::Level::AVX2: return ExpandAvx2( values, count, value, step );
+    case Simd::Level::SSE2: return ExpandSse2( values, count, value, step );
+    default: break;
+    }
+#endif
+    ExpandScalar( values, count, value, step );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Shader for vertex colors
+void Shading::Gouraud(
+    uint32_t*         pixels,
+    const ShadedSpan& span,
+    const void*       /*user*/ ) noexcept
+{
+    // Bias by half so the kernels round by truncating
+    int32_t value[4];
+    for ( int c = 0; c < 4; ++c )
+        value[c] = StepTo( span.value[c], 1, one / 2 );
+
+    // Opaque source over writes straight to the surface
+    const size_t count = static_cast<size_t>( span.count );
+    if ( span.blend == BlendMode::SRC_OVER && span.step[3] == 0 && ( value[3] >> fractionBits ) >= 255 )
+        return PackColors( pixels, count, value, span.step );
+
+    // Anything else is packed a chunk at a time and blended, each pixel has its own color
+    constexpr size_t chunk = 64u;
+    uint32_t colors[chunk];
+    for ( size_t i = 0; i < count; i += chunk )
+    {
+        const size_t length = std::min( chunk, count - i );
+        int32_t start[4];
+        for ( int c = 0; c < 4; ++c )
+            start[c] = StepTo( value[c], span.step[c], i );
+        PackColors( colors, length, start, span.step );
+        Blend::Colors( pixels + i, colors, length, span.blend );
+    }
+}
@@ -0,0 +1,167 @@
+#include "Graphics/SpanFill.h"
+#include "Utility/Simd.h"
+#ifdef GFX_X86
+#include <immintrin.h>
+#endif
+
+/* ======================================================================================================= */
+/*                           Kernels                                                                       */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// Writes one pixel at a time, also finishes unaligned heads/tails
+static inline void FillScalar( 
+    uint32_t* dst, 
+    size_t    count, 
+    uint32_t  value ) noexcept
+{
+    for ( size_t i = 0; i < count; ++i )
+        dst[i] = value;
+}
+
+#ifdef GFX_X86
+//////////////////////////////////////////////////////////////////
+// Writes 16 bytes per store after aligning the destination
+template<bool stream>
+static void FillSse2(
+    uint32_t* dst,
+    size_t    count,
+    uint32_t  value ) noexcept
+{
+    // Scalar stores until the destination is 16 byte aligned
+    const size_t head = ( ( 16u - ( reinterpret_cast<uintptr_t>( dst ) & 15u ) ) & 15u ) / sizeof( uint32_t );
+    if ( head >= count )
+        return FillScalar( dst, count, value );
+
+    FillScalar( dst, head, value );
+    dst += head;
+    count -= head;
+
+    // Unroll to a full cache line per iteration
+    const __m128i v = _mm_set1_epi32( static_cast<int>( value ) );
+    for ( ; count >= 16u; count -= 16u, dst += 16 )
+    {
+        __m128i* p = reinterpret_cast<__m128i*>( dst );
+        if constexpr ( stream )
+        {
+            _mm_stream_si128( p + 0, v );
+            _mm_stream_si128( p + 1, v );
+            _mm_stream_si128( p + 2, v );
+            _mm_stream_si128( p + 3, v );
+        }
+        else
+        {
+            _mm_store_si128( p + 0, v );
+            _mm_store_si128( p + 1, v );
+            _mm_store_si128( p + 2, v );
+            _mm_store_si128( p + 3, v );
+        }
+    }
+    for ( ; count >= 4u; count -= 4u, dst += 4 )
+        _mm_store_si128( reinterpret_cast<__m128i*>( dst ), v );
+
+    // Make streamed data visible before anyone else reads the surface
+    if constexpr ( stream )
+        _mm_sfence();
+
+    FillScalar( dst, count, value );
+}
+
+//////////////////////////////////////////////////////////////////
+// Writes 32 bytes per store after aligning the destination
+template<bool stream>
+GFX_TARGET_AVX2 static void FillAvx2(
+    uint32_t* dst,
+    size_t    count,
+    uint32_t  value ) noexcept
+{
+    // Scalar stores until the destination is 32 byte aligned
+    const size_t head = ( ( 32u - ( reinterpret_cast<uintptr_t>( dst ) & 31u ) ) & 31u ) / sizeof( uint32_t );
+    if ( head >= count )
+        return FillScalar( dst, count, value );
+
+    FillScalar( dst, head, value );
+    dst += head;
+    count -= head;
+
+    // Unroll to two cache lines per iteration
+    const __m256i v = _mm256_set1_epi32( static_cast<int>( value ) );
+    for ( ; count >= 32u; count -= 32u, dst += 32 )
+    {
+        __m256i* p = reinterpret_cast<__m256i*>( dst );
+        if constexpr ( stream )
+        {
+            _mm256_stream_si256( p + 0, v );
+            _mm256_stream_si256( p + 1, v );
+            _mm256_stream_si256( p + 2, v );
+            _mm256_stream_si256( p + 3, v );
+        }
+        else
+        {
+            _mm256_store_si256( p + 0, v );
+            _mm256_store_si256( p + 1, v );
+            _mm256_store_si256( p + 2, v );
+            _mm256_store_si256( p + 3, v );
+        }
+    }
+    for ( ; count >= 8u; count -= 8u, dst += 8 )
+        _mm256_store_si256( reinterpret_cast<__m256i*>( dst ), v );
+
+    // Make streamed data visible before anyone else reads the surface
+    if constexpr ( stream )
+        _mm_sfence();
+
+    FillScalar( dst, count, value );
+}
+#endif
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] SpanFill                                                             */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Sets a run of pixels to a single value
+void SpanFill::Fill(
+    uint32_t* dst,
+    size_t    count,
+    uint32_t  value ) noexcept
+{
+    // Short runs are common on triangle tips and not worth dispatching
+    if ( count < 8u )
+        return FillScalar( dst, count, value );
+
+#ifdef GFX_X86
+    switch ( Simd::GetLevel() )
+    {
+    case Simd::Level::AVX2: return FillAvx2<false>( dst, count, value );
+    case Simd::Level::SSE2: return FillSse2<false>( dst, count, value );
+    default: break;
+    }
+#endif
+    FillScalar( dst, count, value );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Sets every pixel of a surface to a single value
+void SpanFill::Clear(
+    Framebuffer& frame,
+    uint32_t     value ) noexcept
+{
+    // Rows are contiguous, so the padding is cleared too and the surface is one long run
+    uint32_t* dst = frame.GetPixels();
+    const size_t count = frame.GetSizeInBytes() / sizeof( uint32_t );
+
+#ifdef GFX_X86
+    // Streaming only pays off once the surface would evict the cache anyway
+    if ( frame.GetSizeInBytes() >= streamThreshold )
+    {
+        switch ( Simd::GetLevel() )
+        {
+        case Simd::Level::AVX2: return FillAvx2<true>( dst, count, value );
+        case Simd::Level::SSE2: return FillSse2<true>( dst, count, value );
+        default: break;
+        }
+    }
+#endif
+    Fill( dst, count, value );
+}
@@ -0,0 +1,125 @@
+#include "Graphics/Sprite.h"
+#include <algorithm>
+#include <cstring>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Sprite                                                               */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Encodes an image using its alpha
+Sprite::Sprite( const ImageView& image ) { Encode( image, false, 0u ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Encodes an image with a color key
+Sprite::Sprite(
+    const ImageView& image,
+    uint32_t         colorKey )
+{
+    Encode( image, true, colorKey );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws the sprite, only writing inside the clip region
+void Sprite::Draw(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& position,
+    BlendMode        mode ) const noexcept
+{
+    const Rect area = ImageView::GetArea( position, width, height ).Intersect( clip );
+    if ( area.IsEmpty() )
+        return;
+
+    // Rows of the sprite go down the surface from its top left pixel
+    for ( int y = area.bottom; y < area.top; ++y )
+    {
+        uint32_t* row = frame.GetRow( y );
+        const size_t end = rowRuns[position.y - y + 1];
+        for ( size_t r = rowRuns[position.y - y]; r < end; ++r )
+        {
+            // Runs are in order along the row, those left of the clip region are passed and the first one
+            // right of it ends the row
+            const Run& run = runs[r];
+            const int start = position.x + run.x;
+            if ( start >= area.right )
+                break;
+            const int left = std::max( start, area.left ), right = std::min( start + run.count, area.right );
+            if ( right <= left )
+                continue;
+
+            const uint32_t* src = pixels.data() + run.offset + ( left - start );
+            const size_t count = static_cast<size_t>( right - left );
+            if ( run.opaque && mode == BlendMode::SRC_OVER )
+                std::memcpy( row + left, src, count * sizeof( uint32_t ) );
+            else
+                Blend::Colors( row + left, src, count, mode );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of the image in pixels
+int Sprite::GetWidth() const noexcept { return width; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the height of the image in pixels
+int Sprite::GetHeight() const noexcept { return height; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of pixels kept
+size_t Sprite::GetPixelCount() const noexcept { return pixels.size(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of runs across every row
+size_t Sprite::GetRunCount() const noexcept { return runs.size(); }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] Sprite                                                              */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Splits every row into runs and keeps their pixels
+void Sprite::Encode(
+    const ImageView& image,
+    bool             keyed,
+    uint32_t         colorKey )
+{
+    if ( image.IsEmpty() )
+    {
+        rowRuns.push_back( 0u );
+        return;
+    }
+
+    width = image.width;
+    height = image.height;
+    rowRuns.reserve( static_cast<size_t>( height ) + 1u );
+    rowRuns.push_back( 0u );
+
+    // Keyed pixels are made opaque as they are kept so they copy like any other opaque run
+    auto transparent = [&]( uint32_t pixel ) { return keyed ? ( ( pixel ^ colorKey ) & 0x00FFFFFFu ) == 0u : ( pixel >> 24 ) == 0u; };
+    auto opaque = [&]( uint32_t pixel ) { return keyed || ( pixel >> 24 ) == 255u; };
+
+    for ( int y = 0; y < height; ++y )
+    {
+        const uint32_t* row = image.GetRow( y );
+        for ( int x = 0; x < width; )
+        {
+            if ( transparent( row[x] ) )
+            {
+                ++x;
+                continue;
+            }
+
+            Run run;
+            run.x = x;
+            run.opaque = opaque( row[x] );
+            run.offset = pixels.size();
+            for ( ; x < width && !transparent( row[x] ) && opaque( row[x] ) == run.opaque; ++x )
+                pixels.push_back( keyed ? row[x] | 0xFF000000u : row[x] );
+            run.count = x - run.x;
+            runs.push_back( run );
+        }
+        rowRuns.push_back( runs.size() );
+    }
+}
\ No newline at end of file
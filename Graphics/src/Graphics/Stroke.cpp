@@ -0,0 +1,445 @@
+#include "Graphics/Stroke.h"
+#include "Graphics/HalfSpace.h"
+#include "Utility/Simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#ifdef GFX_X86
+#include <immintrin.h>
+#endif
+
+/* ======================================================================================================= */
+/*                           Segments                                                                      */
+/* ======================================================================================================= */
+
+// Size of a 28.4 step in pixels, and the offset from a pixel's corner to its center
+static constexpr float pixel = 1.0f / HalfSpace::subpixelScale;
+static constexpr int center = HalfSpace::subpixelScale / 2;
+
+//////////////////////////////////////////////////////////////////
+// A segment prepared for measuring distances, built the same way
+//      by both segments sharing it so they agree on every pixel
+struct Segment
+{
+    // First point in 28.4 fixed point and the step to the last in pixels
+    int x;
+    int y;
+    float dx;
+    float dy;
+
+    // Reciprocal of the squared length, zero for a single point
+    float inverse;
+
+    // Corners of the rectangle around the line in pixels, every covered pixel center lies inside it,
+    // and the change in x along each edge per pixel in y
+    double cornerX[4];
+    double cornerY[4];
+    double slope[4];
+};
+
+//////////////////////////////////////////////////////////////////
+// Clips a segment against the guard band so every offset from a
+//      pixel stays exact in a float, returns false if nothing is left
+static bool ClipToGuardBand(
+    Vec2<int>& start,
+    Vec2<int>& end ) noexcept
+{
+    constexpr double band = double( HalfSpace::guardBand ) * HalfSpace::subpixelScale;
+    if ( std::max( std::abs( double( start.x ) ), std::abs( double( end.x ) ) ) <= band &&
+         std::max( std::abs( double( start.y ) ), std::abs( double( end.y ) ) ) <= band )
+        return true;
+
+    // Liang-Barsky against each side, as distances the segment may travel before leaving
+    const double x = start.x, y = start.y, dx = double( end.x ) - x, dy = double( end.y ) - y;
+    const double step[4] = { -dx, dx, -dy, dy };
+    const double room[4] = { x + band, band - x, y + band, band - y };
+    double enter = 0.0, leave = 1.0;
+    for ( int side = 0; side < 4; ++side )
+    {
+        if ( step[side] == 0.0 )
+        {
+            if ( room[side] < 0.0 )
+                return false;
+            continue;
+        }
+
+        const double t = room[side] / step[side];
+        if ( step[side] < 0.0 )
+            enter = std::max( enter, t );
+        else
+            leave = std::min( leave, t );
+    }
+    if ( enter > leave )
+        return false;
+
+    start = Vec2<int>( static_cast<int>( std::llround( x + dx * enter ) ), static_cast<int>( std::llround( y + dy * enter ) ) );
+    end = Vec2<int>( static_cast<int>( std::llround( x + dx * leave ) ), static_cast<int>( std::llround( y + dy * leave ) ) );
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// Prepares a segment for a line of the given radius
+static Segment MakeSegment(
+    const Vec2<int>& start,
+    const Vec2<int>& end,
+    double           radius ) noexcept
+{
+    Segment segment;
+    segment.x = start.x;
+    segment.y = start.y;
+    segment.dx = static_cast<float>( end.x - start.x ) * pixel;
+    segment.dy = static_cast<float>( end.y - start.y ) * pixel;
+    const float squared = segment.dx * segment.dx + segment.dy * segment.dy;
+    segment.inverse = squared > 0.0f ? 1.0f / squared : 0.0f;
+
+    // Along the segment and across it, a single point gets an axis aligned square
+    const double length = std::sqrt( double( segment.dx ) * segment.dx + double( segment.dy ) * segment.dy );
+    const double ux = length > 0.0 ? segment.dx / length : 1.0, uy = length > 0.0 ? segment.dy / length : 0.0;
+    const double ax = start.x * double( pixel ), ay = start.y * double( pixel );
+    const double bx = end.x * double( pixel ), by = end.y * double( pixel );
+    const double ends[4][2] = { { ax, ay }, { bx, by }, { bx, by }, { ax, ay } };
+    const double along[4] = { -radius, radius, radius, -radius };
+    const double across[4] = { -radius, -radius, radius, radius };
+    for ( int i = 0; i < 4; ++i )
+    {
+        segment.cornerX[i] = ends[i][0] + ux * along[i] - uy * across[i];
+        segment.cornerY[i] = ends[i][1] + uy * along[i] + ux * across[i];
+    }
+    for ( int i = 0; i < 4; ++i )
+    {
+        const int j = ( i + 1 ) % 4;
+        const double rise = segment.cornerY[j] - segment.cornerY[i];
+        segment.slope[i] = rise != 0.0 ? ( segment.cornerX[j] - segment.cornerX[i] ) / rise : 0.0;
+    }
+    return segment;
+}
+
+//////////////////////////////////////////////////////////////////
+// Finds the pixels of a row whose centers lie inside the rectangle
+//      around a segment, returns false if there are none
+static bool RowSpan(
+    const Segment& segment,
+    int            y,
+    int&           left,
+    int&           right ) noexcept
+{
+    const double row = y + 0.5;
+    double lo = HUGE_VAL, hi = -HUGE_VAL;
+    for ( int i = 0; i < 4; ++i )
+    {
+        const int j = ( i + 1 ) % 4;
+        const double y0 = segment.cornerY[i], y1 = segment.cornerY[j];
+        if ( ( row < y0 && row < y1 ) || ( row > y0 && row > y1 ) )
+            continue;
+
+        // An edge along the row contributes both of its ends
+        const double x = segment.cornerX[i] + ( row - y0 ) * segment.slope[i];
+        const double other = y0 == y1 ? segment.cornerX[j] : x;
+        lo = std::min( { lo, x, other } );
+        hi = std::max( { hi, x, other } );
+    }
+    if ( lo > hi )
+        return false;
+
+    left = static_cast<int>( std::ceil( lo - 0.5 ) );
+    right = static_cast<int>( std::floor( hi - 0.5 ) ) + 1;
+    return left < right;
+}
+
+/* ======================================================================================================= */
+/*                           Kernels                                                                       */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// Returns the coverage of one pixel from 0 to 255, one minus the
+//      distance from its center to the edge of the line. Aliased
+//      lines keep only pixels at least half covered
+static inline int32_t CoverageAt(
+    const Segment& segment,
+    int            x,
+    int            y,
+    float          radius,
+    bool           antialias ) noexcept
+{
+    const float wx = static_cast<float>( x * HalfSpace::subpixelScale + center - segment.x ) * pixel;
+    const float wy = static_cast<float>( y * HalfSpace::subpixelScale + center - segment.y ) * pixel;
+
+    // Nearest point of the segment, then the distance to it
+    const float t = std::min( std::max( ( wx * segment.dx + wy * segment.dy ) * segment.inverse, 0.0f ), 1.0f );
+    const float ex = wx - t * segment.dx, ey = wy - t * segment.dy;
+    const float distance = std::sqrt( ex * ex + ey * ey );
+
+    const float covered = std::min( std::max( radius - distance, 0.0f ), 1.0f );
+    const int32_t coverage = static_cast<int32_t>( covered * 255.0f + 0.5f );
+    return antialias ? coverage : coverage > 127 ? 255 : 0;
+}
+
+//////////////////////////////////////////////////////////////////
+// What a kernel does with the coverage it measures, a segment covers
+//      its pixels first and then yields them to an earlier neighbour
+//      covering as much or a later one covering more
+enum class Pass { COVER, YIELD_EARLIER, YIELD_LATER };
+
+//////////////////////////////////////////////////////////////////
+// Measures coverage one pixel at a time, also finishes the vector
+//      tails
+static void MeasureScalar(
+    uint8_t*       coverage,
+    int            count,
+    int            x,
+    int            y,
+    const Segment& segment,
+    float          radius,
+    bool           antialias,
+    Pass           pass ) noexcept
+{
+    for ( int i = 0; i < count; ++i )
+    {
+        const int32_t measured = CoverageAt( segment, x + i, y, radius, antialias );
+        if ( pass == Pass::COVER )
+            coverage[i] = static_cast<uint8_t>( measured );
+        else if ( measured > coverage[i] || ( pass == Pass::YIELD_EARLIER && measured == coverage[i] ) )
+            coverage[i] = 0u;
+    }
+}
+
+#ifdef GFX_X86
+//////////////////////////////////////////////////////////////////
+// Coverage of 4 pixels in a row, the same operations in the same
+//      order as the scalar version
+static inline __m128i CoverageSse2(
+    const Segment& segment,
+    int            x,
+    int            y,
+    __m128         radius,
+    bool           antialias ) noexcept
+{
+    const __m128 scale = _mm_set1_ps( pixel ), zero = _mm_setzero_ps(), one = _mm_set1_ps( 1.0f );
+    const __m128i offsets = _mm_setr_epi32( 0, HalfSpace::subpixelScale, 2 * HalfSpace::subpixelScale, 3 * HalfSpace::subpixelScale );
+    const __m128 wx = _mm_mul_ps( _mm_cvtepi32_ps( _mm_add_epi32( _mm_set1_epi32( x * HalfSpace::subpixelScale + center - segment.x ), offsets ) ), scale );
+    const __m128 wy = _mm_set1_ps( static_cast<float>( y * HalfSpace::subpixelScale + center - segment.y ) * pixel );
+    const __m128 dx = _mm_set1_ps( segment.dx ), dy = _mm_set1_ps( segment.dy );
+
+    const __m128 dot = _mm_add_ps( _mm_mul_ps( wx, dx ), _mm_mul_ps( wy, dy ) );
+    const __m128 t = _mm_min_ps( _mm_max_ps( _mm_mul_ps( dot, _mm_set1_ps( segment.inverse ) ), zero ), one );
+    const __m128 ex = _mm_sub_ps( wx, _mm_mul_ps( t, dx ) ), ey = _mm_sub_ps( wy, _mm_mul_ps( t, dy ) );
+    const __m128 distance = _mm_sqrt_ps( _mm_add_ps( _mm_mul_ps( ex, ex ), _mm_mul_ps( ey, ey ) ) );
+
+    const __m128 covered = _mm_min_ps( _mm_max_ps( _mm_sub_ps( radius, distance ), zero ), one );
+    const __m128i coverage = _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( covered, _mm_set1_ps( 255.0f ) ), _mm_set1_ps( 0.5f ) ) );
+    return antialias ? coverage : _mm_and_si128( _mm_cmpgt_epi32( coverage, _mm_set1_epi32( 127 ) ), _mm_set1_epi32( 255 ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures coverage of 4 pixels per iteration
+static void MeasureSse2(
+    uint8_t*       coverage,
+    int            count,
+    int            x,
+    int            y,
+    const Segment& segment,
+    float          radius,
+    bool           antialias,
+    Pass           pass ) noexcept
+{
+    const __m128 r = _mm_set1_ps( radius );
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        __m128i measured = CoverageSse2( segment, x + i, y, r, antialias );
+        if ( pass != Pass::COVER )
+        {
+            int bytes;
+            std::memcpy( &bytes, coverage + i, 4 );
+            const __m128i own = _mm_unpacklo_epi16( _mm_unpacklo_epi8( _mm_cvtsi32_si128( bytes ), zero ), zero );
+            measured = pass == Pass::YIELD_EARLIER ?
+                _mm_and_si128( own, _mm_cmpgt_epi32( own, measured ) ) :
+                _mm_andnot_si128( _mm_cmpgt_epi32( measured, own ), own );
+        }
+
+        const __m128i words = _mm_packs_epi32( measured, measured );
+        const int bytes = _mm_cvtsi128_si32( _mm_packus_epi16( words, words ) );
+        std::memcpy( coverage + i, &bytes, 4 );
+    }
+    MeasureScalar( coverage + i, count - i, x + i, y, segment, radius, antialias, pass );
+}
+
+//////////////////////////////////////////////////////////////////
+// Coverage of 8 pixels in a row, the same operations in the same
+//      order as the scalar version
+GFX_TARGET_AVX2 static inline __m256i CoverageAvx2(
+    const Segment& segment,
+    int            x,
+    int            y,
+    __m256         radius,
+    bool           antialias ) noexcept
+{
+    const __m256 scale = _mm256_set1_ps( pixel ), zero = _mm256_setzero_ps(), one = _mm256_set1_ps( 1.0f );
+    const __m256i offsets = _mm256_mullo_epi32( _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ), _mm256_set1_epi32( HalfSpace::subpixelScale ) );
+    const __m256 wx = _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_add_epi32( _mm256_set1_epi32( x * HalfSpace::subpixelScale + center - segment.x ), offsets ) ), scale );
+    const __m256 wy = _mm256_set1_ps( static_cast<float>( y * HalfSpace::subpixelScale + center - segment.y ) * pixel );
+    const __m256 dx = _mm256_set1_ps( segment.dx ), dy = _mm256_set1_ps( segment.dy );
+
+    const __m256 dot = _mm256_add_ps( _mm256_mul_ps( wx, dx ), _mm256_mul_ps( wy, dy ) );
+    const __m256 t = _mm256_min_ps( _mm256_max_ps( _mm256_mul_ps( dot, _mm256_set1_ps( segment.inverse ) ), zero ), one );
+    const __m256 ex = _mm256_sub_ps( wx, _mm256_mul_ps( t, dx ) ), ey = _mm256_sub_ps( wy, _mm256_mul_ps( t, dy ) );
+    const __m256 distance = _mm256_sqrt_ps( _mm256_add_ps( _mm256_mul_ps( ex, ex ), _mm256_mul_ps( ey, ey ) ) );
+
+    const __m256 covered = _mm256_min_ps( _mm256_max_ps( _mm256_sub_ps( radius, distance ), zero ), one );
+    const __m256i coverage = _mm256_cvttps_epi32( _mm256_add_ps( _mm256_mul_ps( covered, _mm256_set1_ps( 255.0f ) ), _mm256_set1_ps( 0.5f ) ) );
+    return antialias ? coverage : _mm256_and_si256( _mm256_cmpgt_epi32( coverage, _mm256_set1_epi32( 127 ) ), _mm256_set1_epi32( 255 ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// Measures coverage of 8 pixels per iteration
+GFX_TARGET_AVX2 static void MeasureAvx2(
+    uint8_t*       coverage,
+    int            count,
+    int            x,
+    int            y,
+    const Segment& segment,
+    float          radius,
+    bool           antialias,
+    Pass           pass ) noexcept
+{
+    const __m256 r = _mm256_set1_ps( radius );
+    int i = 0;
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        __m256i measured = CoverageAvx2( segment, x + i, y, r, antialias );
+        if ( pass != Pass::COVER )
+        {
+            const __m256i own = _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( coverage + i ) ) );
+            measured = pass == Pass::YIELD_EARLIER ?
+                _mm256_and_si256( own, _mm256_cmpgt_epi32( own, measured ) ) :
+                _mm256_andnot_si256( _mm256_cmpgt_epi32( measured, own ), own );
+        }
+
+        // Both halves down to 16 bits then to bytes, in order
+        const __m128i words = _mm_packs_epi32( _mm256_castsi256_si128( measured ), _mm256_extracti128_si256( measured, 1 ) );
+        _mm_storel_epi64( reinterpret_cast<__m128i*>( coverage + i ), _mm_packus_epi16( words, words ) );
+    }
+    MeasureScalar( coverage + i, count - i, x + i, y, segment, radius, antialias, pass );
+}
+#endif
+
+//////////////////////////////////////////////////////////////////
+// Measures coverage of a run of pixels with the best available
+//      kernel
+static void Measure(
+    uint8_t*       coverage,
+    int            count,
+    int            x,
+    int            y,
+    const Segment& segment,
+    float          radius,
+    bool           antialias,
+    Pass           pass ) noexcept
+{
+#ifdef GFX_X86
+    switch ( Simd::GetLevel() )
+    {
+    case Simd::Level::AVX2: return MeasureAvx2( coverage, count, x, y, segment, radius, antialias, pass );
+    case Simd::Level::SSE2: return MeasureSse2( coverage, count, x, y, segment, radius, antialias, pass );
+    default: break;
+    }
+#endif
+    MeasureScalar( coverage, count, x, y, segment, radius, antialias, pass );
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Stroke                                                               */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws one segment of a line
+void Stroke::DrawSegment(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& start,
+    const Vec2<int>& end,
+    const Vec2<int>& previous,
+    const Vec2<int>& next,
+    float            width,
+    bool             antialias,
+    uint32_t         color,
+    BlendMode        blend ) noexcept
+{
+    const Rect area = GetBounds( start, end, width ).Intersect( clip );
+    if ( area.IsEmpty() )
+        return;
+
+    // Coverage falls from full to none over the pixel either side of the edge
+    const float radius = std::max( width, 1.0f ) * 0.5f + 0.5f;
+
+    // Neighbours are clipped exactly as they clip themselves, so both sides of a shared point agree
+    Vec2<int> a = start, b = end;
+    if ( !ClipToGuardBand( a, b ) )
+        return;
+    const Segment segment = MakeSegment( a, b, radius );
+
+    Segment neighbours[2];
+    const Vec2<int> from[2] = { previous, end }, to[2] = { start, next };
+    const Pass passes[2] = { Pass::YIELD_EARLIER, Pass::YIELD_LATER };
+    bool hasNeighbour[2];
+    for ( int n = 0; n < 2; ++n )
+    {
+        Vec2<int> p = from[n], q = to[n];
+        hasNeighbour[n] = p != q && ClipToGuardBand( p, q );
+        if ( hasNeighbour[n] )
+            neighbours[n] = MakeSegment( p, q, radius );
+    }
+
+    constexpr int chunk = 64;
+    uint8_t coverage[chunk];
+    for ( int y = area.bottom; y < area.top; ++y )
+    {
+        int left, right;
+        if ( !RowSpan( segment, y, left, right ) )
+            continue;
+        left = std::max( left, area.left );
+        right = std::min( right, area.right );
+        if ( left >= right )
+            continue;
+
+        // Neighbours are only measured where their own rectangles overlap this one
+        int reach[2][2] = { { 0, 0 }, { 0, 0 } };
+        for ( int n = 0; n < 2; ++n )
+            if ( hasNeighbour[n] && !RowSpan( neighbours[n], y, reach[n][0], reach[n][1] ) )
+                reach[n][0] = reach[n][1] = 0;
+
+        uint32_t* row = frame.GetRow( y );
+        for ( int x = left; x < right; x += chunk )
+        {
+            const int count = std::min( chunk, right - x );
+            Measure( coverage, count, x, y, segment, radius, antialias, Pass::COVER );
+            for ( int n = 0; n < 2; ++n )
+            {
+                const int lo = std::max( x, reach[n][0] ), hi = std::min( x + count, reach[n][1] );
+                if ( hasNeighbour[n] && lo < hi )
+                    Measure( coverage + ( lo - x ), hi - lo, lo, y, neighbours[n], radius, antialias, passes[n] );
+            }
+            Blend::Coverage( row + x, coverage, static_cast<size_t>( count ), color, blend );
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the pixels a segment may touch
+Rect Stroke::GetBounds(
+    const Vec2<int>& start,
+    const Vec2<int>& end,
+    float            width ) noexcept
+{
+    // Round the reach of the line outwards to whole 28.4 steps, then to pixels whose centers it can reach
+    const int64_t reach = static_cast<int64_t>( std::ceil( ( std::max( width, 1.0f ) * 0.5f + 0.5f ) * HalfSpace::subpixelScale ) );
+    const int64_t loX = std::min<int64_t>( start.x, end.x ) - reach - center, hiX = std::max<int64_t>( start.x, end.x ) + reach - center;
+    const int64_t loY = std::min<int64_t>( start.y, end.y ) - reach - center, hiY = std::max<int64_t>( start.y, end.y ) + reach - center;
+    auto clamp = []( int64_t value ) { return static_cast<int>( std::clamp<int64_t>( value, INT32_MIN / 2, INT32_MAX / 2 ) ); };
+    return Rect(
+        clamp( ( loX >> HalfSpace::subpixelBits ) + 1 ),
+        clamp( ( loY >> HalfSpace::subpixelBits ) + 1 ),
+        clamp( ( hiX >> HalfSpace::subpixelBits ) + 1 ),
+        clamp( ( hiY >> HalfSpace::subpixelBits ) + 1 ) );
+}
\ No newline at end of file
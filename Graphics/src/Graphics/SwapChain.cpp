@@ -0,0 +1,158 @@
+#include "Graphics/SwapChain.h"
+#include "Graphics/SpanFill.h"
+#include <algorithm>
+#include <utility>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] SwapChain                                                            */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Allocates the spare buffers and starts the present 
+//          thread
+SwapChain::SwapChain(
+    int                        width,
+    int                        height,
+    unsigned                   bufferCount,
+    std::unique_ptr<Presenter> presenter,
+    uint32_t                   clearColor )
+    :
+    presenter( std::move( presenter ) ),
+    clearColor( clearColor ),
+    bufferCount( std::max( bufferCount, 2u ) ),
+    shown( width, height )
+{
+    // The drawing thread already holds one buffer
+    ready.resize( this->bufferCount - 1u );
+    for ( Slot& slot : ready )
+    {
+        slot.frame = Framebuffer( width, height );
+        slot.drawn = DirtyRegion( width, height );
+        SpanFill::Clear( slot.frame, clearColor );
+    }
+
+    thread = std::thread( &SwapChain::PresentLoop, this );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Presents every queued frame and stops the present 
+//          thread
+SwapChain::~SwapChain()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    frameQueued.notify_one();
+    thread.join();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Queues a finished frame and hands back a cleared buffer
+void SwapChain::Swap(
+    Framebuffer& frame,
+    DirtyRegion& drawn,
+    bool         presentAll )
+{
+    Slot next;
+    {
+        // Waiting here is what keeps the drawing thread at most a few frames ahead of the display
+        std::unique_lock<std::mutex> lock( mutex );
+        bufferReady.wait( lock, [this] { return !ready.empty(); } );
+        next = std::move( ready.back() );
+        ready.pop_back();
+
+        queued.push_back( Slot{ std::move( frame ), std::move( drawn ), presentAll } );
+    }
+    frameQueued.notify_one();
+
+    frame = std::move( next.frame );
+    drawn = std::move( next.drawn );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Blocks until every queued frame has been presented
+void SwapChain::Wait()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    bufferReady.wait( lock, [this] { return queued.empty() && !presenting; } );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Waits for every queued frame and gives up the presenter
+std::unique_ptr<Presenter> SwapChain::ReleasePresenter()
+{
+    Wait();
+    return std::move( presenter );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the total number of buffers
+unsigned SwapChain::GetBufferCount() const noexcept { return bufferCount; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] SwapChain                                                           */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Presents and clears queued frames until stopped
+void SwapChain::PresentLoop()
+{
+    while ( true )
+    {
+        Slot slot;
+        {
+            // Frames still queued when stopping are presented before leaving
+            std::unique_lock<std::mutex> lock( mutex );
+            frameQueued.wait( lock, [this] { return stopping || !queued.empty(); } );
+            if ( queued.empty() )
+                return;
+
+            slot = std::move( queued.front() );
+            queued.pop_front();
+            presenting = true;
+        }
+
+        PresentSlot( slot );
+
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            ready.push_back( std::move( slot ) );
+            presenting = false;
+        }
+        bufferReady.notify_all();
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Presents what changed in a frame since the last one 
+//           and clears what was drawn into it
+void SwapChain::PresentSlot( Slot& slot )
+{
+    // Every buffer holds the clear color outside its drawn tiles, so only this frame's and the last one's differ
+    shown.Merge( slot.drawn );
+
+    if ( presenter )
+    {
+        if ( slot.presentAll || shown.GetCoverage() >= DirtyRegion::fullCoverage )
+            presenter->Present( slot.frame );
+        else
+        {
+            shown.GetRects( dirtyRects );
+            presenter->PresentRegion( slot.frame, dirtyRects );
+        }
+    }
+
+    if ( slot.drawn.GetCoverage() >= DirtyRegion::fullCoverage )
+        SpanFill::Clear( slot.frame, clearColor );
+    else
+    {
+        slot.drawn.GetRects( dirtyRects );
+        for ( const Rect& rect : dirtyRects )
+            for ( int y = rect.bottom; y < rect.top; ++y )
+                SpanFill::Fill( slot.frame.GetRow( y ) + rect.left, static_cast<size_t>( rect.right - rect.left ), clearColor );
+    }
+
+    std::swap( shown, slot.drawn );
+    slot.drawn.Reset();
+}
@@ -0,0 +1,127 @@
+#include "Graphics/TextCache.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+//////////////////////////////////////////////////////////////////
+// Decodes the character starting at a position of a UTF-8 string
+//      and moves past it, malformed bytes are one character each that
+//      no font has
+static uint32_t NextCharacter(
+    std::string_view text,
+    size_t&          i ) noexcept
+{
+    constexpr uint32_t malformed = 0xFFFDu;
+    const uint8_t lead = static_cast<uint8_t>( text[i++] );
+    if ( lead < 0x80u )
+        return lead;
+
+    const int length = lead >= 0xF0u ? 3 : lead >= 0xE0u ? 2 : lead >= 0xC0u ? 1 : -1;
+    if ( length < 0 || i + length > text.size() )
+        return malformed;
+
+    uint32_t character = lead & ( 0x3Fu >> length );
+    for ( int k = 0; k < length; ++k )
+    {
+        const uint8_t next = static_cast<uint8_t>( text[i] );
+        if ( ( next & 0xC0u ) != 0x80u )
+            return malformed;
+        character = ( character << 6 ) | ( next & 0x3Fu );
+        ++i;
+    }
+    return character;
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] TextCache                                                            */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Constructs empty caches
+TextCache::TextCache(
+    size_t glyphCapacity,
+    size_t layoutCapacity )
+    :
+    glyphs( glyphCapacity ),
+    layouts( layoutCapacity )
+{
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a string laid out
+std::shared_ptr<const TextLayout> TextCache::GetLayout(
+    const Font&      font,
+    std::string_view text,
+    int              scale )
+{
+    scale = std::clamp( scale, 1, maxScale );
+    const uint64_t id = font.GetId();
+    key.resize( sizeof( id ) + sizeof( scale ) );
+    std::memcpy( key.data(), &id, sizeof( id ) );
+    std::memcpy( key.data() + sizeof( id ), &scale, sizeof( scale ) );
+    key.append( text );
+    if ( const auto* found = layouts.Find( key ) )
+        return *found;
+
+    // The pen starts at the top left and lines go down the surface, so glyph rows counted down from the top
+    // of their line are subtracted. Kerning only applies between characters on the same line
+    std::vector<TextSpan> spans;
+    const int lineHeight = font.GetCellHeight() * scale;
+    int x = 0, y = 0, width = 0;
+    uint32_t previous = 0u;
+    for ( size_t i = 0; i < text.size(); )
+    {
+        const uint32_t character = NextCharacter( text, i );
+        if ( character == '\n' )
+        {
+            width = std::max( width, x );
+            x = 0;
+            y += lineHeight;
+            previous = 0u;
+            continue;
+        }
+
+        if ( previous != 0u )
+            x += font.GetKerning( previous, character ) * scale;
+        const Glyph& glyph = GetGlyph( font, character, scale );
+        for ( const TextSpan& span : glyph.spans )
+            spans.push_back( { -( y + span.y ), x + span.left, x + span.right } );
+        x += glyph.advance;
+        previous = character;
+    }
+    width = std::max( width, x );
+
+    auto layout = std::make_shared<const TextLayout>( std::move( spans ), Vec2<int>( width, y + lineHeight ) );
+    return layouts.Insert( key, std::move( layout ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a character rasterized
+const Glyph& TextCache::GetGlyph(
+    const Font& font,
+    uint32_t    character,
+    int         scale )
+{
+    // Ids fit 32 bits long before they run out, characters 24 and scales 8
+    scale = std::clamp( scale, 1, maxScale );
+    const uint64_t glyphKey = ( font.GetId() << 32 ) | ( static_cast<uint64_t>( std::min( character, 0xFFFFFFu ) ) << 8 ) | static_cast<uint64_t>( scale );
+    if ( const Glyph* found = glyphs.Find( glyphKey ) )
+        return *found;
+    return glyphs.Insert( glyphKey, font.Rasterize( character, scale ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Drops every glyph and layout
+void TextCache::Clear()
+{
+    glyphs.Clear();
+    layouts.Clear();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of glyphs kept
+size_t TextCache::GetGlyphCount() const noexcept { return glyphs.GetSize(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of laid out strings kept
+size_t TextCache::GetLayoutCount() const noexcept { return layouts.GetSize(); }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "Graphics/TextLayout.h"
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] TextLayout                                                           */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Sorts the spans and joins those that touch
+TextLayout::TextLayout(
+    std::vector<TextSpan> spans,
+    const Vec2<int>&      size )
+    :
+    spans( std::move( spans ) ),
+    size( size )
+{
+    // Glyphs are added left to right with their spans top to bottom, so counting spans into rows puts
+    // every row in pen order. Only a glyph kerned back past its neighbor is out of place, sorting a row
+    // by insertion puts it back
+    if ( !this->spans.empty() )
+    {
+        int firstRow = INT_MAX, lastRow = INT_MIN;
+        for ( const TextSpan& span : this->spans )
+        {
+            firstRow = std::min( firstRow, span.y );
+            lastRow = std::max( lastRow, span.y );
+        }
+
+        std::vector<size_t> rowStart( static_cast<size_t>( lastRow - firstRow ) + 2u, 0u );
+        for ( const TextSpan& span : this->spans )
+            ++rowStart[span.y - firstRow + 1];
+        for ( size_t row = 1; row < rowStart.size(); ++row )
+            rowStart[row] += rowStart[row - 1];
+
+        std::vector<TextSpan> sorted( this->spans.size() );
+        for ( const TextSpan& span : this->spans )
+        {
+            size_t& next = rowStart[span.y - firstRow];
+            size_t i = next++;
+            for ( ; i > 0 && sorted[i - 1].y == span.y && sorted[i - 1].left > span.left; --i )
+                sorted[i] = sorted[i - 1];
+            sorted[i] = span;
+        }
+        this->spans = std::move( sorted );
+    }
+
+    // Kerned characters may overlap, joining them also keeps their shared pixels from blending twice
+    size_t count = 0u;
+    for ( const TextSpan& span : this->spans )
+    {
+        if ( count > 0u && this->spans[count - 1].y == span.y && this->spans[count - 1].right >= span.left )
+            this->spans[count - 1].right = std::max( this->spans[count - 1].right, span.right );
+        else
+            this->spans[count++] = span;
+    }
+    this->spans.resize( count );
+
+    if ( this->spans.empty() )
+        return;
+    bounds = Rect( INT_MAX, this->spans.front().y, INT_MIN, this->spans.back().y + 1 );
+    for ( const TextSpan& span : this->spans )
+    {
+        bounds.left = std::min( bounds.left, span.left );
+        bounds.right = std::max( bounds.right, span.right );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws the text, only writing inside the clip region
+void TextLayout::Draw(
+    Framebuffer&     frame,
+    const Rect&      clip,
+    const Vec2<int>& position,
+    const Paint&     paint ) const noexcept
+{
+    const Rect area = Rect(
+        position.x + bounds.left, position.y + bounds.bottom,
+        position.x + bounds.right, position.y + bounds.top ).Intersect( clip );
+    if ( area.IsEmpty() )
+        return;
+
+    // Tiles only see a few rows of a long paragraph, skip straight to the first of them
+    const int firstRow = area.bottom - position.y, endRow = area.top - position.y;
+    auto span = std::lower_bound( spans.begin(), spans.end(), firstRow, []( const TextSpan& s, int y ) { return s.y < y; } );
+    for ( ; span != spans.end() && span->y < endRow; ++span )
+    {
+        const int left = std::max( position.x + span->left, area.left ), right = std::min( position.x + span->right, area.right );
+        if ( right <= left )
+            continue;
+
+        // Spans of small text are a few pixels long, opaque ones are stored directly rather than paying for a
+        // call into the fill kernels
+        uint32_t* pixels = frame.GetRow( position.y + span->y ) + left;
+        if ( paint.replace )
+            std::fill( pixels, pixels + ( right - left ), paint.color );
+        else
+            Blend::Span( pixels, static_cast<size_t>( right - left ), paint );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the pixels the ink covers
+const Rect& TextLayout::GetBounds() const noexcept { return bounds; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of the longest line and the height of
+//          every line
+const Vec2<int>& TextLayout::GetSize() const noexcept { return size; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of spans drawn
+size_t TextLayout::GetSpanCount() const noexcept { return spans.size(); }
\ No newline at end of file
@@ -0,0 +1,396 @@
+#include "Graphics/Texture.h"
+#include "Graphics/Blend.h"
+#include "Utility/Simd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#ifdef GFX_X86
+#include <immintrin.h>
+#endif
+
+/* ======================================================================================================= */
+/*                           Texels                                                                        */
+/* ======================================================================================================= */
+
+// Offsets of a texel within its 4x4 tile by column and by row, interleaving the bits of both
+static constexpr uint8_t mortonX[4] = { 0, 1, 4, 5 };
+static constexpr uint8_t mortonY[4] = { 0, 2, 8, 10 };
+
+//////////////////////////////////////////////////////////////////
+// Blends two texels with a weight out of 256 for the second, two
+//      channels at a time with 16 bits each so nothing overflows
+static inline uint32_t Lerp(
+    uint32_t a,
+    uint32_t b,
+    uint32_t weight ) noexcept
+{
+    const uint32_t rb = ( ( a & 0x00FF00FFu ) * ( 256u - weight ) + ( b & 0x00FF00FFu ) * weight ) >> 8;
+    const uint32_t ag = ( ( ( a >> 8 ) & 0x00FF00FFu ) * ( 256u - weight ) + ( ( b >> 8 ) & 0x00FF00FFu ) * weight ) >> 8;
+    return ( rb & 0x00FF00FFu ) | ( ( ag & 0x00FF00FFu ) << 8 );
+}
+
+//////////////////////////////////////////////////////////////////
+// Returns the part of a coordinate past the integer below it, floats
+//      too large to have a fraction and NaN give zero
+static inline float Fraction( float x ) noexcept
+{
+    if ( !( std::fabs( x ) < 8388608.0f ) )
+        return 0.0f;
+    int whole = static_cast<int>( x );
+    whole -= x < static_cast<float>( whole );
+    return x - static_cast<float>( whole );
+}
+
+//////////////////////////////////////////////////////////////////
+// Averages four texels rounding to nearest, the same two channels
+//      at a time
+static inline uint32_t Average(
+    uint32_t a,
+    uint32_t b,
+    uint32_t c,
+    uint32_t d ) noexcept
+{
+    const uint32_t rb = ( ( a & 0x00FF00FFu ) + ( b & 0x00FF00FFu ) + ( c & 0x00FF00FFu ) + ( d & 0x00FF00FFu ) + 0x00020002u ) >> 2;
+    const uint32_t ag = ( ( ( a >> 8 ) & 0x00FF00FFu ) + ( ( b >> 8 ) & 0x00FF00FFu ) +
+        ( ( c >> 8 ) & 0x00FF00FFu ) + ( ( d >> 8 ) & 0x00FF00FFu ) + 0x00020002u ) >> 2;
+    return ( rb & 0x00FF00FFu ) | ( ( ag & 0x00FF00FFu ) << 8 );
+}
+
+#ifdef GFX_X86
+//////////////////////////////////////////////////////////////////
+// Vector Fraction, the same steps per lane
+GFX_TARGET_AVX2 static inline __m256 FractionAvx2( __m256 x ) noexcept
+{
+    const __m256 small = _mm256_cmp_ps( _mm256_andnot_ps( _mm256_set1_ps( -0.0f ), x ), _mm256_set1_ps( 8388608.0f ), _CMP_LT_OQ );
+    __m256 whole = _mm256_cvtepi32_ps( _mm256_cvttps_epi32( x ) );
+    whole = _mm256_sub_ps( whole, _mm256_and_ps( _mm256_cmp_ps( x, whole, _CMP_LT_OQ ), _mm256_set1_ps( 1.0f ) ) );
+    return _mm256_and_ps( _mm256_sub_ps( x, whole ), small );
+}
+
+//////////////////////////////////////////////////////////////////
+// Gathers 8 texels of a level, repeating the coordinates and 
+//      interleaving their low bits the way the tile offsets do
+GFX_TARGET_AVX2 static inline __m256i FetchAvx2(
+    const uint32_t* texels,
+    __m256i         x,
+    __m256i         y,
+    int             width,
+    int             height,
+    int             tilesPerRow ) noexcept
+{
+    const __m256i one = _mm256_set1_epi32( 1 ), two = _mm256_set1_epi32( 2 );
+    x = _mm256_and_si256( x, _mm256_set1_epi32( width - 1 ) );
+    y = _mm256_and_si256( y, _mm256_set1_epi32( height - 1 ) );
+
+    const __m256i tile = _mm256_add_epi32( _mm256_mullo_epi32( _mm256_srli_epi32( y, 2 ), _mm256_set1_epi32( tilesPerRow ) ), _mm256_srli_epi32( x, 2 ) );
+    const __m256i mortonX = _mm256_or_si256( _mm256_and_si256( x, one ), _mm256_slli_epi32( _mm256_and_si256( x, two ), 1 ) );
+    const __m256i mortonY = _mm256_or_si256( _mm256_slli_epi32( _mm256_and_si256( y, one ), 1 ), _mm256_slli_epi32( _mm256_and_si256( y, two ), 2 ) );
+    const __m256i index = _mm256_add_epi32( _mm256_slli_epi32( tile, 4 ), _mm256_or_si256( mortonX, mortonY ) );
+    return _mm256_i32gather_epi32( reinterpret_cast<const int*>( texels ), index, 4 );
+}
+
+//////////////////////////////////////////////////////////////////
+// Vector Lerp, the same 32 bit products per lane
+GFX_TARGET_AVX2 static inline __m256i LerpAvx2(
+    __m256i a,
+    __m256i b,
+    __m256i weight ) noexcept
+{
+    const __m256i mask = _mm256_set1_epi32( 0x00FF00FF );
+    const __m256i inverse = _mm256_sub_epi32( _mm256_set1_epi32( 256 ), weight );
+    const __m256i rb = _mm256_srli_epi32( _mm256_add_epi32( 
+        _mm256_mullo_epi32( _mm256_and_si256( a, mask ), inverse ), _mm256_mullo_epi32( _mm256_and_si256( b, mask ), weight ) ), 8 );
+    const __m256i ag = _mm256_srli_epi32( _mm256_add_epi32( 
+        _mm256_mullo_epi32( _mm256_and_si256( _mm256_srli_epi32( a, 8 ), mask ), inverse ), 
+        _mm256_mullo_epi32( _mm256_and_si256( _mm256_srli_epi32( b, 8 ), mask ), weight ) ), 8 );
+    return _mm256_or_si256( _mm256_and_si256( rb, mask ), _mm256_slli_epi32( _mm256_and_si256( ag, mask ), 8 ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// Samples 8 neighbouring pixels of a row from one level with 
+//      gathers, every step matches the scalar path to the bit
+GFX_TARGET_AVX2 static void SampleAvx2(
+    uint32_t*             out,
+    int                   x,
+    const float*          row,
+    const TextureMapping& m,
+    const uint32_t*       texels,
+    int                   width,
+    int                   height,
+    int                   tilesPerRow ) noexcept
+{
+    const __m256 dx = _mm256_cvtepi32_ps( _mm256_add_epi32( _mm256_set1_epi32( x - m.x0 ), _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) ) );
+    const __m256 q = _mm256_add_ps( _mm256_set1_ps( row[2] ), _mm256_mul_ps( _mm256_set1_ps( m.q[1] ), dx ) );
+    const __m256 w = _mm256_div_ps( _mm256_set1_ps( 1.0f ), _mm256_max_ps( _mm256_set1_ps( std::numeric_limits<float>::min() ), q ) );
+    const __m256 s = FractionAvx2( _mm256_mul_ps( _mm256_add_ps( _mm256_set1_ps( row[0] ), _mm256_mul_ps( _mm256_set1_ps( m.u[1] ), dx ) ), w ) );
+    const __m256 t = FractionAvx2( _mm256_mul_ps( _mm256_add_ps( _mm256_set1_ps( row[1] ), _mm256_mul_ps( _mm256_set1_ps( m.v[1] ), dx ) ), w ) );
+
+    __m256i color;
+    if ( m.filter == TextureFilter::NEAREST )
+    {
+        const __m256i column = _mm256_cvttps_epi32( _mm256_mul_ps( s, _mm256_set1_ps( static_cast<float>( width ) ) ) );
+        const __m256i line = _mm256_cvttps_epi32( _mm256_mul_ps( t, _mm256_set1_ps( static_cast<float>( height ) ) ) );
+        color = FetchAvx2( texels, column, line, width, height, tilesPerRow );
+    }
+    else
+    {
+        const __m256i half = _mm256_set1_epi32( 128 ), low = _mm256_set1_epi32( 255 ), one = _mm256_set1_epi32( 1 );
+        const __m256i fx = _mm256_sub_epi32( _mm256_cvttps_epi32( _mm256_mul_ps( s, _mm256_set1_ps( static_cast<float>( width * 256 ) ) ) ), half );
+        const __m256i fy = _mm256_sub_epi32( _mm256_cvttps_epi32( _mm256_mul_ps( t, _mm256_set1_ps( static_cast<float>( height * 256 ) ) ) ), half );
+        const __m256i x0 = _mm256_srai_epi32( fx, 8 ), y0 = _mm256_srai_epi32( fy, 8 );
+        const __m256i x1 = _mm256_add_epi32( x0, one ), y1 = _mm256_add_epi32( y0, one );
+        const __m256i wx = _mm256_and_si256( fx, low ), wy = _mm256_and_si256( fy, low );
+
+        const __m256i bottom = LerpAvx2( 
+            FetchAvx2( texels, x0, y0, width, height, tilesPerRow ), FetchAvx2( texels, x1, y0, width, height, tilesPerRow ), wx );
+        const __m256i top = LerpAvx2( 
+            FetchAvx2( texels, x0, y1, width, height, tilesPerRow ), FetchAvx2( texels, x1, y1, width, height, tilesPerRow ), wx );
+        color = LerpAvx2( bottom, top, wy );
+    }
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out ), color );
+}
+#endif
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Texture                                                              */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Copies an image into the tiled layout and builds its
+//          mipmaps
+Texture::Texture(
+    int             width,
+    int             height,
+    const uint32_t* pixels,
+    ptrdiff_t       pitch,
+    bool            mipmaps )
+{
+    assert( width > 0 && ( width & ( width - 1 ) ) == 0 );
+    assert( height > 0 && ( height & ( height - 1 ) ) == 0 );
+
+    // Lay out every level first, partial tiles of the smallest levels are padded
+    size_t offset = 0u;
+    for ( int w = width, h = height; ; w = std::max( w / 2, 1 ), h = std::max( h / 2, 1 ) )
+    {
+        const int tilesPerRow = ( w + tileSize - 1 ) / tileSize, tileRows = ( h + tileSize - 1 ) / tileSize;
+        levels.push_back( { w, h, tilesPerRow, offset } );
+        offset += static_cast<size_t>( tilesPerRow ) * tileRows * tileSize * tileSize;
+        if ( !mipmaps || ( w == 1 && h == 1 ) )
+            break;
+    }
+    texels.resize( offset );
+
+    for ( int y = 0; y < height; ++y )
+    {
+        for ( int x = 0; x < width; ++x )
+        {
+            const uint32_t texel = pixels[y * pitch + x];
+            texels[Index( levels[0], x, y )] = texel;
+            opaque = opaque && ( texel >> 24 ) == 255u;
+        }
+    }
+
+    // Each level averages 2x2 texels of the one above, a side already at one texel averages with itself
+    for ( int level = 1; level < GetLevelCount(); ++level )
+    {
+        const Level& above = levels[level - 1];
+        const Level& current = levels[level];
+        for ( int y = 0; y < current.height; ++y )
+        {
+            for ( int x = 0; x < current.width; ++x )
+            {
+                const int x0 = x * 2, x1 = std::min( x0 + 1, above.width - 1 );
+                const int y0 = y * 2, y1 = std::min( y0 + 1, above.height - 1 );
+                texels[Index( current, x, y )] = Average(
+                    Fetch( above, x0, y0 ), Fetch( above, x1, y0 ), Fetch( above, x0, y1 ), Fetch( above, x1, y1 ) );
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Copies an image into the tiled layout
+Texture::Texture(
+    const ImageView& image,
+    bool             mipmaps )
+    :
+    Texture( image.width, image.height, image.pixels, image.pitch, mipmaps )
+{
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns one texel of a level
+uint32_t Texture::Fetch(
+    int level,
+    int x,
+    int y ) const noexcept
+{
+    return Fetch( levels[level], x, y );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the color of a level at a point
+uint32_t Texture::Sample(
+    int           level,
+    float         u,
+    float         v,
+    TextureFilter filter ) const noexcept
+{
+    return Sample( levels[level], u, v, filter );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the mip level for a footprint
+int Texture::SelectLevel( float footprint ) const noexcept
+{
+    // Rounding log2( sqrt( footprint ) ) is flooring half of log2( 2 * footprint ), which the exponent
+    // gives without a logarithm. Footprints under one texel, zero and NaN all land on the full size
+    const int exponent = std::ilogb( 2.0f * footprint );
+    if ( exponent <= 0 || exponent == FP_ILOGBNAN )
+        return 0;
+    return std::min( exponent / 2, GetLevelCount() - 1 );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the width of the full size level
+int Texture::GetWidth() const noexcept { return levels[0].width; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the height of the full size level
+int Texture::GetHeight() const noexcept { return levels[0].height; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of mip levels
+int Texture::GetLevelCount() const noexcept { return static_cast<int>( levels.size() ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if every texel has full alpha
+bool Texture::IsOpaque() const noexcept { return opaque; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Span shader for textured triangles
+void Texture::Shade(
+    uint32_t*         pixels,
+    const ShadedSpan& span,
+    const void*       mapping ) noexcept
+{
+    const TextureMapping& m = *static_cast<const TextureMapping*>( mapping );
+    const Texture& texture = *m.texture;
+    const float width = static_cast<float>( texture.GetWidth() ), height = static_cast<float>( texture.GetHeight() );
+
+    // Every pixel is evaluated from its own position rather than stepped from the start of the span, so
+    // a span split by tiles samples exactly as it does whole
+    const float dy = static_cast<float>( span.y - m.y0 );
+    const float rowU = m.u[0] + m.u[2] * dy, rowV = m.v[0] + m.v[2] * dy, rowQ = m.q[0] + m.q[2] * dy;
+    auto coordinates = [&]( int x, float& s, float& t, float& w )
+    {
+        const float dx = static_cast<float>( x - m.x0 );
+        w = 1.0f / std::max( rowQ + m.q[1] * dx, std::numeric_limits<float>::min() );
+        s = ( rowU + m.u[1] * dx ) * w;
+        t = ( rowV + m.v[1] * dx ) * w;
+    };
+
+    // The level is picked once per group of pixels aligned on the surface, from the rate the coordinates
+    // change at its first pixel. The derivative of s = U / Q along an axis is ( dU - s * dQ ) / Q
+    constexpr int levelGroup = 8;
+    auto selectLevel = [&]( int x )
+    {
+        float s, t, w;
+        coordinates( x & ~( levelGroup - 1 ), s, t, w );
+        const float sx = ( m.u[1] - s * m.q[1] ) * w * width, tx = ( m.v[1] - t * m.q[1] ) * w * height;
+        const float sy = ( m.u[2] - s * m.q[2] ) * w * width, ty = ( m.v[2] - t * m.q[2] ) * w * height;
+        return &texture.levels[texture.SelectLevel( std::max( sx * sx + tx * tx, sy * sy + ty * ty ) )];
+    };
+
+    // Opaque texels drawn source over go straight to the surface, anything else is blended a chunk at a time.
+    // Chunks end on group boundaries so every whole group can be sampled at once
+    const bool direct = span.blend == BlendMode::SRC_OVER && texture.IsOpaque();
+    const bool vector = Simd::GetLevel() == Simd::Level::AVX2;
+    const float row[3] = { rowU, rowV, rowQ };
+    constexpr int chunk = 64;
+    uint32_t colors[chunk];
+    const int end = span.x + span.count;
+    for ( int x = span.x; x < end; )
+    {
+        const int chunkEnd = std::min( end, ( x & ~( levelGroup - 1 ) ) + chunk );
+        uint32_t* out = direct ? pixels + ( x - span.x ) : colors;
+        for ( int group = x; group < chunkEnd; )
+        {
+            const int groupEnd = std::min( chunkEnd, ( group & ~( levelGroup - 1 ) ) + levelGroup );
+            const Level& level = *selectLevel( group );
+#ifdef GFX_X86
+            if ( vector && groupEnd - group == levelGroup )
+            {
+                SampleAvx2( out + ( group - x ), group, row, m, texture.texels.data() + level.offset, level.width, level.height, level.tilesPerRow );
+                group = groupEnd;
+                continue;
+            }
+#endif
+            for ( ; group < groupEnd; ++group )
+            {
+                float s, t, w;
+                coordinates( group, s, t, w );
+                out[group - x] = texture.Sample( level, s, t, m.filter );
+            }
+        }
+
+        if ( !direct )
+            Blend::Colors( pixels + ( x - span.x ), colors, static_cast<size_t>( chunkEnd - x ), span.blend );
+        x = chunkEnd;
+    }
+}
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] Texture                                                             */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Returns where a texel of a level is stored
+inline size_t Texture::Index(
+    const Level& level,
+    int          x,
+    int          y ) const noexcept
+{
+    // Coordinates are never negative here so the divisions are shifts
+    const unsigned column = static_cast<unsigned>( x ), row = static_cast<unsigned>( y );
+    const size_t tile = static_cast<size_t>( row / tileSize ) * level.tilesPerRow + column / tileSize;
+    return level.offset + tile * ( tileSize * tileSize ) + mortonX[column % tileSize] + mortonY[row % tileSize];
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Returns one texel of a level
+inline uint32_t Texture::Fetch(
+    const Level& level,
+    int          x,
+    int          y ) const noexcept
+{
+    // Sizes are powers of two so masking repeats, negative coordinates included
+    return texels[Index( level, x & ( level.width - 1 ), y & ( level.height - 1 ) )];
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Returns the color of a level at a point
+inline uint32_t Texture::Sample(
+    const Level&  level,
+    float         u,
+    float         v,
+    TextureFilter filter ) const noexcept
+{
+    // Keep only the fraction so coordinates far outside 0 to 1 still convert to small integers
+    u = Fraction( u );
+    v = Fraction( v );
+
+    if ( filter == TextureFilter::NEAREST )
+        return Fetch( level, static_cast<int>( u * level.width ), static_cast<int>( v * level.height ) );
+
+    // Texel centers are half a texel in, weights are 8 bit fractions of the distance past one
+    const int fx = static_cast<int>( u * ( level.width * 256 ) ) - 128;
+    const int fy = static_cast<int>( v * ( level.height * 256 ) ) - 128;
+    const int x = fx >> 8, y = fy >> 8;
+    const uint32_t wx = static_cast<uint32_t>( fx & 255 ), wy = static_cast<uint32_t>( fy & 255 );
+
+    const uint32_t bottom = Lerp( Fetch( level, x, y ), Fetch( level, x + 1, y ), wx );
+    const uint32_t top = Lerp( Fetch( level, x, y + 1 ), Fetch( level, x + 1, y + 1 ), wx );
+    return Lerp( bottom, top, wy );
+}
@@ -0,0 +1,113 @@
+#include "Graphics/TileRenderer.h"
+#include "Graphics/SpanFill.h"
+#include <algorithm>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] TileRenderer                                                         */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Starts the worker pool
+TileRenderer::TileRenderer( unsigned threadCount ) : pool( threadCount ) {}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a clear of the whole surface
+void TileRenderer::Clear( uint32_t color )
+{
+    // Everything recorded so far would be overwritten anyway
+    commands.clear();
+    clearColor = color;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Records a draw call to run on the next flush
+void TileRenderer::Submit( const DrawCommand& command ) { commands.push_back( command ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Bins and rasterizes everything recorded into the 
+//          surface and resets for the next frame
+void TileRenderer::Flush( 
+    Framebuffer& frame,
+    DepthBuffer* depth )
+{
+    if ( commands.empty() && !clearColor )
+        return;
+
+    Bin( frame );
+
+    // Workers pull tiles from a shared counter so uneven tiles balance out
+    nextTile.store( 0, std::memory_order_relaxed );
+    const int tileCount = tilesX * tilesY;
+    pool.Run( [this, &frame, depth, tileCount]( unsigned )
+    {
+        for ( int tile = nextTile.fetch_add( 1 ); tile < tileCount; tile = nextTile.fetch_add( 1 ) )
+            RenderTile( frame, depth, tile );
+    } );
+
+    // Keep the bin capacity around for the next frame
+    commands.clear();
+    clearColor.reset();
+    for ( std::vector<uint32_t>& bin : bins )
+        bin.clear();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of threads rasterizing tiles
+unsigned TileRenderer::GetThreadCount() const noexcept { return pool.GetThreadCount(); }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] TileRenderer                                                        */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Sorts every recorded command into the tiles it 
+//           touches
+void TileRenderer::Bin( const Framebuffer& frame )
+{
+    // Resize the grid if the surface changed
+    tilesX = ( frame.GetWidth() + tileSize - 1 ) / tileSize;
+    tilesY = ( frame.GetHeight() + tileSize - 1 ) / tileSize;
+    bins.resize( static_cast<size_t>( tilesX ) * tilesY );
+
+    const Rect surface( 0, 0, frame.GetWidth(), frame.GetHeight() );
+    for ( size_t i = 0; i < commands.size(); ++i )
+    {
+        // Commands entirely off the surface are dropped here
+        const Rect bounds = commands[i].bounds.Intersect( surface );
+        if ( bounds.IsEmpty() )
+            continue;
+
+        const int tileLeft = bounds.left / tileSize, tileRight = ( bounds.right - 1 ) / tileSize;
+        const int tileBottom = bounds.bottom / tileSize, tileTop = ( bounds.top - 1 ) / tileSize;
+        for ( int ty = tileBottom; ty <= tileTop; ++ty )
+            for ( int tx = tileLeft; tx <= tileRight; ++tx )
+                bins[static_cast<size_t>( ty ) * tilesX + tx].push_back( static_cast<uint32_t>( i ) );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Clears a tile if needed and runs its commands in order
+void TileRenderer::RenderTile(
+    Framebuffer& frame,
+    DepthBuffer* depth,
+    int          tile ) const noexcept
+{
+    const std::vector<uint32_t>& bin = bins[tile];
+    if ( bin.empty() && !clearColor )
+        return;
+
+    const int tx = tile % tilesX, ty = tile / tilesX;
+    const Rect clip( 
+        tx * tileSize, 
+        ty * tileSize, 
+        std::min( ( tx + 1 ) * tileSize, frame.GetWidth() ), 
+        std::min( ( ty + 1 ) * tileSize, frame.GetHeight() ) );
+
+    // Clearing per tile means the tile is already in cache for the commands that follow
+    if ( clearColor )
+        for ( int y = clip.bottom; y < clip.top; ++y )
+            SpanFill::Fill( frame.GetRow( y ) + clip.left, static_cast<size_t>( clip.right - clip.left ), *clearColor );
+
+    for ( uint32_t index : bin )
+        commands[index].Execute( frame, clip, depth );
+}
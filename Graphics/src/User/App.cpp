@@ -6,7 +6,13 @@
 
 //////////////////////////////////////////////////////////////////
 // [PUBLIC] Sets up the application window
-App::App() : wnd( 720, 480, L"Graphics" ) {}
+App::App() : wnd( 720, 480, L"Graphics" )
+{
+    // Geometry that never changes is recorded once and replayed every frame
+    wnd.gfx.BeginDisplayList( scene );
+    wnd.gfx.DrawTriangle( { 200, 200 }, { 300, 400 }, { 350, 150 }, { 0xffffff } );
+    wnd.gfx.EndDisplayList();
+}
 
 //////////////////////////////////////////////////////////////////
 // [PUBLIC] Runs the application loop and returns a termination
@@ -31,5 +37,5 @@ int App::Run()
 // [PRIVATE] Executes all frame logic and updates the window
 void App::Update()
 {
-    wnd.gfx.DrawTriangle( { 200, 200 }, { 300, 400 }, { 350, 150 }, { 0xffffff } );
+    wnd.gfx.DrawDisplayList( scene );
 }
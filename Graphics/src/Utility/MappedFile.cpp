@@ -0,0 +1,82 @@
+#include "Utility/MappedFile.h"
+
+#ifdef _WIN32
+// Only file and memory functions are needed, which Windows/Win.h leaves out
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] MappedFile                                                           */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Maps a file
+MappedFile::MappedFile( const std::filesystem::path& path )
+{
+#ifdef _WIN32
+    // The view keeps the file mapped on its own, so both handles can be closed straight away
+    const HANDLE file = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if ( file == INVALID_HANDLE_VALUE )
+        return;
+
+    LARGE_INTEGER length;
+    if ( GetFileSizeEx( file, &length ) && length.QuadPart > 0 && static_cast<unsigned long long>( length.QuadPart ) <= SIZE_MAX )
+    {
+        if ( const HANDLE mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr ) )
+        {
+            data = static_cast<const uint8_t*>( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+            size = data ? static_cast<size_t>( length.QuadPart ) : 0u;
+            CloseHandle( mapping );
+        }
+    }
+    CloseHandle( file );
+#else
+    const int file = open( path.c_str(), O_RDONLY );
+    if ( file < 0 )
+        return;
+
+    struct stat status;
+    if ( fstat( file, &status ) == 0 && status.st_size > 0 )
+    {
+        void* view = mmap( nullptr, static_cast<size_t>( status.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+        if ( view != MAP_FAILED )
+        {
+            data = static_cast<const uint8_t*>( view );
+            size = static_cast<size_t>( status.st_size );
+        }
+    }
+    close( file );
+#endif
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Unmaps the file
+MappedFile::~MappedFile()
+{
+    if ( !data )
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile( data );
+#else
+    munmap( const_cast<uint8_t*>( data ), size );
+#endif
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the first byte of the file
+const uint8_t* MappedFile::GetData() const noexcept { return data; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the size of the file in bytes
+size_t MappedFile::GetSize() const noexcept { return size; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns true if the file was mapped
+bool MappedFile::IsOpen() const noexcept { return data != nullptr; }
@@ -0,0 +1,72 @@
+#include "Utility/Simd.h"
+#if defined( GFX_X86 ) && defined( _MSC_VER )
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// Start at the best level this processor can run
+std::atomic<Simd::Level> Simd::level = Simd::GetSupportedLevel();
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Simd                                                                 */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the best level supported by this processor
+Simd::Level Simd::GetSupportedLevel() noexcept
+{
+#if defined( GFX_X86 ) && defined( _MSC_VER )
+    // Leaf 7 holds the AVX2 bit, leaf 1 holds OSXSAVE and AVX
+    int info[4];
+    __cpuid( info, 0 );
+    if ( info[0] < 7 )
+        return Level::SSE2;
+
+    __cpuid( info, 1 );
+    const bool osxsave = ( info[2] & ( 1 << 27 ) ) != 0;
+    const bool avx = ( info[2] & ( 1 << 28 ) ) != 0;
+
+    __cpuidex( info, 7, 0 );
+    const bool avx2 = ( info[1] & ( 1 << 5 ) ) != 0;
+
+    // The OS also has to save the upper halves of the ymm registers on context switches
+    if ( osxsave && avx && avx2 && ( _xgetbv( 0 ) & 0x6 ) == 0x6 )
+        return Level::AVX2;
+
+    return Level::SSE2;
+#elif defined( GFX_X86 )
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports( "avx2" ) )
+        return Level::AVX2;
+
+    return Level::SSE2;
+#else
+    return Level::SCALAR;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the level kernels are currently dispatching to
+Simd::Level Simd::GetLevel() noexcept { return level.load( std::memory_order_relaxed ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Forces kernels to a level, clamped to what is 
+//          supported
+void Simd::SetLevel( Level desired ) noexcept
+{
+    const Level supported = GetSupportedLevel();
+    level.store( desired > supported ? supported : desired, std::memory_order_relaxed );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a printable name for a level
+const char* Simd::GetName( Level level ) noexcept
+{
+    switch ( level )
+    {
+    case Level::SCALAR: return "Scalar";
+    case Level::SSE2:   return "SSE2";
+    case Level::AVX2:   return "AVX2";
+    }
+    return "Unknown";
+}
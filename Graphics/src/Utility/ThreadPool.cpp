@@ -0,0 +1,91 @@
+#include "Utility/ThreadPool.h"
+#include <algorithm>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] ThreadPool                                                           */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Starts the worker threads
+ThreadPool::ThreadPool( unsigned threadCount )
+{
+    if ( threadCount == 0u )
+        threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+
+    // The calling thread is index 0, so only the rest need to be created
+    for ( unsigned i = 1u; i < threadCount; ++i )
+        workers.emplace_back( &ThreadPool::WorkerLoop, this, i );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Stops and joins every worker thread
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for ( std::thread& worker : workers )
+        worker.join();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Runs a job once on every thread and returns when all 
+//          of them have finished
+void ThreadPool::Run( const std::function<void( unsigned )>& work )
+{
+    // Publish the job and wake the workers
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        job = &work;
+        pending = static_cast<unsigned>( workers.size() );
+        ++generation;
+    }
+    wake.notify_all();
+
+    // Take our share of the work instead of idling
+    work( 0u );
+
+    // Wait for the stragglers before the job goes out of scope
+    std::unique_lock<std::mutex> lock( mutex );
+    finished.wait( lock, [this] { return pending == 0u; } );
+    job = nullptr;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the total number of threads running each job
+unsigned ThreadPool::GetThreadCount() const noexcept { return static_cast<unsigned>( workers.size() ) + 1u; }
+
+/* ======================================================================================================= */
+/*                           [PRIVATE] ThreadPool                                                          */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PRIVATE] Waits for jobs and runs them until the pool is 
+//           stopped
+void ThreadPool::WorkerLoop( unsigned index )
+{
+    uint64_t seen = 0u;
+    while ( true )
+    {
+        const std::function<void( unsigned )>* current;
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            wake.wait( lock, [this, seen] { return stopping || generation != seen; } );
+            if ( stopping )
+                return;
+
+            seen = generation;
+            current = job;
+        }
+
+        ( *current )( index );
+
+        // The last worker to finish releases the caller
+        std::lock_guard<std::mutex> lock( mutex );
+        if ( --pending == 0u )
+            finished.notify_one();
+    }
+}
@@ -0,0 +1,277 @@
+#include "Utility/Vec2Batch.h"
+#include "Utility/Simd.h"
+#include <cmath>
+#ifdef GFX_X86
+#include <immintrin.h>
+#endif
+
+// The fixed point kernels store x and y of a point as one 64 bit pair
+static_assert( sizeof( Vec2<int> ) == 2 * sizeof( int ), "Vec2<int> must be two packed ints" );
+
+/* ======================================================================================================= */
+/*                           Kernels                                                                       */
+/* ======================================================================================================= */
+
+// Every kernel multiplies and adds in the same order and clamps with the same comparisons as
+// _mm_max_ps and _mm_min_ps, so the levels agree exactly and a NaN clamps to -maxFixed
+
+//////////////////////////////////////////////////////////////////
+// Transforms one point at a time, also finishes the tails
+static void TransformScalar(
+    const Affine2<float>& t,
+    const float*          x,
+    const float*          y,
+    float*                outX,
+    float*                outY,
+    size_t                count ) noexcept
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        const float px = x[i], py = y[i];
+        outX[i] = ( t.xx * px + t.xy * py ) + t.tx;
+        outY[i] = ( t.yx * px + t.yy * py ) + t.ty;
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Converts one transformed coordinate to fixed point
+static inline int ToFixed( float value ) noexcept
+{
+    value = value > -Vec2Batch::maxFixed ? value : -Vec2Batch::maxFixed;
+    value = value < Vec2Batch::maxFixed ? value : Vec2Batch::maxFixed;
+    return static_cast<int>( std::lrint( value ) );
+}
+
+//////////////////////////////////////////////////////////////////
+// Transforms and rounds one point at a time, also finishes the tails
+static void FixedScalar(
+    const Affine2<float>& t,
+    const float*          x,
+    const float*          y,
+    Vec2<int>*            out,
+    size_t                count ) noexcept
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        const float px = x[i], py = y[i];
+        out[i].x = ToFixed( ( t.xx * px + t.xy * py ) + t.tx );
+        out[i].y = ToFixed( ( t.yx * px + t.yy * py ) + t.ty );
+    }
+}
+
+#ifdef GFX_X86
+//////////////////////////////////////////////////////////////////
+// Transforms 4 points per iteration
+static void TransformSse2(
+    const Affine2<float>& t,
+    const float*          x,
+    const float*          y,
+    float*                outX,
+    float*                outY,
+    size_t                count ) noexcept
+{
+    const __m128 xx = _mm_set1_ps( t.xx ), xy = _mm_set1_ps( t.xy ), tx = _mm_set1_ps( t.tx );
+    const __m128 yx = _mm_set1_ps( t.yx ), yy = _mm_set1_ps( t.yy ), ty = _mm_set1_ps( t.ty );
+    size_t i = 0;
+    for ( ; i + 4u <= count; i += 4u )
+    {
+        const __m128 px = _mm_loadu_ps( x + i ), py = _mm_loadu_ps( y + i );
+        _mm_storeu_ps( outX + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( xx, px ), _mm_mul_ps( xy, py ) ), tx ) );
+        _mm_storeu_ps( outY + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( yx, px ), _mm_mul_ps( yy, py ) ), ty ) );
+    }
+    TransformScalar( t, x + i, y + i, outX + i, outY + i, count - i );
+}
+
+//////////////////////////////////////////////////////////////////
+// Transforms and rounds 4 points per iteration, interleaving x and y
+//      as they are stored
+static void FixedSse2(
+    const Affine2<float>& t,
+    const float*          x,
+    const float*          y,
+    Vec2<int>*            out,
+    size_t                count ) noexcept
+{
+    const __m128 xx = _mm_set1_ps( t.xx ), xy = _mm_set1_ps( t.xy ), tx = _mm_set1_ps( t.tx );
+    const __m128 yx = _mm_set1_ps( t.yx ), yy = _mm_set1_ps( t.yy ), ty = _mm_set1_ps( t.ty );
+    const __m128 lo = _mm_set1_ps( -Vec2Batch::maxFixed ), hi = _mm_set1_ps( Vec2Batch::maxFixed );
+    size_t i = 0;
+    for ( ; i + 4u <= count; i += 4u )
+    {
+        const __m128 px = _mm_loadu_ps( x + i ), py = _mm_loadu_ps( y + i );
+        const __m128 fx = _mm_add_ps( _mm_add_ps( _mm_mul_ps( xx, px ), _mm_mul_ps( xy, py ) ), tx );
+        const __m128 fy = _mm_add_ps( _mm_add_ps( _mm_mul_ps( yx, px ), _mm_mul_ps( yy, py ) ), ty );
+        const __m128i ix = _mm_cvtps_epi32( _mm_min_ps( _mm_max_ps( fx, lo ), hi ) );
+        const __m128i iy = _mm_cvtps_epi32( _mm_min_ps( _mm_max_ps( fy, lo ), hi ) );
+        __m128i* dst = reinterpret_cast<__m128i*>( out + i );
+        _mm_storeu_si128( dst + 0, _mm_unpacklo_epi32( ix, iy ) );
+        _mm_storeu_si128( dst + 1, _mm_unpackhi_epi32( ix, iy ) );
+    }
+    FixedScalar( t, x + i, y + i, out + i, count - i );
+}
+
+//////////////////////////////////////////////////////////////////
+// Transforms 8 points per iteration
+GFX_TARGET_AVX2 static void TransformAvx2(
+    const Affine2<float>& t,
+    const float*          x,
+    const float*          y,
+    float*                outX,
+    float*                outY,
+    size_t                count ) noexcept
+{
+    const __m256 xx = _mm256_set1_ps( t.xx ), xy = _mm256_set1_ps( t.xy ), tx = _mm256_set1_ps( t.tx );
+    const __m256 yx = _mm256_set1_ps( t.yx ), yy = _mm256_set1_ps( t.yy ), ty = _mm256_set1_ps( t.ty );
+    size_t i = 0;
+    for ( ; i + 8u <= count; i += 8u )
+    {
+        const __m256 px = _mm256_loadu_ps( x + i ), py = _mm256_loadu_ps( y + i );
+        _mm256_storeu_ps( outX + i, _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( xx, px ), _mm256_mul_ps( xy, py ) ), tx ) );
+        _mm256_storeu_ps( outY + i, _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( yx, px ), _mm256_mul_ps( yy, py ) ), ty ) );
+    }
+    TransformSse2( t, x + i, y + i, outX + i, outY + i, count - i );
+}
+
+//////////////////////////////////////////////////////////////////
+// Transforms and rounds 8 points per iteration, interleaving x and y
+//      as they are stored
+GFX_TARGET_AVX2 static void FixedAvx2(
+    const Affine2<float>& t,
+    const float*          x,
+    const float*          y,
+    Vec2<int>*            out,
+    size_t                count ) noexcept
+{
+    const __m256 xx = _mm256_set1_ps( t.xx ), xy = _mm256_set1_ps( t.xy ), tx = _mm256_set1_ps( t.tx );
+    const __m256 yx = _mm256_set1_ps( t.yx ), yy = _mm256_set1_ps( t.yy ), ty = _mm256_set1_ps( t.ty );
+    const __m256 lo = _mm256_set1_ps( -Vec2Batch::maxFixed ), hi = _mm256_set1_ps( Vec2Batch::maxFixed );
+    size_t i = 0;
+    for ( ; i + 8u <= count; i += 8u )
+    {
+        const __m256 px = _mm256_loadu_ps( x + i ), py = _mm256_loadu_ps( y + i );
+        const __m256 fx = _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( xx, px ), _mm256_mul_ps( xy, py ) ), tx );
+        const __m256 fy = _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( yx, px ), _mm256_mul_ps( yy, py ) ), ty );
+        const __m256i ix = _mm256_cvtps_epi32( _mm256_min_ps( _mm256_max_ps( fx, lo ), hi ) );
+        const __m256i iy = _mm256_cvtps_epi32( _mm256_min_ps( _mm256_max_ps( fy, lo ), hi ) );
+
+        // Unpacking works within each 128 bit half, points 0 1 4 5 and 2 3 6 7, so swap the middle halves
+        const __m256i low = _mm256_unpacklo_epi32( ix, iy ), high = _mm256_unpackhi_epi32( ix, iy );
+        __m256i* dst = reinterpret_cast<__m256i*>( out + i );
+        _mm256_storeu_si256( dst + 0, _mm256_permute2x128_si256( low, high, 0x20 ) );
+        _mm256_storeu_si256( dst + 1, _mm256_permute2x128_si256( low, high, 0x31 ) );
+    }
+    FixedSse2( t, x + i, y + i, out + i, count - i );
+}
+#endif
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Vec2Batch                                                            */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Constructs a batch holding a copy of some points
+Vec2Batch::Vec2Batch(
+    const Vec2<float>* points,
+    size_t             count )
+{
+    Assign( points, count );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Replaces the points with a copy of others
+void Vec2Batch::Assign(
+    const Vec2<float>* points,
+    size_t             count )
+{
+    xs.resize( count );
+    ys.resize( count );
+    for ( size_t i = 0; i < count; ++i )
+    {
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Changes the number of points
+void Vec2Batch::Resize( size_t count )
+{
+    xs.resize( count, 0.0f );
+    ys.resize( count, 0.0f );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Sets one point
+void Vec2Batch::Set(
+    size_t             i,
+    const Vec2<float>& point ) noexcept
+{
+    xs[i] = point.x;
+    ys[i] = point.y;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns one point
+Vec2<float> Vec2Batch::Get( size_t i ) const noexcept { return Vec2<float>( xs[i], ys[i] ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Writes every point moved by a transform to a batch
+void Vec2Batch::Transform(
+    const Affine2<float>& transform,
+    Vec2Batch&            out ) const
+{
+    const size_t count = GetSize();
+    out.Resize( count );
+
+#ifdef GFX_X86
+    switch ( Simd::GetLevel() )
+    {
+    case Simd::Level::AVX2: return TransformAvx2( transform, xs.data(), ys.data(), out.xs.data(), out.ys.data(), count );
+    case Simd::Level::SSE2: return TransformSse2( transform, xs.data(), ys.data(), out.xs.data(), out.ys.data(), count );
+    default: break;
+    }
+#endif
+    TransformScalar( transform, xs.data(), ys.data(), out.xs.data(), out.ys.data(), count );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Writes every point moved by a transform in fixed point
+void Vec2Batch::TransformToFixed(
+    const Affine2<float>& transform,
+    int                   fractionBits,
+    Vec2<int>*            out ) const noexcept
+{
+    // Scaling by a power of two is exact, so it folds into the transform without changing any result
+    const Affine2<float> scaled = Affine2<float>::Scale( std::ldexp( 1.0f, fractionBits ), std::ldexp( 1.0f, fractionBits ) ) * transform;
+    const size_t count = GetSize();
+
+#ifdef GFX_X86
+    switch ( Simd::GetLevel() )
+    {
+    case Simd::Level::AVX2: return FixedAvx2( scaled, xs.data(), ys.data(), out, count );
+    case Simd::Level::SSE2: return FixedSse2( scaled, xs.data(), ys.data(), out, count );
+    default: break;
+    }
+#endif
+    FixedScalar( scaled, xs.data(), ys.data(), out, count );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns every x
+float* Vec2Batch::GetX() noexcept { return xs.data(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns every x
+const float* Vec2Batch::GetX() const noexcept { return xs.data(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns every y
+float* Vec2Batch::GetY() noexcept { return ys.data(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns every y
+const float* Vec2Batch::GetY() const noexcept { return ys.data(); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of points
+size_t Vec2Batch::GetSize() const noexcept { return xs.size(); }
@@ -0,0 +1,81 @@
+#include "Windows/GdiPresenter.h"
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] GdiPresenter                                                         */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Acquires the device context of a window
+GdiPresenter::GdiPresenter( HWND hWindow )
+    :
+    hWnd( hWindow ),
+    hdc( GetDC( hWindow ) )
+{
+    // Initialize values for the bitmap so it can be passed as our new frame each loop
+    bitmap.bmiHeader.biSize = sizeof( bitmap.bmiHeader );		// Number of bytes required by the struct (not including color table)
+    bitmap.bmiHeader.biPlanes = 1;								// Must be set to 1 (says that the data is ordered in memory?)
+    bitmap.bmiHeader.biBitCount = sizeof( uint32_t ) * 8;	    // Number of bits per pixel (num bytes per pixel * num bits in a byte)
+    bitmap.bmiHeader.biCompression = BI_RGB;					// Compression type (ours is uncompressed RGB values)
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Releases the device context
+GdiPresenter::~GdiPresenter() { ReleaseDC( hWnd, hdc ); }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws the frame to the window with StretchDIBits
+void GdiPresenter::Present( const Framebuffer& frame )
+{
+    // Rows are padded, so the bitmap is as wide as the pitch and we only copy the visible width
+    bitmap.bmiHeader.biWidth = frame.GetPitch();				// Width of the bitmap in pixels (i.e. the padded row length)
+    bitmap.bmiHeader.biHeight = frame.GetHeight();				// Height of the bitmap in pixels (i.e. the height of our window)
+
+    // Method that takes in a device independent bitmap and draws it to the screen
+    StretchDIBits(
+        hdc,				    // Handle to destination (window)
+        0,					    // Upper left x coordinate of destination (window)
+        0,					    // Upper left y coordinate of destination (window)
+        frame.GetWidth(),	    // Width of destination (window)
+        frame.GetHeight(),	    // Height of destination (window)
+        0,					    // Upper left x coordinate of source (bitmap)
+        0,					    // Upper left y coordinate of source (bitmap)
+        frame.GetWidth(),	    // Width of source (bitmap)
+        frame.GetHeight(),	    // Height of source (bitmap)
+        frame.GetPixels(),	    // Pointer to the framebuffer's pixel memory
+        &bitmap,			    // The bitmap we created and will display to screen
+        DIB_RGB_COLORS,		    // Tells the function that we are using RGB values
+        SRCCOPY				    // Directly copy the source to destination, no funny business
+    );
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Draws only the changed regions of the frame to the 
+//          window
+void GdiPresenter::PresentRegion(
+    const Framebuffer&       frame,
+    const std::vector<Rect>& rects )
+{
+    bitmap.bmiHeader.biWidth = frame.GetPitch();
+    bitmap.bmiHeader.biHeight = frame.GetHeight();
+
+    for ( const Rect& rect : rects )
+    {
+        // Source rows count up from the bottom of the bitmap but the window counts down from the top
+        const int width = rect.right - rect.left, height = rect.top - rect.bottom;
+        StretchDIBits(
+            hdc,
+            rect.left,
+            frame.GetHeight() - rect.top,
+            width,
+            height,
+            rect.left,
+            rect.bottom,
+            width,
+            height,
+            frame.GetPixels(),
+            &bitmap,
+            DIB_RGB_COLORS,
+            SRCCOPY
+        );
+    }
+}
@@ -1,4 +1,5 @@
 #include "Windows/Window.h"
+#include "Windows/GdiPresenter.h"
 #include <sstream>
 #include <cassert>
 
@@ -169,9 +170,16 @@ Window::Window(
     if ( hWnd == nullptr )
         throw WND_LAST_EXCEPT();
 
-    // Create a graphics object on this window
+    // Find the actual size of the client area we will be drawing to
+    RECT client;
+    GetClientRect( hWnd, &client );
+
+    // Create a graphics object presenting to this window
     // TEMPORARY FIX UNTIL GRAPHICS REFACTOR
-    gfx = Graphics( hWnd );
+    gfx = Graphics( 
+        client.right - client.left, 
+        client.bottom - client.top, 
+        std::make_unique<GdiPresenter>( hWnd ) );
 
     // Show the window
     ShowWindow( hWnd, SW_SHOWDEFAULT );
@@ -294,6 +302,12 @@ LRESULT Window::HandleMsg(
             }
             break;
         }
+        // Part of the window was uncovered, the next frame can't rely on what was presented before
+        case WM_PAINT:
+        {
+            gfx.Invalidate();
+            break;
+        }
         // Close the window cleanly
         case WM_CLOSE:
         {
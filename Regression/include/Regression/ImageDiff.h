@@ -0,0 +1,51 @@
+#pragma once
+#include "Graphics/ImageView.h"
+#include "Utility/Rect.h"
+#include <vector>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// @brief The pixels that differ between a rendered image and its
+//      reference, and how much each of them differs by
+class ImageDiff
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Compares two images, if their sizes differ every pixel
+    //      counts as different
+    //
+    // @param actual: the image just rendered
+    // @param expected: the stored reference
+    ImageDiff(
+        const ImageView& actual,
+        const ImageView& expected );
+
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns a picture of the differences the size of the
+    //      reference, matching pixels are the reference darkened and
+    //      differing ones glow from red to white by how much they differ
+    std::vector<uint32_t> MakeHeatmap() const;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the number of pixels that differ
+    uint64_t GetPixelCount() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the largest difference of any channel of any pixel
+    int GetMaxDifference() const noexcept;
+
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns the smallest rectangle holding every pixel that
+    //      differs, empty if none do
+    const Rect& GetBounds() const noexcept;
+
+private:
+    ImageView expected;
+
+    // Largest channel difference of each pixel of the reference
+    std::vector<uint8_t> differences;
+    uint64_t pixelCount = 0u;
+    int maxDifference = 0;
+    Rect bounds;
+};
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include "Graphics/Graphics.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////
+// @brief A small picture drawn the same way on every run and
+//      compared pixel for pixel against its stored reference
+struct Scene
+{
+    std::string name;
+    int width;
+    int height;
+    std::function<void( Graphics& )> draw;
+};
+
+//////////////////////////////////////////////////////////////////
+// @brief The corpus of scenes, the edge cases of rectangles,
+//      triangles and lines that an optimized kernel is most likely
+//      to get wrong. Scenes only use the integer paths of the
+//      rasterizers, and float math whose rounding is fixed by IEEE, so
+//      their references hold for every compiler
+class Scenes
+{
+public:
+    //////////////////////////////////////////////////////////////////
+    // @brief Returns every scene, names are unique and usable as file
+    //      names
+    static std::vector<Scene> GetAll();
+};
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "Regression/ImageDiff.h"
+#include <algorithm>
+#include <cstdlib>
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] ImageDiff                                                            */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Compares two images
+ImageDiff::ImageDiff(
+    const ImageView& actual,
+    const ImageView& expected )
+    :
+    expected( expected ),
+    differences( static_cast<size_t>( std::max( expected.width, 0 ) ) * std::max( expected.height, 0 ), 0u )
+{
+    // An image of the wrong size is wrong everywhere
+    if ( actual.width != expected.width || actual.height != expected.height )
+    {
+        std::fill( differences.begin(), differences.end(), uint8_t( 255u ) );
+        pixelCount = static_cast<uint64_t>( std::max( actual.width * actual.height, expected.width * expected.height ) );
+        maxDifference = 255;
+        bounds = Rect( 0, 0, std::max( actual.width, expected.width ), std::max( actual.height, expected.height ) );
+        return;
+    }
+
+    bounds = Rect( expected.width, expected.height, 0, 0 );
+    for ( int y = 0; y < expected.height; ++y )
+    {
+        const uint32_t* got = actual.GetRow( y );
+        const uint32_t* want = expected.GetRow( y );
+        for ( int x = 0; x < expected.width; ++x )
+        {
+            if ( got[x] == want[x] )
+                continue;
+
+            int difference = 0;
+            for ( int shift = 0; shift < 32; shift += 8 )
+                difference = std::max( difference, std::abs( static_cast<int>( ( got[x] >> shift ) & 0xFFu ) - static_cast<int>( ( want[x] >> shift ) & 0xFFu ) ) );
+            differences[static_cast<size_t>( y ) * expected.width + x] = static_cast<uint8_t>( difference );
+            ++pixelCount;
+            maxDifference = std::max( maxDifference, difference );
+            bounds = Rect( std::min( bounds.left, x ), std::min( bounds.bottom, y ), std::max( bounds.right, x + 1 ), std::max( bounds.top, y + 1 ) );
+        }
+    }
+    if ( pixelCount == 0u )
+        bounds = Rect();
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns a picture of the differences
+std::vector<uint32_t> ImageDiff::MakeHeatmap() const
+{
+    std::vector<uint32_t> heatmap( differences.size() );
+    for ( int y = 0; y < expected.height; ++y )
+    {
+        for ( int x = 0; x < expected.width; ++x )
+        {
+            const size_t i = static_cast<size_t>( y ) * expected.width + x;
+            const uint32_t difference = differences[i];
+            if ( difference == 0u )
+                heatmap[i] = 0xFF000000u | ( ( expected.GetRow( y )[x] >> 2 ) & 0x3F3F3Fu );
+            else
+                heatmap[i] = 0xFFFF0000u | ( difference << 8 ) | difference;
+        }
+    }
+    return heatmap;
+}
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the number of pixels that differ
+uint64_t ImageDiff::GetPixelCount() const noexcept { return pixelCount; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the largest difference of any channel
+int ImageDiff::GetMaxDifference() const noexcept { return maxDifference; }
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns the smallest rectangle holding every difference
+const Rect& ImageDiff::GetBounds() const noexcept { return bounds; }
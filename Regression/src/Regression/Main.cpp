@@ -0,0 +1,233 @@
+#include "Regression/ImageDiff.h"
+#include "Regression/Scenes.h"
+#include "Graphics/Graphics.h"
+#include "Graphics/Image.h"
+#include "Utility/Simd.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////
+// Options read from the command line
+struct Options
+{
+    std::filesystem::path referenceDir = "references";
+    std::filesystem::path outputDir = "regression-out";
+    std::string filter;
+    unsigned threads = 4u;
+    bool update = false;
+};
+
+//////////////////////////////////////////////////////////////////
+// Ways a scene is drawn, every one of them must match the reference
+enum class Mode { IMMEDIATE, DEFERRED, DISPLAY_LIST };
+
+//////////////////////////////////////////////////////////////////
+// Prints the command line options
+static void PrintUsage()
+{
+    std::printf(
+        "Usage: Regression [options]\n"
+        "  --references <dir>  directory of reference images (default references)\n"
+        "  --output <dir>      where images of failures are written (default regression-out)\n"
+        "  --filter <text>     only run scenes whose name contains text\n"
+        "  --threads <n>       threads of the deferred renderer, 0 for all (default 4)\n"
+        "  --update            rewrite the references from the scalar immediate renderer\n" );
+}
+
+//////////////////////////////////////////////////////////////////
+// Reads the command line, returns false if it can't be understood
+static bool ParseOptions(
+    int      argc,
+    char**   argv,
+    Options& options )
+{
+    for ( int i = 1; i < argc; ++i )
+    {
+        const bool hasValue = i + 1 < argc;
+        if ( !std::strcmp( argv[i], "--references" ) && hasValue )
+            options.referenceDir = argv[++i];
+        else if ( !std::strcmp( argv[i], "--output" ) && hasValue )
+            options.outputDir = argv[++i];
+        else if ( !std::strcmp( argv[i], "--filter" ) && hasValue )
+            options.filter = argv[++i];
+        else if ( !std::strcmp( argv[i], "--threads" ) && hasValue )
+            options.threads = static_cast<unsigned>( std::atoi( argv[++i] ) );
+        else if ( !std::strcmp( argv[i], "--update" ) )
+            options.update = true;
+        else
+            return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// Returns every SIMD level this processor can run
+static std::vector<Simd::Level> GetLevels()
+{
+    std::vector<Simd::Level> levels;
+    for ( Simd::Level level : { Simd::Level::SCALAR, Simd::Level::SSE2, Simd::Level::AVX2 } )
+        if ( level <= Simd::GetSupportedLevel() )
+            levels.push_back( level );
+    return levels;
+}
+
+//////////////////////////////////////////////////////////////////
+// Returns a printable name for a mode
+static const char* GetName( Mode mode )
+{
+    switch ( mode )
+    {
+    case Mode::DEFERRED:     return "deferred";
+    case Mode::DISPLAY_LIST: return "display-list";
+    default:                 return "immediate";
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Draws a scene on a fresh surface and returns its pixels packed
+//      without row padding. Display lists are replayed twice so the
+//      second replay fills the runs cached by the first
+static std::vector<uint32_t> Render(
+    const Scene& scene,
+    Mode         mode,
+    unsigned     threads )
+{
+    DisplayList list;
+    const int replays = mode == Mode::DISPLAY_LIST ? 2 : 1;
+    std::vector<uint32_t> pixels;
+    for ( int replay = 0; replay < replays; ++replay )
+    {
+        Graphics gfx( scene.width, scene.height, nullptr );
+        if ( mode == Mode::DEFERRED )
+            gfx.EnableDeferred( threads );
+
+        if ( mode != Mode::DISPLAY_LIST )
+            scene.draw( gfx );
+        else
+        {
+            if ( replay == 0 )
+            {
+                gfx.BeginDisplayList( list );
+                scene.draw( gfx );
+                gfx.EndDisplayList();
+            }
+            gfx.DrawDisplayList( list );
+        }
+        gfx.Flush();
+
+        const Framebuffer& frame = std::as_const( gfx ).GetFramebuffer();
+        pixels.resize( static_cast<size_t>( scene.width ) * scene.height );
+        for ( int y = 0; y < scene.height; ++y )
+            std::memcpy( pixels.data() + static_cast<size_t>( y ) * scene.width, frame.GetRow( y ), scene.width * sizeof( uint32_t ) );
+    }
+    return pixels;
+}
+
+int main(
+    int    argc,
+    char** argv )
+{
+    Options options;
+    if ( !ParseOptions( argc, argv, options ) )
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::printf( "Supported SIMD level: %s\n", Simd::GetName( Simd::GetSupportedLevel() ) );
+    const Simd::Level startLevel = Simd::GetLevel();
+
+    std::error_code error;
+    std::filesystem::create_directories( options.update ? options.referenceDir : options.outputDir, error );
+
+    int scenes = 0, compared = 0, failed = 0, missing = 0;
+    for ( const Scene& scene : Scenes::GetAll() )
+    {
+        if ( scene.name.find( options.filter ) == std::string::npos )
+            continue;
+        ++scenes;
+
+        // References come from the simplest path, every other path must agree with it exactly
+        const std::filesystem::path referencePath = options.referenceDir / ( scene.name + ".qoi" );
+        if ( options.update )
+        {
+            Simd::SetLevel( Simd::Level::SCALAR );
+            const std::vector<uint32_t> pixels = Render( scene, Mode::IMMEDIATE, options.threads );
+            try
+            {
+                Image::Save( ImageView( pixels.data(), scene.width, scene.height, scene.width ), referencePath );
+                std::printf( "%-32s updated\n", scene.name.c_str() );
+            }
+            catch ( const std::exception& e )
+            {
+                std::printf( "%s\n", e.what() );
+                ++failed;
+            }
+            continue;
+        }
+
+        Image reference;
+        try
+        {
+            reference = Image::Load( referencePath );
+        }
+        catch ( const std::exception& )
+        {
+            std::printf( "%-32s missing reference %s\n", scene.name.c_str(), referencePath.string().c_str() );
+            ++missing;
+            continue;
+        }
+
+        for ( Simd::Level level : GetLevels() )
+        {
+            Simd::SetLevel( level );
+            for ( Mode mode : { Mode::IMMEDIATE, Mode::DEFERRED, Mode::DISPLAY_LIST } )
+            {
+                const std::vector<uint32_t> pixels = Render( scene, mode, options.threads );
+                const ImageView actual( pixels.data(), scene.width, scene.height, scene.width );
+                const ImageDiff diff( actual, reference.GetView() );
+                const std::string variant = std::string( Simd::GetName( level ) ) + "-" + GetName( mode );
+                ++compared;
+                if ( diff.GetPixelCount() == 0u )
+                {
+                    std::printf( "%-32s %-20s ok\n", scene.name.c_str(), variant.c_str() );
+                    continue;
+                }
+
+                ++failed;
+                const Rect& bounds = diff.GetBounds();
+                std::printf( "%-32s %-20s FAILED %llu pixels differ by up to %d in (%d, %d) to (%d, %d)\n",
+                    scene.name.c_str(), variant.c_str(), static_cast<unsigned long long>( diff.GetPixelCount() ), diff.GetMaxDifference(),
+                    bounds.left, bounds.bottom, bounds.right, bounds.top );
+
+                // The rendering and a heatmap over the reference show where and by how much it went wrong
+                const std::vector<uint32_t> heatmap = diff.MakeHeatmap();
+                const ImageView& expected = reference.GetView();
+                const std::filesystem::path stem = options.outputDir / ( scene.name + "-" + variant );
+                try
+                {
+                    Image::Save( actual, stem.string() + ".bmp" );
+                    if ( !heatmap.empty() )
+                        Image::Save( ImageView( heatmap.data(), expected.width, expected.height, expected.width ), stem.string() + "-heatmap.bmp" );
+                }
+                catch ( const std::exception& e )
+                {
+                    std::printf( "%s\n", e.what() );
+                }
+            }
+        }
+    }
+    Simd::SetLevel( startLevel );
+
+    if ( options.update )
+        std::printf( "\n%d references written to %s\n", scenes - failed, options.referenceDir.string().c_str() );
+    else
+        std::printf( "\n%d scenes, %d comparisons, %d failed, %d missing references\n", scenes, compared, failed, missing );
+    return failed > 0 || missing > 0 ? 1 : 0;
+}
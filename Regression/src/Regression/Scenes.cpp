@@ -0,0 +1,334 @@
+#include "Regression/Scenes.h"
+#include "Graphics/Sprite.h"
+#include <climits>
+#include <cmath>
+#include <utility>
+
+// Every scene is small so the whole corpus renders in a moment at every variant
+static constexpr int sceneWidth = 96;
+static constexpr int sceneHeight = 64;
+
+// Size of the image drawn by the image and sprite scenes
+static constexpr int markedWidth = 12;
+static constexpr int markedHeight = 9;
+
+//////////////////////////////////////////////////////////////////
+// Adds a triangle scene once for each triangle rasterizer, they are
+//      meant to fill exactly the same pixels
+static void AddTriangleScene(
+    std::vector<Scene>&                     scenes,
+    const std::string&                      name,
+    const std::function<void( Graphics& )>& draw )
+{
+    for ( Graphics::TriangleRasterizer rasterizer : { Graphics::TriangleRasterizer::SCANLINE, Graphics::TriangleRasterizer::HALFSPACE } )
+    {
+        const bool scanline = rasterizer == Graphics::TriangleRasterizer::SCANLINE;
+        scenes.push_back( { name + ( scanline ? "-scanline" : "-halfspace" ), sceneWidth, sceneHeight, [rasterizer, draw]( Graphics& gfx )
+        {
+            gfx.SetTriangleRasterizer( rasterizer );
+            draw( gfx );
+        } } );
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Returns the pixels of a small image whose rows all differ, red at
+//      the top fading to blue at the bottom with a white pixel in the
+//      top left corner, so a flipped or shifted copy is caught. The
+//      pixels right of the middle of every other row are transparent
+static const std::vector<uint32_t>& GetMarkedImage()
+{
+    static const std::vector<uint32_t> pixels = []
+    {
+        std::vector<uint32_t> image( static_cast<size_t>( markedWidth ) * markedHeight );
+        for ( int y = 0; y < markedHeight; ++y )
+        {
+            for ( int x = 0; x < markedWidth; ++x )
+            {
+                const uint32_t red = 255u - y * 255u / ( markedHeight - 1 ), blue = y * 255u / ( markedHeight - 1 );
+                const uint32_t alpha = ( y % 2 == 1 && x >= markedWidth / 2 ) ? 0u : 255u;
+                image[static_cast<size_t>( y ) * markedWidth + x] = ( alpha << 24 ) | ( red << 16 ) | ( x * 16u << 8 ) | blue;
+            }
+        }
+        image[0] = 0xFFFFFFFFu;
+        return image;
+    }();
+    return pixels;
+}
+
+/* ======================================================================================================= */
+/*                           [PUBLIC] Scenes                                                               */
+/* ======================================================================================================= */
+
+//////////////////////////////////////////////////////////////////
+// [PUBLIC] Returns every scene
+std::vector<Scene> Scenes::GetAll()
+{
+    std::vector<Scene> scenes;
+
+    // Corners in either order, single pixels, empty rectangles and rectangles hanging off every edge
+    scenes.push_back( { "rectangle-edges", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        gfx.DrawRectangle( { 4, 4 }, { 20, 14 }, Color( 0xE04040 ) );
+        gfx.DrawRectangle( { 40, 14 }, { 24, 4 }, Color( 0x40E040 ) );
+        gfx.DrawRectangle( { 56, 12 }, { 57, 13 }, Color( 0xFFFFFF ) );
+        gfx.DrawRectangle( { 48, 4 }, { 48, 14 }, Color( 0xFFFF00 ) );
+        gfx.DrawRectangle( { 52, 9 }, { 70, 9 }, Color( 0xFFFF00 ) );
+        gfx.DrawRectangle( { -10, 20 }, { 8, 30 }, Color( 0x4040E0 ) );
+        gfx.DrawRectangle( { 88, 20 }, { 120, 30 }, Color( 0x40E0E0 ) );
+        gfx.DrawRectangle( { 30, -8 }, { 50, 6 }, Color( 0xE040E0 ) );
+        gfx.DrawRectangle( { 30, 58 }, { 50, 90 }, Color( 0xE0E040 ) );
+        gfx.DrawRectangle( { -100, -100 }, { -50, -50 }, Color( 0xFFFFFF ) );
+        gfx.DrawRectangle( { 200, 200 }, { 300, 300 }, Color( 0xFFFFFF ) );
+        gfx.DrawRectangle( { -1000, 40 }, { 1000, 42 }, Color( 0x808080 ) );
+    } } );
+
+    // Translucent rectangles that share edges darken where they overlap and leave gaps where they miss
+    scenes.push_back( { "rectangle-shared-edges", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        for ( int y = 0; y < 5; ++y )
+            for ( int x = 0; x < 8; ++x )
+                gfx.DrawRectangle( { 4 + x * 11, 4 + y * 11 }, { 15 + x * 11, 15 + y * 11 }, Color( 0x40A0FF, 128 ) );
+    } } );
+
+    // Flat tops and flat bottoms are the dy == 0 path of the scanline rasterizer
+    AddTriangleScene( scenes, "triangle-flat", []( Graphics& gfx )
+    {
+        gfx.DrawTriangle( { 4, 4 }, { 28, 4 }, { 16, 28 }, Color( 0xE04040 ) );
+        gfx.DrawTriangle( { 34, 28 }, { 58, 28 }, { 46, 4 }, Color( 0x40E040 ) );
+        gfx.DrawTriangle( { 64, 4 }, { 92, 4 }, { 92, 28 }, Color( 0x4040E0 ) );
+        gfx.DrawTriangle( { 4, 60 }, { 4, 34 }, { 30, 60 }, Color( 0xE0E040 ) );
+        gfx.DrawTriangle( { 40, 34 }, { 41, 34 }, { 40, 60 }, Color( 0xE040E0 ) );
+        gfx.DrawTriangle( { 50, 40 }, { 90, 40 }, { 70, 41 }, Color( 0x40E0E0 ) );
+    } );
+
+    // Repeated and collinear vertices have no area and must draw nothing
+    AddTriangleScene( scenes, "triangle-degenerate", []( Graphics& gfx )
+    {
+        gfx.DrawTriangle( { 10, 10 }, { 10, 10 }, { 10, 10 }, Color( 0xFFFFFF ) );
+        gfx.DrawTriangle( { 20, 10 }, { 20, 10 }, { 40, 30 }, Color( 0xFFFFFF ) );
+        gfx.DrawTriangle( { 50, 10 }, { 70, 30 }, { 60, 20 }, Color( 0xFFFFFF ) );
+        gfx.DrawTriangle( { 10, 40 }, { 40, 40 }, { 80, 40 }, Color( 0xFFFFFF ) );
+        gfx.DrawTriangle( { 85, 5 }, { 85, 30 }, { 85, 60 }, Color( 0xFFFFFF ) );
+        gfx.DrawTriangle( { 20, 50 }, { 60, 52 }, { 20, 50 }, Color( 0xFFFFFF ) );
+    } );
+
+    // The same triangles wound both ways, clockwise and counter clockwise fill the same pixels
+    AddTriangleScene( scenes, "triangle-winding", []( Graphics& gfx )
+    {
+        const Vec2<int> corners[] = { { 3, 5 }, { 41, 11 }, { 17, 29 } };
+        for ( int order = 0; order < 6; ++order )
+        {
+            const int a = order / 2, b = ( a + 1 + order % 2 ) % 3, c = 3 - a - b;
+            const int dx = ( order % 2 ) * 48, dy = ( order / 2 ) * 20;
+            gfx.DrawTriangle(
+                { corners[a].x + dx, corners[a].y + dy },
+                { corners[b].x + dx, corners[b].y + dy },
+                { corners[c].x + dx, corners[c].y + dy },
+                Color( 0x3060C0u + order * 0x201000u ) );
+        }
+    } );
+
+    // Translucent fans and split quads show any pixel filled twice or missed along a shared edge
+    AddTriangleScene( scenes, "triangle-shared-edges", []( Graphics& gfx )
+    {
+        const Vec2<int> center( 24, 32 );
+        for ( int i = 0; i < 16; ++i )
+        {
+            const double a0 = i * 3.14159265358979 / 8.0, a1 = ( i + 1 ) * 3.14159265358979 / 8.0;
+            const Vec2<int> p0( center.x + static_cast<int>( std::lround( 22.0 * std::cos( a0 ) ) ), center.y + static_cast<int>( std::lround( 22.0 * std::sin( a0 ) ) ) );
+            const Vec2<int> p1( center.x + static_cast<int>( std::lround( 22.0 * std::cos( a1 ) ) ), center.y + static_cast<int>( std::lround( 22.0 * std::sin( a1 ) ) ) );
+            gfx.DrawTriangle( center, p0, p1, Color( 0xFFA040, 128 ) );
+        }
+        for ( int y = 0; y < 4; ++y )
+        {
+            for ( int x = 0; x < 3; ++x )
+            {
+                const Vec2<int> a( 52 + x * 13, 4 + y * 14 ), b( a.x + 13, a.y ), c( a.x + 13, a.y + 14 ), d( a.x, a.y + 14 );
+                gfx.DrawTriangle( a, b, c, Color( 0x40FFA0, 128 ) );
+                gfx.DrawTriangle( a, c, d, Color( 0x40FFA0, 128 ) );
+            }
+        }
+    } );
+
+    // Long thin triangles step across many pixels per row or rows per pixel
+    AddTriangleScene( scenes, "triangle-slivers", []( Graphics& gfx )
+    {
+        gfx.DrawTriangle( { 2, 4 }, { 94, 8 }, { 2, 5 }, Color( 0xE04040 ) );
+        gfx.DrawTriangle( { 2, 12 }, { 94, 13 }, { 94, 14 }, Color( 0x40E040 ) );
+        gfx.DrawTriangle( { 10, 18 }, { 12, 62 }, { 11, 18 }, Color( 0x4040E0 ) );
+        gfx.DrawTriangle( { 20, 62 }, { 21, 18 }, { 24, 62 }, Color( 0xE0E040 ) );
+        gfx.DrawTriangle( { 30, 20 }, { 94, 60 }, { 31, 21 }, Color( 0xE040E0 ) );
+        gfx.DrawTriangle( { 94, 20 }, { 34, 60 }, { 36, 60 }, Color( 0x40E0E0 ) );
+    } );
+
+    // Triangles reaching far outside the surface are clipped without wrapping around
+    AddTriangleScene( scenes, "triangle-clipped", []( Graphics& gfx )
+    {
+        gfx.DrawTriangle( { -5000, -20 }, { 60, 30 }, { -200, 4000 }, Color( 0xE04040 ) );
+        gfx.DrawTriangle( { 90, -3000 }, { 5000, 60 }, { 70, 40 }, Color( 0x40E040 ) );
+        gfx.DrawTriangle( { 40, 70 }, { 60, 100 }, { 20, 100 }, Color( 0xFFFFFF ) );
+        gfx.DrawTriangle( { -10, -10 }, { 20, -10 }, { 5, 8 }, Color( 0x4040E0 ) );
+        gfx.DrawTriangle( { 0, 44 }, { INT_MAX, 44 }, { 0, 54 }, Color( 0xE0E040 ) );
+    } );
+
+    // Vertices between pixel centers in 28.4 fixed point, a fan turned a little more each step
+    scenes.push_back( { "triangle-subpixel", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        const int scale = 16;
+        for ( int i = 0; i < 12; ++i )
+        {
+            const double angle = i * 0.5236 + 0.1;
+            const Vec2<int> center( 48 * scale + 7, 32 * scale + 3 );
+            const Vec2<int> p0( center.x + static_cast<int>( std::lround( 28.0 * scale * std::cos( angle ) ) ), center.y + static_cast<int>( std::lround( 28.0 * scale * std::sin( angle ) ) ) );
+            const Vec2<int> p1( center.x + static_cast<int>( std::lround( 28.0 * scale * std::cos( angle + 0.5236 ) ) ), center.y + static_cast<int>( std::lround( 28.0 * scale * std::sin( angle + 0.5236 ) ) ) );
+            gfx.DrawTriangleSubpixel( center, p0, p1, Color( 0x2080FFu + i * 0x101000u, 160 ) );
+        }
+
+        // Whole pixels, then triangles smaller than a pixel either side of its center
+        gfx.DrawTriangleSubpixel( { 2 * scale, 2 * scale }, { 12 * scale, 2 * scale }, { 2 * scale, 12 * scale }, Color( 0xFFFFFF ) );
+        gfx.DrawTriangleSubpixel( { 90 * scale + 4, 4 * scale + 4 }, { 90 * scale + 12, 4 * scale + 4 }, { 90 * scale + 4, 4 * scale + 12 }, Color( 0xFFFFFF ) );
+        gfx.DrawTriangleSubpixel( { 90 * scale + 2, 8 * scale + 2 }, { 90 * scale + 6, 8 * scale + 2 }, { 90 * scale + 2, 8 * scale + 6 }, Color( 0xFFFFFF ) );
+    } } );
+
+    // Indexed triangles sharing vertices, colored per triangle and blended so overlaps show
+    scenes.push_back( { "mesh-grid", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        std::vector<Vec2<int>> vertices;
+        for ( int y = 0; y < 5; ++y )
+            for ( int x = 0; x < 7; ++x )
+                vertices.emplace_back( 4 + x * 14 + ( y % 2 ) * 3, 3 + y * 14 - ( x % 2 ) * 2 );
+
+        std::vector<uint32_t> indices;
+        std::vector<Color> colors;
+        for ( uint32_t y = 0; y < 4u; ++y )
+        {
+            for ( uint32_t x = 0; x < 6u; ++x )
+            {
+                const uint32_t i = y * 7u + x;
+                indices.insert( indices.end(), { i, i + 1u, i + 8u, i, i + 8u, i + 7u } );
+                colors.emplace_back( 0x4080C0u + x * 0x200000u, 200 );
+                colors.emplace_back( 0xC08040u + y * 0x000020u, 200 );
+            }
+        }
+        gfx.DrawTriangles( vertices.data(), vertices.size(), indices.data(), indices.size(), colors.data(), Graphics::MeshColors::PER_TRIANGLE );
+    } } );
+
+    // A mesh in model space moved by a 3-4-5 rotation and a fractional offset, every SIMD level
+    //      must round the vertices to the same 28.4 positions
+    AddTriangleScene( scenes, "mesh-transformed", []( Graphics& gfx )
+    {
+        std::vector<Vec2<float>> points;
+        for ( int y = 0; y < 5; ++y )
+            for ( int x = 0; x < 9; ++x )
+                points.emplace_back( x * 7.25f - 29.0f, y * 9.5f - 19.0f + ( x % 2 ) * 1.75f );
+
+        std::vector<uint32_t> indices;
+        std::vector<Color> colors;
+        for ( uint32_t y = 0; y < 4u; ++y )
+        {
+            for ( uint32_t x = 0; x < 8u; ++x )
+            {
+                const uint32_t i = y * 9u + x;
+                indices.insert( indices.end(), { i, i + 1u, i + 10u, i, i + 10u, i + 9u } );
+                colors.emplace_back( 0x40A0C0u + x * 0x180000u, 220 );
+                colors.emplace_back( 0xC0A040u + y * 0x000030u, 220 );
+            }
+        }
+        const Affine2<float> transform( 0.8f, -0.6f, 0.6f, 0.8f, 48.3125f, 31.7f );
+        gfx.DrawTriangles( Vec2Batch( points.data(), points.size() ), transform, indices.data(), indices.size(), colors.data(), Graphics::MeshColors::PER_TRIANGLE );
+    } );
+
+    // A star of lines through every octant, steep and shallow, with the diagonals and axes
+    scenes.push_back( { "line-octants", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        const Vec2<int> center( 32, 32 );
+        const Vec2<int> ends[] = {
+            { 62, 32 }, { 62, 20 }, { 62, 2 }, { 50, 2 }, { 32, 2 }, { 20, 2 }, { 2, 2 }, { 2, 14 },
+            { 2, 32 }, { 2, 44 }, { 2, 62 }, { 14, 62 }, { 32, 62 }, { 44, 62 }, { 62, 62 }, { 62, 50 } };
+        for ( size_t i = 0; i < std::size( ends ); ++i )
+            gfx.DrawLine( center, ends[i], Color( 0x40A0FFu + static_cast<uint32_t>( i ) * 0x0C0000u ) );
+
+        // Each line drawn from both ends side by side, a line should not depend on its direction
+        for ( int i = 0; i < 6; ++i )
+        {
+            const Vec2<int> a( 66, 4 + i * 10 ), b( 78, 2 + i * 11 );
+            gfx.DrawLine( a, b, Color( 0xFFFFFF ) );
+            gfx.DrawLine( { b.x + 16, b.y }, { a.x + 16, a.y }, Color( 0xFFFFFF ) );
+        }
+    } } );
+
+    // Lines leaving the surface, lines entirely outside it and lines no longer than a point
+    scenes.push_back( { "line-clipped", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        gfx.DrawLine( { -40, -10 }, { 130, 70 }, Color( 0xE04040 ) );
+        gfx.DrawLine( { 48, -1000 }, { 52, 1000 }, Color( 0x40E040 ) );
+        gfx.DrawLine( { -1000, 20 }, { 1000, 24 }, Color( 0x4040E0 ) );
+        gfx.DrawLine( { 95, 63 }, { 200, 200 }, Color( 0xFFFFFF ) );
+        gfx.DrawLine( { -50, -50 }, { -10, -20 }, Color( 0xFFFFFF ) );
+        gfx.DrawLine( { 10, 50 }, { 10, 50 }, Color( 0xFFFF00 ) );
+        gfx.DrawLine( { 0, 63 }, { 95, 0 }, Color( 0xE040E0 ) );
+
+        // Runs of 2^32 pixels whose step products and span ends leave 64 bits and int
+        gfx.DrawLine( { INT_MIN, INT_MIN + 5 }, { INT_MAX, INT_MAX }, Color( 0x40E0E0 ) );
+        gfx.DrawLine( { 10, 10 }, { INT_MAX, 10 }, Color( 0xE0E040 ) );
+        gfx.DrawLine( { 80, INT_MIN }, { 80, INT_MAX }, Color( 0xE0A040 ) );
+    } } );
+
+    // Polylines share their joints so a translucent one darkens nowhere
+    scenes.push_back( { "line-polyline", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        const Vec2<int> points[] = { { 4, 60 }, { 20, 4 }, { 20, 4 }, { 36, 60 }, { 52, 30 }, { 92, 34 }, { 60, 58 }, { 60, 58 }, { 90, 6 } };
+        gfx.DrawPolyline( points, std::size( points ), Color( 0xFFFFFF, 128 ) );
+    } } );
+
+    // Each blend mode over a gradient, every SIMD level blends with its own kernels
+    scenes.push_back( { "blend-modes", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        for ( int x = 0; x < sceneWidth; x += 4 )
+            gfx.DrawRectangle( { x, 0 }, { x + 4, sceneHeight }, Color( static_cast<uint8_t>( x * 255 / sceneWidth ), 96, static_cast<uint8_t>( 255 - x * 255 / sceneWidth ) ) );
+
+        const BlendMode modes[] = { BlendMode::SRC_OVER, BlendMode::ADDITIVE, BlendMode::MULTIPLY };
+        for ( int m = 0; m < 3; ++m )
+        {
+            gfx.SetBlendMode( modes[m] );
+            for ( int a = 0; a < 4; ++a )
+            {
+                const uint8_t alpha = static_cast<uint8_t>( 64 + a * 63 );
+                gfx.DrawRectangle( { 3 + a * 23, 3 + m * 20 }, { 21 + a * 23, 19 + m * 20 }, Color( 0xF0C030, alpha ) );
+                gfx.DrawTriangle( { 5 + a * 23, 18 + m * 20 }, { 19 + a * 23, 18 + m * 20 }, { 12 + a * 23, 6 + m * 20 }, Color( 0x30C0F0, alpha ) );
+            }
+        }
+        gfx.SetBlendMode( BlendMode::SRC_OVER );
+    } } );
+
+    // Images and sprites hang down from their top left pixel, whole and clipped by each edge
+    scenes.push_back( { "image-orientation", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        static const Sprite sprite( ImageView( GetMarkedImage().data(), markedWidth, markedHeight, markedWidth ) );
+        const ImageView image( GetMarkedImage().data(), markedWidth, markedHeight, markedWidth );
+        gfx.DrawImage( image, { 4, 40 } );
+        gfx.DrawImage( image, { 30, 66 } );
+        gfx.DrawImage( image, { -5, 20 } );
+        gfx.DrawImage( image, { 50, 4 } );
+        gfx.DrawSprite( sprite, { 70, 40 } );
+        gfx.DrawSprite( sprite, { 90, 20 } );
+        gfx.DrawSprite( sprite, { 70, 5 } );
+    } } );
+
+    // Text hangs down from its top left pixel with new lines below, inside the box MeasureString gives
+    scenes.push_back( { "text-orientation", sceneWidth, sceneHeight, []( Graphics& gfx )
+    {
+        const std::pair<const char*, Vec2<int>> strings[] = { { "Ag\nyp", { 4, 58 } }, { "Top\nEdge", { 50, 66 } }, { "low", { 50, 4 } } };
+        for ( const auto& [text, position] : strings )
+        {
+            gfx.SetTextScale( text[0] == 'A' ? 2 : 1 );
+            const Vec2<int> size = gfx.MeasureString( text );
+            gfx.DrawRectangle( { position.x, position.y + 1 - size.y }, { position.x + size.x, position.y + 1 }, Color( 0x304060 ) );
+            gfx.DrawString( text, position, Color( 0xFFFFFF ) );
+        }
+        gfx.SetTextScale( 1 );
+    } } );
+
+    return scenes;
+}